@@ -0,0 +1,117 @@
+#include <fiddle/interaction/cell_rhs_kernels.h>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// Microbenchmark for the cell right-hand side kernels used by
+// compute_projection_rhs(): prints the number of cells per second processed
+// by the compiled and generic kernels for the element types most commonly
+// used with fiddle.
+//
+// Run the Release build of this program - timings from Debug builds are not
+// meaningful.
+
+struct Case
+{
+  std::string  name;
+  unsigned int n_base_dofs;
+  unsigned int n_components;
+  unsigned int n_q_points;
+};
+
+// Return the number of cells per second.
+double
+time_kernel(const fdl::CellRHSKernel      kernel,
+            const Case                   &c,
+            const unsigned int            n_cells,
+            const std::vector<double>    &shape_values,
+            const std::vector<double>    &values,
+            const std::vector<double>    &JxW_values,
+            std::vector<double>          &rhs)
+{
+  using clock = std::chrono::steady_clock;
+
+  const double min_time = 0.5;
+  std::size_t  n_calls  = 0;
+  const auto   start    = clock::now();
+  double       elapsed  = 0.0;
+  do
+    {
+      for (unsigned int cell_n = 0; cell_n < n_cells; ++cell_n)
+        kernel(c.n_base_dofs,
+               c.n_components,
+               c.n_q_points,
+               shape_values.data(),
+               values.data() + cell_n * c.n_q_points * c.n_components,
+               JxW_values.data() + cell_n * c.n_q_points,
+               rhs.data() + cell_n * c.n_base_dofs * c.n_components);
+      n_calls += n_cells;
+      elapsed = std::chrono::duration<double>(clock::now() - start).count();
+    }
+  while (elapsed < min_time);
+
+  return n_calls / elapsed;
+}
+
+int
+main()
+{
+  // Use a typical number of quadrature points for each element (i.e., QGauss
+  // with degree + 2 points in each direction):
+  const std::vector<Case> cases = {{"Q1 2D scalar", 4, 1, 9},
+                                   {"Q1 2D vector", 4, 2, 9},
+                                   {"Q2 2D vector", 9, 2, 16},
+                                   {"Q3 2D vector", 16, 2, 25},
+                                   {"P1 2D vector", 3, 2, 6},
+                                   {"P2 2D vector", 6, 2, 12},
+                                   {"Q1 3D vector", 8, 3, 27},
+                                   {"Q2 3D scalar", 27, 1, 64},
+                                   {"Q2 3D vector", 27, 3, 64},
+                                   {"Q3 3D vector", 64, 3, 125},
+                                   {"P1 3D vector", 4, 3, 14},
+                                   {"P2 3D vector", 10, 3, 24}};
+
+  const unsigned int                     n_cells = 1024;
+  std::mt19937                           generator(42);
+  std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+  const auto random = [&]() { return distribution(generator); };
+
+  std::cout << std::left << std::setw(16) << "element" << std::right
+            << std::setw(16) << "compiled" << std::setw(16) << "generic"
+            << std::setw(10) << "speedup" << '\n';
+  for (const Case &c : cases)
+    {
+      std::vector<double> shape_values(c.n_q_points * c.n_base_dofs);
+      std::vector<double> values(n_cells * c.n_q_points * c.n_components);
+      std::vector<double> JxW_values(n_cells * c.n_q_points);
+      std::vector<double> rhs(n_cells * c.n_base_dofs * c.n_components);
+      for (double &v : shape_values)
+        v = random();
+      for (double &v : values)
+        v = random();
+      for (double &v : JxW_values)
+        v = random();
+
+      const fdl::CellRHSKernel kernel =
+        fdl::get_cell_rhs_kernel(c.n_base_dofs, c.n_components);
+      const double compiled = time_kernel(
+        kernel, c, n_cells, shape_values, values, JxW_values, rhs);
+      const double generic = time_kernel(&fdl::compute_cell_rhs_generic,
+                                         c,
+                                         n_cells,
+                                         shape_values,
+                                         values,
+                                         JxW_values,
+                                         rhs);
+
+      std::cout << std::left << std::setw(16) << c.name << std::right
+                << std::scientific << std::setprecision(3) << std::setw(16)
+                << compiled << std::setw(16) << generic << std::fixed
+                << std::setprecision(2) << std::setw(10) << compiled / generic
+                << '\n';
+    }
+}
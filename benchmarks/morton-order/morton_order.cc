@@ -0,0 +1,259 @@
+#include <fiddle/interaction/ib_kernels.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+// Microbenchmark for morton_order_interaction_plan(): prints the time needed
+// to spread and interpolate three components with IB_4 on one 3D patch for a
+// spherical shell of hexahedra, each with 3^3 quadrature points, when the
+// cells are visited
+//
+// 1. in mesh (i.e., lexicographic) order,
+// 2. in a random order (e.g., a mesh read from a file), and
+// 3. in the Morton order computed by morton_order_interaction_plan() from
+//    either of the previous two orders.
+//
+// The stencil loops are the same as the ones used with native kernels by
+// interpolate_from_patch() and spread_to_patch() but operate on plain arrays
+// so that no patch hierarchy is needed. The optional argument is the number of
+// Eulerian cells in each direction (defaults to 128).
+//
+// Run the Release build of this program - timings from Debug builds are not
+// meaningful.
+
+using Kernel                  = fdl::IB4Kernel;
+constexpr int    width        = Kernel::width;
+constexpr int    n_components = 3;
+constexpr int    n_ghosts     = 4;
+constexpr double shell_radius = 0.3;
+
+// Same as the key used by morton_order_interaction_plan().
+std::uint64_t
+morton_key(const std::array<std::uint64_t, 3> &indices)
+{
+  constexpr unsigned int n_bits = 64 / 3;
+  std::uint64_t          key    = 0;
+  for (unsigned int b = 0; b < n_bits; ++b)
+    for (unsigned int d = 0; d < 3; ++d)
+      key |= ((indices[d] >> b) & std::uint64_t(1)) << (b * 3 + d);
+  return key;
+}
+
+struct Grid
+{
+  Grid(const int n)
+    : n(n)
+    , dx(1.0 / n)
+    , stride_1(n + 2 * n_ghosts)
+    , stride_2(stride_1 * stride_1)
+  {
+    for (std::vector<double> &component : data)
+      component.resize(stride_2 * stride_1);
+  }
+
+  // Compute the first index and the weights of the stencil of @p point.
+  void
+  compute_stencil(const double                             *point,
+                  std::ptrdiff_t                           &offset,
+                  std::array<std::array<double, width>, 3> &weights) const
+  {
+    offset = 0;
+    for (unsigned int d = 0; d < 3; ++d)
+      {
+        const double s     = point[d] / dx - 0.5;
+        const int    lower = int(std::floor(s + 1.0 - 0.5 * width));
+        for (int j = 0; j < width; ++j)
+          weights[d][j] = Kernel::value(s - double(lower + j));
+        offset += (lower + n_ghosts) *
+                  (d == 0 ? 1 : (d == 1 ? stride_1 : stride_2));
+      }
+  }
+
+  int                                           n;
+  double                                        dx;
+  std::ptrdiff_t                                stride_1;
+  std::ptrdiff_t                                stride_2;
+  std::array<std::vector<double>, n_components> data;
+};
+
+double
+spread(Grid                      &grid,
+       const std::vector<double> &points,
+       const std::vector<double> &F)
+{
+  const auto start = std::chrono::steady_clock::now();
+
+  std::ptrdiff_t                           offset;
+  std::array<std::array<double, width>, 3> weights;
+  for (std::size_t point_n = 0; point_n < points.size() / 3; ++point_n)
+    {
+      grid.compute_stencil(&points[3 * point_n], offset, weights);
+      for (unsigned int c = 0; c < n_components; ++c)
+        {
+          double *const corner = grid.data[c].data() + offset;
+          const double  value  = F[n_components * point_n + c];
+          for (int k = 0; k < width; ++k)
+            for (int j = 0; j < width; ++j)
+              {
+                double *const row = corner + k * grid.stride_2 +
+                                    j * grid.stride_1;
+                const double row_value = weights[2][k] * weights[1][j] * value;
+                for (int i = 0; i < width; ++i)
+                  row[i] += weights[0][i] * row_value;
+              }
+        }
+    }
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                       start)
+    .count();
+}
+
+double
+interpolate(const Grid                &grid,
+            const std::vector<double> &points,
+            std::vector<double>       &U)
+{
+  const auto start = std::chrono::steady_clock::now();
+
+  std::ptrdiff_t                           offset;
+  std::array<std::array<double, width>, 3> weights;
+  for (std::size_t point_n = 0; point_n < points.size() / 3; ++point_n)
+    {
+      grid.compute_stencil(&points[3 * point_n], offset, weights);
+      for (unsigned int c = 0; c < n_components; ++c)
+        {
+          const double *const corner = grid.data[c].data() + offset;
+          double              value  = 0.0;
+          for (int k = 0; k < width; ++k)
+            {
+              double plane_value = 0.0;
+              for (int j = 0; j < width; ++j)
+                {
+                  const double *const row = corner + k * grid.stride_2 +
+                                            j * grid.stride_1;
+                  double row_value = 0.0;
+                  for (int i = 0; i < width; ++i)
+                    row_value += weights[0][i] * row[i];
+                  plane_value += weights[1][j] * row_value;
+                }
+              value += weights[2][k] * plane_value;
+            }
+          U[n_components * point_n + c] = value;
+        }
+    }
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                       start)
+    .count();
+}
+
+int
+main(int argc, char **argv)
+{
+  const double pi = std::acos(-1.0);
+  Grid         grid(argc > 1 ? std::atoi(argv[1]) : 128);
+
+  // Set up the cell centers of a shell with two layers of cells whose width
+  // is about two Eulerian cells, numbered lexicographically in (r, theta, phi)
+  // like a structured mesh:
+  const double                       h       = 2.0 * grid.dx;
+  const int                          n_theta = int(pi * shell_radius / h);
+  const int                          n_phi = int(2.0 * pi * shell_radius / h);
+  std::vector<std::array<double, 3>> centers;
+  for (int k = 0; k < 2; ++k)
+    for (int i = 0; i < n_theta; ++i)
+      for (int j = 0; j < n_phi; ++j)
+        {
+          const double r     = shell_radius + (k + 0.5) * 0.02;
+          const double theta = (i + 0.5) * pi / n_theta;
+          const double phi   = (j + 0.5) * 2.0 * pi / n_phi;
+          centers.push_back({{0.5 + r * std::sin(theta) * std::cos(phi),
+                              0.5 + r * std::sin(theta) * std::sin(phi),
+                              0.5 + r * std::cos(theta)}});
+        }
+  const std::size_t n_cells = centers.size();
+
+  auto get_points = [&](const std::vector<std::size_t> &order) {
+    std::vector<double> points;
+    for (const std::size_t cell_n : order)
+      for (int a = -1; a <= 1; ++a)
+        for (int b = -1; b <= 1; ++b)
+          for (int c = -1; c <= 1; ++c)
+            {
+              points.push_back(centers[cell_n][0] + a * 0.3 * h);
+              points.push_back(centers[cell_n][1] + b * 0.3 * h);
+              points.push_back(centers[cell_n][2] + c * 0.3 * h);
+            }
+    return points;
+  };
+  auto get_morton_order = [&](const std::vector<std::size_t> &order) {
+    std::vector<std::pair<std::uint64_t, std::size_t>> keys;
+    for (const std::size_t cell_n : order)
+      {
+        std::array<std::uint64_t, 3> indices;
+        for (unsigned int d = 0; d < 3; ++d)
+          indices[d] = std::uint64_t(std::floor(centers[cell_n][d] / grid.dx));
+        keys.emplace_back(morton_key(indices), cell_n);
+      }
+    std::stable_sort(keys.begin(),
+                     keys.end(),
+                     [](const auto &a, const auto &b) {
+                       return a.first < b.first;
+                     });
+    std::vector<std::size_t> morton_order;
+    for (const auto &key : keys)
+      morton_order.push_back(key.second);
+    return morton_order;
+  };
+
+  std::vector<std::size_t> mesh_order(n_cells);
+  std::iota(mesh_order.begin(), mesh_order.end(), std::size_t(0));
+  std::vector<std::size_t> random_order = mesh_order;
+  std::mt19937             generator(42);
+  std::shuffle(random_order.begin(), random_order.end(), generator);
+
+  const std::vector<std::pair<std::string, std::vector<std::size_t>>> cases =
+    {{"mesh order", mesh_order},
+     {"random order", random_order},
+     {"Morton order (from mesh)", get_morton_order(mesh_order)},
+     {"Morton order (from random)", get_morton_order(random_order)}};
+
+  std::cout << "Eulerian cells: " << grid.n << "^3, Lagrangian cells: "
+            << n_cells << ", points: " << 27 * n_cells << '\n'
+            << "best of 7 runs, in seconds\n"
+            << std::setw(28) << std::left << "order" << std::setw(12)
+            << "spread"
+            << "interpolate\n";
+  for (const auto &c : cases)
+    {
+      const std::vector<double> points = get_points(c.second);
+      std::vector<double>       F(points.size());
+      std::vector<double>       U(points.size());
+      for (std::size_t i = 0; i < F.size(); ++i)
+        F[i] = std::sin(0.001 * i);
+
+      double spread_time      = std::numeric_limits<double>::max();
+      double interpolate_time = std::numeric_limits<double>::max();
+      for (unsigned int run_n = 0; run_n < 7; ++run_n)
+        {
+          for (std::vector<double> &component : grid.data)
+            std::fill(component.begin(), component.end(), 0.0);
+          spread_time = std::min(spread_time, spread(grid, points, F));
+          interpolate_time =
+            std::min(interpolate_time, interpolate(grid, points, U));
+        }
+      std::cout << std::setw(28) << std::left << c.first << std::setw(12)
+                << std::setprecision(4) << std::fixed << spread_time
+                << interpolate_time << '\n';
+    }
+}
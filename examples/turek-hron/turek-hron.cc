@@ -4,6 +4,7 @@
 
 #include <fiddle/mechanics/force_contribution.h>
 #include <fiddle/mechanics/force_contribution_lib.h>
+#include <fiddle/mechanics/stress_lib.h>
 
 #include <deal.II/distributed/shared_tria.h>
 
@@ -101,121 +102,6 @@ namespace ModelData
     GridTools::shift(cylinder_center, tria);
     tria.set_manifold(0, PolarManifold<2>(cylinder_center));
   }
-
-  class BeamNeoHookeanStress : public fdl::ForceContribution<2>
-  {
-  public:
-    // todo more parameters
-    BeamNeoHookeanStress(const Quadrature<2>     &quad,
-                         const types::material_id beam_id,
-                         const double             mu_s)
-      : ForceContribution<2>(quad)
-      , beam_id(beam_id)
-      , mu_s(mu_s)
-    {}
-
-    virtual bool
-    is_stress() const override
-    {
-      return true;
-    }
-
-    virtual fdl::MechanicsUpdateFlags
-    get_mechanics_update_flags() const override
-    {
-      return fdl::update_n23_det_FF | fdl::update_FF | fdl::update_FF_inv_T |
-             fdl::update_first_invariant;
-    }
-
-    virtual UpdateFlags
-    get_update_flags() const override
-    {
-      return UpdateFlags::update_default;
-    }
-
-    virtual void
-    compute_stress(const double                   time,
-                   const fdl::MechanicsValues<2> &me_values,
-                   const typename Triangulation<2>::active_cell_iterator &cell,
-                   ArrayView<Tensor<2, 2>> &stresses) const override
-    {
-      if (cell->material_id() == beam_id)
-        {
-          for (unsigned int qp_n = 0; qp_n < stresses.size(); ++qp_n)
-            {
-              const auto &n23_J    = me_values.get_n23_det_FF()[qp_n];
-              const auto &FF       = me_values.get_FF()[qp_n];
-              const auto &I1       = me_values.get_first_invariant()[qp_n];
-              const auto &FF_inv_T = me_values.get_FF_inv_T()[qp_n];
-              stresses[qp_n] = mu_s * n23_J * (FF - (I1 / 3.0) * FF_inv_T);
-            }
-        }
-      else
-        {
-          std::fill(stresses.begin(), stresses.end(), Tensor<2, 2>());
-        }
-    }
-
-  private:
-    types::material_id beam_id;
-    double             mu_s;
-  };
-
-  class BeamDilatationalStress : public fdl::ForceContribution<2>
-  {
-  public:
-    BeamDilatationalStress(const Quadrature<2>     &quad,
-                           const types::material_id beam_id,
-                           const double             beta_s)
-      : ForceContribution<2>(quad)
-      , beam_id(beam_id)
-      , beta_s(beta_s)
-    {}
-
-    virtual bool
-    is_stress() const override
-    {
-      return true;
-    }
-
-    virtual fdl::MechanicsUpdateFlags
-    get_mechanics_update_flags() const override
-    {
-      return fdl::update_det_FF | fdl::update_FF_inv_T;
-    }
-
-    virtual UpdateFlags
-    get_update_flags() const override
-    {
-      return UpdateFlags::update_default;
-    }
-
-    virtual void
-    compute_stress(const double                   time,
-                   const fdl::MechanicsValues<2> &me_values,
-                   const typename Triangulation<2>::active_cell_iterator &cell,
-                   ArrayView<Tensor<2, 2>> &stresses) const override
-    {
-      // if (cell->material_id() == beam_id)
-      if (true)
-        {
-          for (unsigned int qp_n = 0; qp_n < stresses.size(); ++qp_n)
-            {
-              const auto &J        = me_values.get_det_FF()[qp_n];
-              const auto &FF_inv_T = me_values.get_FF_inv_T()[qp_n];
-              stresses[qp_n]       = beta_s * J * std::log(J) * FF_inv_T;
-            }
-        }
-      else
-        {
-          std::fill(stresses.begin(), stresses.end(), Tensor<2, 2>());
-        }
-    }
-
-  private:
-    types::material_id beam_id;
-    double             beta_s;
-  };
 } // namespace ModelData
 
 // Function prototypes
@@ -323,12 +209,11 @@ main(int argc, char *argv[])
 
     std::vector<std::unique_ptr<fdl::ForceContribution<2>>> force_contributions;
     force_contributions.emplace_back(std::move(spring_force));
-    force_contributions.emplace_back(
-      std::make_unique<ModelData::BeamNeoHookeanStress>(quadrature2, 1, mu_s));
-    force_contributions.emplace_back(
-      std::make_unique<ModelData::BeamDilatationalStress>(quadrature2,
-                                                          1,
-                                                          beta_s));
+    // Neo-Hookean stress on the beam and dilatational stress everywhere
+    force_contributions.emplace_back(fdl::make_hyperelastic_stress<2>(
+      quadrature2, {1}, fdl::StressLaws::NeoHookean<2>(mu_s)));
+    force_contributions.emplace_back(fdl::make_hyperelastic_stress<2>(
+      quadrature2, {}, fdl::StressLaws::JLogJVolumetricPenalty<2>(beta_s)));
 
     std::vector<fdl::Part<2>> parts;
     parts.emplace_back(tria, fe, std::move(force_contributions));
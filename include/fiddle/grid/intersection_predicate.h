@@ -75,19 +75,21 @@ namespace fdl
    * present on all processors. This is useful for creating an
    * OverlapTriangulation on each processor with bounding boxes intersecting an
    * arbitrary part of the Triangulation.
+   *
+   * The constructor determines, in a single pass over the Triangulation,
+   * whether or not each cell intersects a patch: active cells are checked with
+   * an rtree of patch bounding boxes and a parent cell intersects if any of
+   * its children do. Hence the Triangulation should not be modified while
+   * this object is in use.
    */
   template <int dim, int spacedim = dim>
   class BoxIntersectionPredicate : public IntersectionPredicate<dim, spacedim>
   {
   public:
     BoxIntersectionPredicate(
-      const std::vector<BoundingBox<spacedim, float>> &     a_cell_bboxes,
-      const std::vector<BoundingBox<spacedim>> &            p_bboxes,
-      const parallel::shared::Triangulation<dim, spacedim> &tria)
-      : tria(&tria)
-      , active_cell_bboxes(a_cell_bboxes)
-      , patch_bboxes(p_bboxes)
-    {}
+      const std::vector<BoundingBox<spacedim, float>>      &a_cell_bboxes,
+      const std::vector<BoundingBox<spacedim>>             &p_bboxes,
+      const parallel::shared::Triangulation<dim, spacedim> &tria);
 
     virtual bool
     operator()(const typename Triangulation<dim, spacedim>::cell_iterator &cell)
@@ -96,43 +98,21 @@ namespace fdl
       Assert(&cell->get_triangulation() == tria,
              ExcMessage("only valid for inputs constructed from the originally "
                         "provided Triangulation"));
-      // If the cell is active check its bbox:
-      if (cell->is_active())
-        {
-          const auto &cell_bbox = active_cell_bboxes[cell->active_cell_index()];
-          for (const auto &bbox : patch_bboxes)
-            if (intersects(cell_bbox, bbox))
-              return true;
-          return false;
-        }
-      // Otherwise see if it has a descendant that intersects:
-      else if (cell->has_children())
-        {
-          const auto n_children             = cell->n_children();
-          bool       has_intersecting_child = false;
-          for (unsigned int child_n = 0; child_n < n_children; ++child_n)
-            {
-              const bool child_intersects = (*this)(cell->child(child_n));
-              if (child_intersects)
-                {
-                  has_intersecting_child = true;
-                  break;
-                }
-            }
-          return has_intersecting_child;
-        }
-      else
-        {
-          Assert(false, ExcNotImplemented());
-        }
-
-      Assert(false, ExcFDLInternalError());
-      return false;
+      AssertIndexRange(cell->level(), cell_intersects.size());
+      AssertIndexRange(cell->index(), cell_intersects[cell->level()].size());
+      return cell_intersects[cell->level()][cell->index()];
     }
 
     const SmartPointer<const Triangulation<dim, spacedim>> tria;
     const std::vector<BoundingBox<spacedim, float>>        active_cell_bboxes;
     const std::vector<BoundingBox<spacedim>>               patch_bboxes;
+
+  protected:
+    /**
+     * Whether or not each cell intersects a patch, indexed by level and then
+     * by cell index.
+     */
+    std::vector<std::vector<bool>> cell_intersects;
   };
 } // namespace fdl
 
@@ -56,6 +56,14 @@ namespace fdl
            const double          extra_ghost_cell_fraction,
            const Vector<double> &nodal_coordinates);
 
+    /**
+     * Replace the stored patches with @p new_patches without recomputing which
+     * DoFs intersect them. This is only valid if each new patch has the same
+     * box as the old patch with the same index.
+     */
+    void
+    reinit_patches(
+      const std::vector<tbox::Pointer<hier::Patch<spacedim>>> &new_patches);
     /**
      * Return the number of patches.
      */
@@ -13,6 +13,8 @@
 
 #include <deal.II/grid/tria.h>
 
+#include <boost/signals2/connection.hpp>
+
 #include <vector>
 
 namespace fdl
@@ -30,6 +32,9 @@ namespace fdl
    * it stores have no notion of ghost cells of cells belonging to off-processor
    * overlap triangulations. Hence the communicator it stores is still
    * <code>MPI_COMM_SELF</code>.
+   *
+   * Only the vertices of the overlapping cells are stored, so vertex indices
+   * on this triangulation do not match those on the native triangulation.
    */
   template <int dim, int spacedim = dim>
   class OverlapTriangulation : public dealii::Triangulation<dim, spacedim>
@@ -46,10 +51,22 @@ namespace fdl
       const parallel::shared::Triangulation<dim, spacedim> &shared_tria,
       const IntersectionPredicate<dim, spacedim> &          predicate);
 
+    virtual ~OverlapTriangulation();
+
     virtual types::subdomain_id
     locally_owned_subdomain() const;
 
-    void
+    /**
+     * Reinitialize the object. If @p shared_tria is the same Triangulation as
+     * before, has not been changed since the last call, and @p predicate
+     * selects exactly the same cells as before, then the current
+     * triangulation is kept (so DoFHandlers and other objects built on it
+     * remain valid).
+     *
+     * @return <code>true</code> if the triangulation was rebuilt and
+     * <code>false</code> otherwise.
+     */
+    bool
     reinit(const parallel::shared::Triangulation<dim, spacedim> &shared_tria,
            const IntersectionPredicate<dim, spacedim> &          predicate);
 
@@ -115,6 +132,24 @@ namespace fdl
      * corresponding native cell. Useful for doing data transfer.
      */
     std::vector<active_cell_iterator> cell_iterators_in_active_native_order;
+
+    /**
+     * Value of the predicate on every native cell (in the order given by
+     * Triangulation::cell_iterators()) at the time the triangulation was last
+     * built.
+     */
+    std::vector<bool> native_cell_predicate_values;
+
+    /**
+     * Whether or not the native triangulation has been modified since the
+     * triangulation was last built.
+     */
+    bool native_tria_changed = true;
+
+    /**
+     * Connections to the signals of the native triangulation.
+     */
+    std::vector<boost::signals2::connection> native_tria_listeners;
   };
 
 
@@ -39,6 +39,15 @@ namespace fdl
              const Triangulation<dim, spacedim> &tria,
              const std::vector<BoundingBox<spacedim, Number>> &cell_bboxes);
 
+    /**
+     * Replace the stored patches with @p new_patches without recomputing which
+     * cells intersect them. This is only valid if each new patch has the same
+     * box as the old patch with the same index, e.g., after a regrid which
+     * did not change the patch layout.
+     */
+    void
+    reinit_patches(
+      const std::vector<tbox::Pointer<hier::Patch<spacedim>>> &new_patches);
     /**
      * Same as the constructor.
      */
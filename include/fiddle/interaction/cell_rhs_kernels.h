@@ -0,0 +1,127 @@
+#ifndef included_fiddle_interaction_cell_rhs_kernels_h
+#define included_fiddle_interaction_cell_rhs_kernels_h
+
+#include <fiddle/base/config.h>
+
+#include <fiddle/base/exceptions.h>
+
+#include <array>
+
+// Kernels for computing cell right-hand side vectors (i.e., integrals of
+// shape functions against interpolated Eulerian values) in
+// compute_projection_rhs().
+//
+// All kernels assume that every vector component of the finite element uses
+// the same scalar base element (e.g., FESystem(FE_Q(p), spacedim)). In that
+// case the cell right-hand side is a small matrix product
+//
+//     R(k, c) = sum_q S(q, k) * V(q, c) * JxW(q)
+//
+// where S contains the values of the n_base_dofs shape functions of the base
+// element, V contains the interpolated values (with n_components components),
+// and R is stored with the component index varying fastest. The caller is
+// responsible for mapping entries of R back to the element's DoF ordering.
+
+namespace fdl
+{
+  /**
+   * Type of a function computing a cell right-hand side: the arguments are
+   * the number of base element DoFs, the number of components, the number of
+   * quadrature points, S (in quadrature point-first ordering), V (in
+   * quadrature point-first ordering), the JxW values, and R (which is
+   * overwritten).
+   */
+  using CellRHSKernel = void (*)(const unsigned int n_base_dofs,
+                                 const unsigned int n_components,
+                                 const unsigned int n_q_points,
+                                 const double      *base_shape_values,
+                                 const double      *values,
+                                 const double      *JxW_values,
+                                 double            *base_rhs);
+
+  /**
+   * Kernel with runtime sizes - works with any element.
+   */
+  void
+  compute_cell_rhs_generic(const unsigned int n_base_dofs,
+                           const unsigned int n_components,
+                           const unsigned int n_q_points,
+                           const double      *base_shape_values,
+                           const double      *values,
+                           const double      *JxW_values,
+                           double            *base_rhs);
+
+  /**
+   * Kernel with sizes known at compile time, which lets the compiler unroll
+   * and vectorize the loops over base DoFs and components. The size arguments
+   * are present so that the signature matches CellRHSKernel.
+   */
+  template <int n_base_dofs, int n_components>
+  void
+  compute_cell_rhs(const unsigned int n_base_dofs_,
+                   const unsigned int n_components_,
+                   const unsigned int n_q_points,
+                   const double      *base_shape_values,
+                   const double      *values,
+                   const double      *JxW_values,
+                   double            *base_rhs);
+
+  /**
+   * Return the compiled kernel for the given sizes if there is one and
+   * compute_cell_rhs_generic() otherwise.
+   *
+   * Compiled kernels exist for one, two, and three components and base
+   * elements with 3, 4, 6, 8, 9, 10, 16, 27, or 64 DoFs, i.e., FE_Q of
+   * degrees one through three in 2D and 3D and FE_SimplexP of degrees one and
+   * two in 2D and 3D.
+   */
+  CellRHSKernel
+  get_cell_rhs_kernel(const unsigned int n_base_dofs,
+                      const unsigned int n_components);
+
+  /**
+   * Return <code>true</code> if get_cell_rhs_kernel() returns a compiled
+   * kernel for the given sizes.
+   */
+  bool
+  has_compiled_cell_rhs_kernel(const unsigned int n_base_dofs,
+                               const unsigned int n_components);
+
+  // --------------------------- inline functions --------------------------- //
+
+  template <int n_base_dofs, int n_components>
+  inline void
+  compute_cell_rhs(const unsigned int n_base_dofs_,
+                   const unsigned int n_components_,
+                   const unsigned int n_q_points,
+                   const double      *base_shape_values,
+                   const double      *values,
+                   const double      *JxW_values,
+                   double            *base_rhs)
+  {
+    (void)n_base_dofs_;
+    (void)n_components_;
+    Assert(n_base_dofs_ == n_base_dofs, ExcFDLInternalError());
+    Assert(n_components_ == n_components, ExcFDLInternalError());
+
+    std::array<double, n_base_dofs * n_components> result{};
+    for (unsigned int q = 0; q < n_q_points; ++q)
+      {
+        std::array<double, n_components> weighted_values;
+        for (int c = 0; c < n_components; ++c)
+          weighted_values[c] = values[q * n_components + c] * JxW_values[q];
+
+        const double *const q_shape_values =
+          base_shape_values + q * n_base_dofs;
+        for (int k = 0; k < n_base_dofs; ++k)
+          for (int c = 0; c < n_components; ++c)
+            result[k * n_components + c] +=
+              q_shape_values[k] * weighted_values[c];
+      }
+
+    for (int i = 0; i < n_base_dofs * n_components; ++i)
+      base_rhs[i] = result[i];
+  }
+} // namespace fdl
+
+#endif
@@ -6,6 +6,7 @@
 #include <fiddle/base/quadrature_family.h>
 
 #include <fiddle/interaction/interaction_base.h>
+#include <fiddle/interaction/interaction_utilities.h>
 
 #include <fiddle/transfer/scatter.h>
 
@@ -18,11 +19,15 @@
 
 #include <deal.II/fe/mapping.h>
 
+#include <deal.II/lac/la_parallel_vector.h>
 #include <deal.II/lac/vector.h>
 
 #include <BasePatchHierarchy.h>
 
+#include <list>
+#include <map>
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace fdl
@@ -30,16 +35,49 @@ namespace fdl
   using namespace dealii;
   using namespace SAMRAI;
 
+  /**
+   * Interaction based on integrating over the elements of the Lagrangian mesh
+   * with quadrature rules chosen based on the relative sizes of the Eulerian
+   * and Lagrangian cells.
+   *
+   * Shape function values and JxW values are computed once per reinit() for
+   * each combination of DoFHandler and mapping used in interaction (see
+   * ShapeValueCache). Hence the mappings given to this class (i.e., the
+   * mapping describing the reference configuration of a Part) must not
+   * change between calls to reinit().
+   */
   template <int dim, int spacedim = dim>
   class ElementalInteraction : public InteractionBase<dim, spacedim>
   {
   public:
     /**
      * Constructor. Sets up an empty object.
+     *
+     * If @p cache_interaction_plan is true then the positions of the
+     * quadrature points are stored and reused by subsequent operations with
+     * the same positions until either invalidate_interaction_plan() or
+     * reinit() is called. Plans are identified by the values of the position
+     * vector, and up to max_cached_interaction_plans of them (e.g., for the
+     * current, half-step, and new positions of a time step) are kept at once.
+     *
+     * Only positions are cached, not kernel stencils: the base index and the
+     * spacedim * width one-dimensional weights of each stencil depend on the
+     * kernel and on the centering of the Eulerian data (which differs between
+     * the components of side-centered data), both of which are set per
+     * operation rather than per position. Caching them would require one
+     * set per kernel and centering used with the position, e.g., 24 weights
+     * and 6 indices per point for IB_4 with side-centered data in 3D rather
+     * than the 3 coordinates stored now.
+     *
+     * If @p morton_order_cells is true then the cells on each patch are
+     * sorted by the Eulerian cell containing them (see
+     * morton_order_interaction_plan()) before interacting.
      */
     ElementalInteraction(const unsigned int min_n_points_1D,
                          const double       point_density,
-                         const DensityKind  density_kind);
+                         const DensityKind  density_kind,
+                         const bool         cache_interaction_plan = false,
+                         const bool         morton_order_cells     = false);
 
     /**
      * Constructor.
@@ -52,11 +90,14 @@ namespace fdl
       const int                                             level_number,
       const unsigned int                                    min_n_points_1D,
       const double                                          point_density,
-      const DensityKind                                     density_kind);
+      const DensityKind                                     density_kind,
+      const bool cache_interaction_plan = false,
+      const bool morton_order_cells     = false);
 
     /**
      * Reinitialize the object. Same as the constructor, except min_n_points_1D,
-     * point_density, and density_kind are unchanged.
+     * point_density, density_kind, cache_interaction_plan, and
+     * morton_order_cells are unchanged.
      */
     virtual void
     reinit(const parallel::shared::Triangulation<dim, spacedim> &native_tria,
@@ -65,6 +106,33 @@ namespace fdl
            tbox::Pointer<hier::BasePatchHierarchy<spacedim>> patch_hierarchy,
            const int level_number) override;
 
+    /**
+     * Same as the base class version, but also invalidates the cached
+     * interaction plan. The quadrature rule chosen for each cell by the last
+     * call to reinit() is kept.
+     */
+    virtual bool
+    reinit_patches(
+      tbox::Pointer<hier::BasePatchHierarchy<spacedim>> p_hierarchy,
+      const int                                         l_number,
+      const double max_displacement) override;
+
+    /**
+     * Discard the cached interaction plans, if there are any.
+     *
+     * Cached plans are identified by the values of the position vector (and
+     * its DoFHandler), so modifying a position vector does not require
+     * calling this function: it only releases memory.
+     */
+    void
+    invalidate_interaction_plan();
+
+    /**
+     * Maximum number of interaction plans which are cached at once. When a
+     * new plan is needed the least recently used one is discarded.
+     */
+    static constexpr unsigned int max_cached_interaction_plans = 4;
+
     /**
      * Projection really is projection for this method so this always returns
      * false.
@@ -88,6 +156,33 @@ namespace fdl
     compute_spread_intermediate(
       std::unique_ptr<TransactionBase> transaction) override;
 
+    /**
+     * Same as compute_projection_rhs_intermediate(), but for several
+     * ElementalInteraction objects (typically one per Part) at once: each
+     * patch is processed for every object before moving on to the next patch
+     * (see the multi-part version of fdl::compute_projection_rhs()).
+     *
+     * The objects must all be set up with the same patch hierarchy and level
+     * number, each object must appear at most once, and all transactions must
+     * interpolate the same data index. They may use different kernels and
+     * finite elements.
+     */
+    static std::vector<std::unique_ptr<TransactionBase>>
+    fused_compute_projection_rhs_intermediate(
+      const std::vector<const ElementalInteraction<dim, spacedim> *>
+                                                    &interactions,
+      std::vector<std::unique_ptr<TransactionBase>> transactions);
+
+    /**
+     * Same as compute_spread_intermediate(), but for several
+     * ElementalInteraction objects at once. The requirements are the same as
+     * those of fused_compute_projection_rhs_intermediate().
+     */
+    static std::vector<std::unique_ptr<TransactionBase>>
+    fused_compute_spread_intermediate(
+      const std::vector<ElementalInteraction<dim, spacedim> *> &interactions,
+      std::vector<std::unique_ptr<TransactionBase>>             transactions);
+
     /**
      * Middle part of communicating workload. Does not communicate.
      */
@@ -98,6 +193,25 @@ namespace fdl
     virtual VectorOperation::values
     get_rhs_scatter_type() const override;
 
+    /**
+     * Get the InteractionPlan corresponding to the given position. If plans
+     * are cached and a cached plan was computed with the same DoFHandler and
+     * the same overlap position values then that plan is returned without
+     * recomputing anything.
+     */
+    const InteractionPlan<dim, spacedim> &
+    get_interaction_plan(const DoFHandler<dim, spacedim> &position_dof_handler,
+                         const Vector<double> &overlap_position) const;
+
+    /**
+     * Get the ShapeValueCache corresponding to the given overlap DoFHandler
+     * and mapping, computing it if necessary. Returns <code>nullptr</code> if
+     * the finite element is not supported by ShapeValueCache.
+     */
+    const ShapeValueCache<dim, spacedim> *
+    get_shape_value_cache(const DoFHandler<dim, spacedim> &dof_handler,
+                          const Mapping<dim, spacedim>    &mapping) const;
+
     unsigned int min_n_points_1D;
 
     double point_density;
@@ -119,6 +233,52 @@ namespace fdl
      * Vector of quadratures we will actually use for interaction.
      */
     std::vector<Quadrature<dim>> quadratures;
+
+    /**
+     * Whether or not we should reuse interaction plans.
+     */
+    bool cache_interaction_plan;
+
+    /**
+     * Whether or not we should sort the cells of each interaction plan.
+     */
+    bool morton_order_cells;
+
+    /**
+     * The most recently computed interaction plan, if plans are not cached.
+     */
+    mutable InteractionPlan<dim, spacedim> interaction_plan;
+
+    /**
+     * An interaction plan and the position it was computed with. deal.II
+     * vectors do not track modifications so the key is a copy of the overlap
+     * position values: their hash is only used to skip most comparisons.
+     */
+    struct CachedInteractionPlan
+    {
+      const DoFHandler<dim, spacedim> *position_dof_handler;
+
+      std::size_t position_hash;
+
+      Vector<double> overlap_position;
+
+      InteractionPlan<dim, spacedim> plan;
+    };
+
+    /**
+     * Cached interaction plans, most recently used first. A list is used so
+     * that references to plans stay valid when other plans are added.
+     */
+    mutable std::list<CachedInteractionPlan> cached_interaction_plans;
+
+    /**
+     * Shape function and JxW values for each pair of overlap DoFHandler and
+     * mapping.
+     */
+    mutable std::map<std::pair<const DoFHandler<dim, spacedim> *,
+                               const Mapping<dim, spacedim> *>,
+                     ShapeValueCache<dim, spacedim>>
+      shape_value_caches;
   };
 } // namespace fdl
 #endif
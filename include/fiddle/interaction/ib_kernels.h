@@ -0,0 +1,312 @@
+#ifndef included_fiddle_interaction_ib_kernels_h
+#define included_fiddle_interaction_ib_kernels_h
+
+#include <fiddle/base/config.h>
+
+#include <deal.II/base/utilities.h>
+
+#include <Box.h>
+#include <Patch.h>
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+// Native implementations of the regularized delta functions used by IBAMR.
+// These are an alternative to IBTK::LEInteractor: the stencil width of each
+// kernel is known at compile time so the loops over the stencil can be
+// unrolled and vectorized by the compiler.
+
+namespace fdl
+{
+  using namespace dealii;
+  using namespace SAMRAI;
+
+  /**
+   * Peskin's three-point kernel (IBAMR's IB_3).
+   */
+  struct IB3Kernel
+  {
+    /**
+     * Number of grid points in each coordinate direction of the stencil.
+     */
+    static constexpr int width = 3;
+
+    /**
+     * Value of the kernel at @p r, measured in units of grid spacing.
+     */
+    static double
+    value(const double r);
+  };
+
+  /**
+   * Peskin's four-point kernel (IBAMR's IB_4).
+   */
+  struct IB4Kernel
+  {
+    static constexpr int width = 4;
+
+    static double
+    value(const double r);
+  };
+
+  /**
+   * Bao, Kaiser, and Peskin's six-point kernel with three continuous
+   * derivatives (IBAMR's IB_6).
+   */
+  struct IB6Kernel
+  {
+    static constexpr int width = 6;
+
+    static double
+    value(const double r);
+  };
+
+  /**
+   * The centered cardinal B-spline of order @p n, i.e., the spline of degree
+   * n - 1 whose support is [-n/2, n/2] (IBAMR's BSPLINE_n: BSplineKernel<2>
+   * is IBAMR's PIECEWISE_LINEAR).
+   */
+  template <int n>
+  struct BSplineKernel
+  {
+    static_assert(n >= 2, "B-spline kernels are only defined for n >= 2");
+
+    static constexpr int width = n;
+
+    static double
+    value(const double r);
+  };
+
+  /**
+   * The kernels which have native implementations, or None for kernels which
+   * are only available through IBTK::LEInteractor.
+   */
+  enum class NativeIBKernel
+  {
+    None,
+    IB3,
+    IB4,
+    IB6,
+    BSpline2,
+    BSpline3,
+    BSpline4,
+    BSpline5,
+    BSpline6
+  };
+
+  /**
+   * Look up the native implementation of the kernel named @p kernel_name.
+   * This compares strings, so it should be called once when an interaction
+   * is set up rather than for every patch.
+   */
+  NativeIBKernel
+  get_native_ib_kernel(const std::string &kernel_name);
+
+  /**
+   * Return <code>true</code> if @p kernel has a native implementation which
+   * can be used by interpolate_from_patch() and spread_to_patch() with data
+   * of type @p patch_type.
+   */
+  template <int spacedim, typename patch_type>
+  bool
+  has_native_ib_kernel(const NativeIBKernel kernel);
+
+  /**
+   * Same as the previous function, but look up the kernel by name.
+   */
+  template <int spacedim, typename patch_type>
+  bool
+  has_native_ib_kernel(const std::string &kernel_name);
+
+  /**
+   * Interpolate the values of @p data at each of the @p n_positions / spacedim
+   * points in @p positions which are inside @p box. This function has the same
+   * semantics as IBTK::LEInteractor::interpolate(): values at points outside
+   * @p box are not modified.
+   *
+   * @p native_kernel must be get_native_ib_kernel(kernel_name). If it is
+   * NativeIBKernel::None then this function calls
+   * IBTK::LEInteractor::interpolate() with @p kernel_name.
+   */
+  template <int spacedim, typename patch_type>
+  void
+  interpolate_from_patch(
+    double                                     *values,
+    const int                                   n_values,
+    const int                                   depth,
+    const double                               *positions,
+    const int                                   n_positions,
+    const tbox::Pointer<patch_type>            &data,
+    const tbox::Pointer<hier::Patch<spacedim>> &patch,
+    const hier::Box<spacedim>                  &box,
+    const std::string                          &kernel_name,
+    const NativeIBKernel                        native_kernel);
+
+  /**
+   * Same as the previous function, but look up the native kernel by name.
+   */
+  template <int spacedim, typename patch_type>
+  void
+  interpolate_from_patch(
+    double                                     *values,
+    const int                                   n_values,
+    const int                                   depth,
+    const double                               *positions,
+    const int                                   n_positions,
+    const tbox::Pointer<patch_type>            &data,
+    const tbox::Pointer<hier::Patch<spacedim>> &patch,
+    const hier::Box<spacedim>                  &box,
+    const std::string                          &kernel_name);
+
+  /**
+   * Spread the @p n_values values in @p values, located at the points in
+   * @p positions which are inside @p box, to @p data. This function has the
+   * same semantics as IBTK::LEInteractor::spread().
+   *
+   * @p native_kernel must be get_native_ib_kernel(kernel_name). If it is
+   * NativeIBKernel::None then this function calls IBTK::LEInteractor::spread()
+   * with @p kernel_name.
+   */
+  template <int spacedim, typename patch_type>
+  void
+  spread_to_patch(tbox::Pointer<patch_type>                  &data,
+                  const double                               *values,
+                  const int                                   n_values,
+                  const int                                   depth,
+                  const double                               *positions,
+                  const int                                   n_positions,
+                  const tbox::Pointer<hier::Patch<spacedim>> &patch,
+                  const hier::Box<spacedim>                  &box,
+                  const std::string                          &kernel_name,
+                  const NativeIBKernel                        native_kernel);
+
+  /**
+   * Same as the previous function, but look up the native kernel by name.
+   */
+  template <int spacedim, typename patch_type>
+  void
+  spread_to_patch(tbox::Pointer<patch_type>                  &data,
+                  const double                               *values,
+                  const int                                   n_values,
+                  const int                                   depth,
+                  const double                               *positions,
+                  const int                                   n_positions,
+                  const tbox::Pointer<hier::Patch<spacedim>> &patch,
+                  const hier::Box<spacedim>                  &box,
+                  const std::string                          &kernel_name);
+
+  // --------------------------- inline functions --------------------------- //
+
+  inline double
+  IB3Kernel::value(const double r)
+  {
+    const double x = std::abs(r);
+    if (x < 0.5)
+      return (1.0 + std::sqrt(1.0 - 3.0 * x * x)) / 3.0;
+    else if (x < 1.5)
+      return (5.0 - 3.0 * x - std::sqrt(1.0 - 3.0 * (1.0 - x) * (1.0 - x))) /
+             6.0;
+    else
+      return 0.0;
+  }
+
+
+
+  inline double
+  IB4Kernel::value(const double r)
+  {
+    const double x = std::abs(r);
+    if (x < 1.0)
+      return 0.125 * (3.0 - 2.0 * x + std::sqrt(1.0 + 4.0 * x - 4.0 * x * x));
+    else if (x < 2.0)
+      return 0.125 *
+             (5.0 - 2.0 * x - std::sqrt(-7.0 + 12.0 * x - 4.0 * x * x));
+    else
+      return 0.0;
+  }
+
+
+
+  inline double
+  IB6Kernel::value(const double r)
+  {
+    // For 0 <= s < 1 the moment conditions determine phi(s - 2), ...,
+    // phi(s + 2) as affine functions a[j] phi(s - 3) + b[j] of
+    // phi(s - 3). The condition that the sum of the squares of the weights is
+    // constant then gives a quadratic equation for phi(s - 3).
+    const double x = std::abs(r);
+    if (x >= 3.0)
+      return 0.0;
+    const int    segment = int(x);
+    const double s       = x - segment;
+    const double s2      = s * s;
+    const double s3      = s2 * s;
+    const double K       = 59.0 / 60.0 - std::sqrt(29.0) / 20.0;
+
+    const double a[5] = {-3.0, 2.0, 2.0, -3.0, 1.0};
+    const double b[5] = {
+      -1.0 / 16.0 + (K + s2) / 8.0 + (3.0 * K - 1.0) * s / 12.0 + s3 / 12.0,
+      1.0 / 4.0 + (4.0 - 3.0 * K) * s / 6.0 - s3 / 6.0,
+      5.0 / 8.0 - (K + s2) / 4.0,
+      1.0 / 4.0 - (4.0 - 3.0 * K) * s / 6.0 + s3 / 6.0,
+      -1.0 / 16.0 + (K + s2) / 8.0 - (3.0 * K - 1.0) * s / 12.0 - s3 / 12.0};
+    // Sum of the squares of the weights, evaluated at s = 0 (where
+    // phi(s - 3) = 0)
+    const double c0             = K / 8.0 - 1.0 / 16.0;
+    const double c2             = 5.0 / 8.0 - K / 4.0;
+    const double sum_of_squares = 2.0 * c0 * c0 + 2.0 / 16.0 + c2 * c2;
+
+    // alpha phi^2 + beta phi + gamma = 0, where phi = phi(s - 3) has
+    // coefficient 1
+    double alpha = 1.0;
+    double beta  = 0.0;
+    double gamma = -sum_of_squares;
+    for (unsigned int j = 0; j < 5; ++j)
+      {
+        alpha += a[j] * a[j];
+        beta += 2.0 * a[j] * b[j];
+        gamma += b[j] * b[j];
+      }
+    const double discriminant =
+      std::max(beta * beta - 4.0 * alpha * gamma, 0.0);
+    const double phi_s_m3 = (-beta + std::sqrt(discriminant)) / (2.0 * alpha);
+    // x = s + segment, i.e., the entry with index segment + 2
+    return a[segment + 2] * phi_s_m3 + b[segment + 2];
+  }
+
+
+
+  template <int n>
+  inline double
+  BSplineKernel<n>::value(const double r)
+  {
+    // Use the truncated power representation
+    //
+    //     M_n(x) = 1/(n - 1)! sum_k (-1)^k C(n, k) (n/2 - |x| - k)_+^(n - 1)
+    //
+    // which, by summing from the edge of the support inward, only has a
+    // single term near the edge of the support (where cancellation would
+    // otherwise be worst).
+    const double x        = std::abs(r);
+    double       result   = 0.0;
+    double       binomial = 1.0;
+    double       sign     = 1.0;
+    for (int k = 0; k <= n; ++k)
+      {
+        const double t = 0.5 * n - x - k;
+        if (t <= 0.0)
+          break;
+        result += sign * binomial * Utilities::fixed_power<n - 1>(t);
+        binomial *= double(n - k) / double(k + 1);
+        sign = -sign;
+      }
+
+    double factorial = 1.0;
+    for (int k = 2; k < n; ++k)
+      factorial *= k;
+    return result / factorial;
+  }
+} // namespace fdl
+
+#endif
@@ -46,6 +46,52 @@ namespace fdl
    *   <li>skip_initial_workload: whether to skip printing the initial workload,
    *     to work around an issue with SAMRAI. This is typically not necessary to
    *     set inside user codes. Defaults to FALSE.</li>
+   *   <li>n_threads: Maximum number of threads to use. IBAMR is not
+   *     thread-safe so only parts of fiddle which do not call IBAMR (e.g.,
+   *     counting quadrature points, interpolating or spreading with the
+   *     kernels in ib_kernels.h, and assembling Lagrangian forces with
+   *     compute_load_vector()) use threads. Hybrid MPI and threads runs
+   *     should set this to the number of cores per MPI process. Defaults to
+   *     1.</li>
+   *   <li>cache_interaction_plan: whether or not to reuse the positions of
+   *     the quadrature points used by ELEMENTAL interaction when the position
+   *     of a part has been used before (e.g., when spreading multiple forces
+   *     or computing the workload with the same position, or when the new
+   *     position of one time step is the current position of the next).
+   *     Plans are identified by position values and a few of them are kept
+   *     per part. Defaults to FALSE.</li>
+   *   <li>morton_order_cells: whether or not ELEMENTAL interaction should
+   *     visit the cells on each patch in the Morton (Z-order) order of the
+   *     Eulerian cells containing them, rather than in the order of the
+   *     Lagrangian mesh. This improves memory locality in interpolation and
+   *     spreading on large 3D patches when the cells of the Lagrangian mesh
+   *     are not already numbered in a spatially coherent way (e.g., meshes
+   *     read from files). Meshes made by refining a coarse mesh are already
+   *     nearly in this order and do not benefit. Defaults to FALSE.</li>
+   *   <li>fuse_part_interactions: whether or not ELEMENTAL interaction
+   *     should process every part on an Eulerian patch before moving on to
+   *     the next patch, rather than looping over all patches once per part.
+   *     This reduces memory traffic in models with many parts. Ignored by
+   *     NODAL interaction. Defaults to FALSE.</li>
+   *   <li>reduced_precision_transfers: whether or not to communicate the
+   *     position and force of each part in single precision when spreading or
+   *     computing the workload. This halves the amount of data sent between
+   *     processes. Values computed for interpolation (i.e., projection
+   *     right-hand sides) are always communicated in double precision.
+   *     Defaults to FALSE.</li>
+   *   <li>extra_ghost_cell_fraction: width, as a fraction of the Eulerian
+   *     cell width, of the region around each patch in which elements are
+   *     still associated with that patch. Defaults to 1.0.</li>
+   *   <li>lazy_reinit_interactions: whether or not to skip reinitializing the
+   *     interaction objects after a regrid when the patch layout did not
+   *     change and no part has moved further (in any coordinate) than the
+   *     region given by extra_ghost_cell_fraction, minus one Eulerian cell
+   *     reserved for motion before the next regrid, since the last
+   *     reinitialization. Hence this requires extra_ghost_cell_fraction to
+   *     be larger than 1.0. The displacement of the position DoFs is scaled
+   *     by the Lebesgue constant of the position element to bound the
+   *     displacement between them. ELEMENTAL interaction then keeps the
+   *     quadrature rules it picked at that time. Defaults to FALSE.</li>
    *   <li>GriddingAlgorithm: Database for setting up the internal
    *     GriddingAlgorithm object.</li>
    *   <li>LoadBalancer: Database for setting up the internal LoadBalancer
@@ -253,6 +299,13 @@ namespace fdl
     virtual void
     reinit_interactions();
 
+    /**
+     * Whether or not all parts should interact with the Eulerian data at once
+     * (see ElementalInteraction::fused_compute_projection_rhs_intermediate()).
+     */
+    bool
+    use_fused_interaction() const;
+
     /**
      * Book-keeping
      * @{
@@ -320,6 +373,13 @@ namespace fdl
      * @{
      */
     std::vector<std::unique_ptr<InteractionBase<dim, spacedim>>> interactions;
+
+    /**
+     * Position of each part when its interaction object was last
+     * reinitialized. Only used with <code>lazy_reinit_interactions</code>.
+     */
+    std::vector<LinearAlgebra::distributed::Vector<double>>
+      interaction_positions;
     /**
      * @}
      */
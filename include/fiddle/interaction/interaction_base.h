@@ -6,9 +6,12 @@
 #include <fiddle/grid/overlap_tria.h>
 #include <fiddle/grid/patch_map.h>
 
+#include <fiddle/interaction/ib_kernels.h>
+
 #include <fiddle/transfer/scatter.h>
 
 #include <deal.II/base/bounding_box.h>
+#include <deal.II/base/index_set.h>
 
 #include <deal.II/distributed/shared_tria.h>
 
@@ -19,8 +22,10 @@
 #include <deal.II/lac/vector.h>
 
 #include <BasePatchHierarchy.h>
+#include <Box.h>
 #include <PatchLevel.h>
 
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -37,11 +42,30 @@ namespace fdl
    * the computation in an intermediate step, this class' job is to
    * encapsulate that state.
    *
-   *
+   * complete_transactions() performs the intermediate and finish steps of
+   * several transactions in whatever order their communication completes,
+   * which may differ between processes. Hence these steps must not call
+   * collective MPI functions (or anything else which must be called in the
+   * same order on every process): they may only complete communication
+   * posted by earlier steps of the same transaction.
    */
   struct TransactionBase
   {
     virtual ~TransactionBase() = default;
+
+    /**
+     * Return <code>true</code> if the next step of the transaction can be
+     * performed without waiting for communication to finish. The default
+     * implementation always returns <code>true</code>.
+     *
+     * @note This function is not const since testing MPI requests for
+     * completion modifies them.
+     */
+    virtual bool
+    ready()
+    {
+      return true;
+    }
   };
 
   /**
@@ -59,6 +83,9 @@ namespace fdl
     /// Name of the IB kernel we should use.
     std::string kernel_name;
 
+    /// Native implementation of that kernel (see get_native_ib_kernel()).
+    NativeIBKernel native_kernel;
+
     /// Current patch index.
     int current_data_idx;
 
@@ -81,6 +108,10 @@ namespace fdl
     /// The other scatter (used for spreading).
     Scatter<double> solution_scatter;
 
+    /// Whether or not the position and solution are both scattered by
+    /// position_scatter (which requires that they use the same DoFHandler).
+    bool packed_spread_scatter;
+
     /// The other scatter (used for assembly).
     Scatter<double> rhs_scatter;
 
@@ -124,6 +155,19 @@ namespace fdl
 
     /// Operation of the current transaction. Used for consistency checking.
     Operation operation;
+
+    virtual bool
+    ready() override
+    {
+      if (next_state == State::Intermediate)
+        return position_scatter.test() &&
+               (operation == Operation::Interpolation ||
+                packed_spread_scatter || solution_scatter.test());
+      else if (next_state == State::Finish &&
+               operation == Operation::Interpolation)
+        return rhs_scatter.test();
+      return true;
+    }
   };
 
   /**
@@ -163,8 +207,58 @@ namespace fdl
 
     /// Next state. Used for consistency checking.
     State next_state;
+
+    virtual bool
+    ready() override
+    {
+      return next_state != State::Intermediate || position_scatter.test();
+    }
   };
 
+  /**
+   * Complete a set of transactions which have all been started, i.e., perform
+   * the intermediate and finish steps of each transaction. Rather than
+   * stepping all transactions through each step in lockstep, this function
+   * repeatedly performs the next step of whichever transaction is ready (see
+   * TransactionBase::ready()) so that a transaction whose communication is
+   * slow does not delay the computations of the others.
+   *
+   * To guarantee progress, if no transaction is ready then this function
+   * waits for the first transaction which has not yet performed its
+   * intermediate step (or, if all have, the first unfinished transaction).
+   * Since intermediate steps only depend on communication posted by start
+   * steps this cannot deadlock.
+   *
+   * If @p ordered_intermediate is <code>true</code> then the intermediate
+   * steps are performed in order of transaction index (the finish steps and
+   * the communication of later transactions still proceed out of order).
+   * Spreading needs this since the intermediate steps of every part add
+   * into the same Eulerian data: accumulating in a fixed order makes the
+   * result independent of the order in which communication finishes.
+   *
+   * @param[inout] transactions The transactions. These are all moved from.
+   *
+   * @param[in] intermediate Function performing the intermediate step of the
+   *            transaction with the given index. If this function is empty then
+   *            the transactions are assumed to have already performed their
+   *            intermediate steps.
+   *
+   * @param[in] finish Function performing the finish step of the transaction
+   *            with the given index.
+   *
+   * @param[in] ordered_intermediate Whether or not the intermediate steps
+   *            should be performed in order.
+   */
+  void
+  complete_transactions(
+    std::vector<std::unique_ptr<TransactionBase>> &transactions,
+    const std::function<std::unique_ptr<TransactionBase>(
+      std::size_t,
+      std::unique_ptr<TransactionBase>)> &intermediate,
+    const std::function<void(std::size_t, std::unique_ptr<TransactionBase>)>
+              &finish,
+    const bool ordered_intermediate = false);
+
   /**
    * Base class managing interaction between SAMRAI and deal.II data structures,
    * by interpolation and spreading, where the position of the structure is
@@ -215,6 +309,12 @@ namespace fdl
 
     /**
      * Reinitialize the object. Same as the constructor.
+     *
+     * If the overlap triangulation does not change (i.e., the same native
+     * cells intersect the patches as before) then the overlap DoFHandlers,
+     * DoF translations, and Scatter objects set up for the previous
+     * configuration are reused. This assumes that the DoFs of the native
+     * DoFHandlers have not been redistributed since they were added.
      */
     virtual void
     reinit(const parallel::shared::Triangulation<dim, spacedim> &native_tria,
@@ -232,6 +332,14 @@ namespace fdl
      * Store a pointer to @p native_dof_handler and also compute the
      * equivalent DoFHandler on the overlapping partitioning.
      *
+     * Since reinit() keeps the overlap DoFHandlers, DoF translations, and
+     * Scatter objects when the overlap triangulation does not change, this
+     * function must be called again whenever the DoFs of
+     * @p native_dof_handler are redistributed or renumbered. If the locally
+     * owned DoFs of @p native_dof_handler, or the DoF indices of its locally
+     * owned cells, changed since the last call then everything computed from
+     * it is rebuilt.
+     *
      * This call is collective over the communicator used by this class.
      */
     virtual void
@@ -353,6 +461,54 @@ namespace fdl
     virtual void
     add_workload_finish(std::unique_ptr<TransactionBase> t_ptr);
 
+    /**
+     * Set whether or not the position and solution vectors scattered for
+     * spreading and workload estimation are communicated in single precision,
+     * which halves the amount of data sent between processes. Projection
+     * right-hand sides are always communicated in double precision. Defaults
+     * to <code>false</code>.
+     */
+    void
+    set_reduced_precision_transfers(const bool use_reduced_precision);
+
+    /**
+     * Set the width, as a fraction of the Eulerian cell width, of the extra
+     * region around each patch in which elements are still associated with
+     * that patch. A larger value lets the structure move further before the
+     * object needs to be reinitialized (see reinit_patches()) at the cost of
+     * more elements per patch. Takes effect at the next call to reinit() and
+     * defaults to <code>1.0</code>.
+     */
+    void
+    set_extra_ghost_cell_fraction(const double fraction);
+
+    /**
+     * Try to update the object to use the patches in the new @p patch_hierarchy
+     * without otherwise reinitializing it. This is possible if the patches on
+     * level @p level_number on every processor have the same boxes as the
+     * ones used by the last call to reinit() and @p max_displacement (a
+     * bound on the largest change in any coordinate of any point of the
+     * structure since the last call to reinit()) is less than the extra
+     * ghost region set by set_extra_ghost_cell_fraction() minus one Eulerian
+     * cell width. No element can then move into a patch it is not already
+     * associated with before the next regrid, assuming (as IBAMR's regrid
+     * interval does) that the structure moves less than one cell between
+     * regrids. Hence this function always fails unless the extra ghost cell
+     * fraction is larger than one.
+     *
+     * @return <code>true</code> if the update succeeded and
+     * <code>false</code> otherwise, in which case the object is unchanged and
+     * reinit() must be called.
+     *
+     * @note This function is collective over the communicator of the native
+     * triangulation.
+     */
+    virtual bool
+    reinit_patches(
+      tbox::Pointer<hier::BasePatchHierarchy<spacedim>> p_hierarchy,
+      const int                                         l_number,
+      const double                                      max_displacement);
+
   protected:
     /**
      * One difficulty with the way communication is implemented in deal.II is
@@ -371,6 +527,18 @@ namespace fdl
      */
     MPI_Comm communicator;
 
+    /**
+     * Whether or not to communicate position and solution values in single
+     * precision when spreading or computing the workload.
+     */
+    bool reduced_precision_transfers = false;
+
+    /**
+     * Width of the extra region around each patch, as a fraction of the
+     * Eulerian cell width.
+     */
+    double extra_ghost_cell_fraction = 1.0;
+
     /**
      * Return a reference to the overlap dof handler corresponding to the
      * provided native dof handler.
@@ -397,6 +565,12 @@ namespace fdl
     virtual VectorOperation::values
     get_rhs_scatter_type() const;
 
+    /**
+     * Finish the scatters started by compute_spread_start().
+     */
+    static void
+    finish_spread_scatters(Transaction<dim, spacedim> &transaction);
+
     /**
      * Return a scatter corresponding to the provided native dof handler.
      */
@@ -410,6 +584,17 @@ namespace fdl
     return_scatter(const DoFHandler<dim, spacedim> &native_dof_handler,
                    Scatter<double>                &&scatter);
 
+    /**
+     * Return whether or not @p native_dof_handler has already been added
+     * and its locally owned DoFs and their numbering are the same as they
+     * were at that time.
+     * If it was added but its DoFs changed then this function forgets
+     * everything computed from it so that it can be added again.
+     */
+    bool
+    dof_handler_is_current(
+      const DoFHandler<dim, spacedim> &native_dof_handler);
+
     /**
      * @name Geometric data.
      * @{
@@ -442,6 +627,16 @@ namespace fdl
      */
     int level_number;
 
+    /**
+     * Boxes of the patches used to set up patch_map.
+     */
+    std::vector<hier::Box<spacedim>> patch_boxes;
+
+    /**
+     * Smallest Eulerian cell width on any patch of the level we interact with.
+     */
+    double patch_dx_min = 0.0;
+
     /**
      * @}
      */
@@ -458,6 +653,18 @@ namespace fdl
     std::vector<SmartPointer<const DoFHandler<dim, spacedim>>>
       native_dof_handlers;
 
+    /**
+     * Locally owned DoFs of each DoFHandler in @p native_dof_handlers at the
+     * time it was added.
+     */
+    std::vector<IndexSet> native_locally_owned_dofs;
+
+    /**
+     * Hash of the DoF indices of the locally owned cells of each DoFHandler in
+     * @p native_dof_handlers at the time it was added.
+     */
+    std::vector<std::size_t> native_dof_numbering_hashes;
+
     /**
      * DoFHandlers defined on the overlap tria, which are equivalent to those
      * stored by @p native_dof_handlers.
@@ -473,7 +680,9 @@ namespace fdl
 
     /**
      * Scatter objects for moving vectors between native and overlap
-     * representations. Indexed first by the number of the dof handler.
+     * representations. Indexed first by the number of the dof handler. Since
+     * each Scatter sets up persistent MPI requests the first time it is used,
+     * these are kept until reinit() changes the overlap triangulation.
      */
     std::vector<std::vector<Scatter<double>>> scatters;
     /**
@@ -6,11 +6,15 @@
 #include <fiddle/grid/nodal_patch_map.h>
 #include <fiddle/grid/patch_map.h>
 
+#include <fiddle/interaction/ib_kernels.h>
+#include <fiddle/interaction/tensor_product_evaluator.h>
+
 #include <deal.II/base/bounding_box.h>
 #include <deal.II/base/quadrature.h>
 
 #include <deal.II/dofs/dof_handler.h>
 
+#include <deal.II/fe/fe.h>
 #include <deal.II/fe/mapping.h>
 
 #include <deal.II/lac/vector.h>
@@ -18,6 +22,7 @@
 #include <PatchLevel.h>
 
 #include <memory>
+#include <string>
 #include <vector>
 
 // This file contains the functions that do all the actual interaction work -
@@ -39,6 +44,289 @@ namespace fdl
             const int                                         tag_index,
             tbox::Pointer<hier::PatchLevel<spacedim>>         patch_level);
 
+  /**
+   * The positions of the quadrature points of every cell stored by a
+   * PatchMap, ordered by patch.
+   *
+   * Computing quadrature point positions requires evaluating the position
+   * mapping (typically a MappingFEField) on each cell, which is expensive.
+   * Since this only depends on the position and the quadrature rules (and not
+   * on the data being interpolated or spread) it can be computed once and
+   * reused until either the position or the PatchMap changes.
+   */
+  template <int dim, int spacedim = dim>
+  struct InteractionPlan
+  {
+    /**
+     * Number of cells. Cells which intersect multiple patches are counted
+     * once per patch.
+     */
+    std::size_t
+    n_cells() const
+    {
+      return cells.size();
+    }
+
+    /**
+     * Number of quadrature points.
+     */
+    std::size_t
+    n_q_points() const
+    {
+      return cell_q_point_offsets.empty() ? 0 : cell_q_point_offsets.back();
+    }
+
+    /**
+     * Index of the first quadrature point on patch @p patch_n. Valid values
+     * are between 0 and the number of patches (inclusive).
+     */
+    std::size_t
+    patch_q_point_offset(const std::size_t patch_n) const
+    {
+      AssertIndexRange(patch_n, patch_cell_offsets.size());
+      return cell_q_point_offsets[patch_cell_offsets[patch_n]];
+    }
+
+    /**
+     * Active cells of the PatchMap's Triangulation, ordered by patch.
+     */
+    std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+      cells;
+
+    /**
+     * The cells on patch p are in [patch_cell_offsets[p],
+     * patch_cell_offsets[p + 1]).
+     */
+    std::vector<std::size_t> patch_cell_offsets;
+
+    /**
+     * The quadrature points on cell c are in [cell_q_point_offsets[c],
+     * cell_q_point_offsets[c + 1]).
+     */
+    std::vector<std::size_t> cell_q_point_offsets;
+
+    /**
+     * Quadrature point positions in point-first ordering (i.e., {x0, y0, x1,
+     * y1, ...}).
+     */
+    std::vector<double> q_points;
+  };
+
+  /**
+   * Compute the positions of the quadrature points of every cell in
+   * @p patch_map.
+   *
+   * @param[in] patch_map The mapping between SAMRAI patches and deal.II cells.
+   *
+   * @param[in] position_mapping Mapping from the reference configuration to the
+   * current configuration of the mesh.
+   *
+   * @param[in] quadrature_indices This vector is indexed by the active cell
+   * index - the value is the index into @p quadratures corresponding to the
+   * correct quadrature rule on that cell.
+   *
+   * @param[in] quadratures The vector of quadratures we use for interaction.
+   *
+   * @param[out] plan The computed quadrature point positions.
+   */
+  template <int dim, int spacedim>
+  void
+  compute_interaction_plan(const PatchMap<dim, spacedim>    &patch_map,
+                           const Mapping<dim, spacedim>     &position_mapping,
+                           const std::vector<unsigned char> &quadrature_indices,
+                           const std::vector<Quadrature<dim>> &quadratures,
+                           InteractionPlan<dim, spacedim>     &plan);
+
+  /**
+   * Same as above, but specify the position as a finite element field instead
+   * of as a Mapping. On cells where the position element and quadrature rule
+   * have tensor-product structure (e.g., FESystem<FE_Q> and QGauss) the
+   * positions are computed with sum factorization (see
+   * TensorProductEvaluator) instead of MappingFEField.
+   */
+  template <int dim, int spacedim>
+  void
+  compute_interaction_plan(
+    const PatchMap<dim, spacedim>      &patch_map,
+    const DoFHandler<dim, spacedim>    &position_dof_handler,
+    const Vector<double>               &position,
+    const std::vector<unsigned char>   &quadrature_indices,
+    const std::vector<Quadrature<dim>> &quadratures,
+    InteractionPlan<dim, spacedim>     &plan);
+
+  /**
+   * Reorder the cells on each patch of @p plan (along with their quadrature
+   * points) by the Morton (Z-order) index of the Eulerian cell containing
+   * the centroid of each cell's quadrature points.
+   *
+   * PatchMap stores cells in the order of the Lagrangian Triangulation, so
+   * consecutive cells are usually far apart in the Eulerian grid. Sorting
+   * them in this way makes interpolation and spreading on a patch sweep
+   * through the patch data in a nearly sequential order, which reduces cache
+   * and TLB misses on large (particularly 3D) patches. The results of
+   * interaction only change by roundoff.
+   *
+   * This only helps if the Lagrangian cells are not already numbered in a
+   * spatially coherent order: cells created by global refinement are
+   * numbered hierarchically, which is already close to Morton order.
+   */
+  template <int dim, int spacedim>
+  void
+  morton_order_interaction_plan(const PatchMap<dim, spacedim> &patch_map,
+                                InteractionPlan<dim, spacedim> &plan);
+
+  /**
+   * Shape function values and JxW values of every cell of a DoFHandler,
+   * computed with a fixed mapping (typically the reference configuration of
+   * a Part).
+   *
+   * These values only depend on the Triangulation, the finite element, the
+   * mapping, and the quadrature rules, so they can be computed once when the
+   * overlap Triangulation is set up and reused by every subsequent
+   * interpolation and spreading operation.
+   *
+   * Only primitive elements whose shape function values do not depend on the
+   * mapping (e.g., FE_Q, FE_SimplexP, and FESystems of them) are supported:
+   * for these elements the shape function values only depend on the
+   * quadrature rule and are not stored separately for each cell.
+   */
+  template <int dim, int spacedim = dim>
+  struct ShapeValueCache
+  {
+    /**
+     * Return a pointer to the values of the shape functions for quadrature
+     * rule @p quad_index. The value of shape function i at quadrature point q
+     * is entry q * dofs_per_cell + i.
+     */
+    const double *
+    get_shape_values(const unsigned char quad_index) const
+    {
+      AssertIndexRange(quad_index, shape_values.size());
+      return shape_values[quad_index].data();
+    }
+
+    /**
+     * Return a pointer to the JxW values of the cell with active cell index
+     * @p active_cell_index.
+     */
+    const double *
+    get_JxW_values(const std::size_t active_cell_index) const
+    {
+      AssertIndexRange(active_cell_index + 1, cell_JxW_offsets.size());
+      return JxW_values.data() + cell_JxW_offsets[active_cell_index];
+    }
+
+    /**
+     * Vector component of each shape function.
+     */
+    std::vector<unsigned int> components;
+
+    /**
+     * Shape function values for each quadrature rule.
+     */
+    std::vector<std::vector<double>> shape_values;
+
+    /**
+     * The JxW values of the cell with active cell index c are in
+     * [cell_JxW_offsets[c], cell_JxW_offsets[c + 1]).
+     */
+    std::vector<std::size_t> cell_JxW_offsets;
+
+    /**
+     * JxW values, stored contiguously and ordered by active cell index.
+     */
+    std::vector<double> JxW_values;
+
+    /**
+     * Sum factorization evaluators for each quadrature rule. Entries are
+     * <code>nullptr</code> when the element or quadrature rule does not have
+     * tensor-product structure.
+     */
+    std::vector<std::shared_ptr<const TensorProductEvaluator<dim, spacedim>>>
+      evaluators;
+
+    /**
+     * Number of DoFs of the base element if every vector component uses the
+     * same scalar base element (e.g., FESystem(FE_Q(p), spacedim)) and zero
+     * otherwise. If this is nonzero then cell right-hand sides can be
+     * computed with the kernels in cell_rhs_kernels.h.
+     */
+    unsigned int n_base_dofs = 0;
+
+    /**
+     * Values of the shape functions of the base element for each quadrature
+     * rule: the value of base shape function k at quadrature point q is entry
+     * q * n_base_dofs + k. Empty if n_base_dofs is zero.
+     */
+    std::vector<std::vector<double>> base_shape_values;
+
+    /**
+     * The cell DoF corresponding to entry k * n_components + c of the output
+     * of a CellRHSKernel. Empty if n_base_dofs is zero.
+     */
+    std::vector<unsigned int> base_rhs_dofs;
+  };
+
+  /**
+   * Return <code>true</code> if ShapeValueCache supports @p fe.
+   */
+  template <int dim, int spacedim>
+  bool
+  supports_shape_value_cache(const FiniteElement<dim, spacedim> &fe);
+
+  /**
+   * Compute the shape function and JxW values of every active cell of
+   * @p dof_handler.
+   */
+  template <int dim, int spacedim>
+  void
+  compute_shape_value_cache(
+    const DoFHandler<dim, spacedim>    &dof_handler,
+    const Mapping<dim, spacedim>       &mapping,
+    const std::vector<unsigned char>   &quadrature_indices,
+    const std::vector<Quadrature<dim>> &quadratures,
+    ShapeValueCache<dim, spacedim>     &shape_value_cache);
+
+  /**
+   * Everything needed to interact with one part (i.e., one Lagrangian mesh
+   * and the finite element field defined on it) in the multi-part versions of
+   * compute_projection_rhs() and compute_spread(). The arguments have the
+   * same meaning as the corresponding arguments of the single-part versions.
+   *
+   * All parts must use PatchMap objects which store the same patches in the
+   * same order (e.g., ones set up from the same patch level), and all
+   * pointers must remain valid until the interaction is complete.
+   */
+  template <int dim, int spacedim>
+  struct PartInteractionData
+  {
+    std::string kernel_name;
+
+    /**
+     * Must be get_native_ib_kernel(kernel_name). This is stored separately so
+     * that the kernel is looked up once per interaction rather than once per
+     * patch.
+     */
+    NativeIBKernel native_kernel = NativeIBKernel::None;
+
+    const PatchMap<dim, spacedim> *patch_map = nullptr;
+
+    const InteractionPlan<dim, spacedim> *plan = nullptr;
+
+    const std::vector<unsigned char> *quadrature_indices = nullptr;
+
+    const std::vector<Quadrature<dim>> *quadratures = nullptr;
+
+    const DoFHandler<dim, spacedim> *dof_handler = nullptr;
+
+    const Mapping<dim, spacedim> *mapping = nullptr;
+
+    /**
+     * May be <code>nullptr</code>.
+     */
+    const ShapeValueCache<dim, spacedim> *shape_value_cache = nullptr;
+  };
+
   /**
    * Add the number of quadrature points.
    *
@@ -72,6 +360,15 @@ namespace fdl
                           const std::vector<unsigned char> &quadrature_indices,
                           const std::vector<Quadrature<dim>> &quadratures);
 
+  /**
+   * Same as above, but use precomputed quadrature point positions.
+   */
+  template <int dim, int spacedim = dim>
+  void
+  count_quadrature_points(const int                             qp_data_idx,
+                          PatchMap<dim, spacedim>              &patch_map,
+                          const InteractionPlan<dim, spacedim> &plan);
+
   /**
    * Count the number of nodes in each patch.
    *
@@ -133,6 +430,42 @@ namespace fdl
                          const Mapping<dim, spacedim>       &mapping,
                          Vector<double>                     &rhs);
 
+  /**
+   * Same as above, but use precomputed quadrature point positions. If
+   * @p shape_value_cache is not <code>nullptr</code> then its values are used
+   * instead of evaluating shape functions and JxW values with @p mapping.
+   */
+  template <int dim, int spacedim = dim>
+  void
+  compute_projection_rhs(
+    const std::string                    &kernel_name,
+    const int                             data_idx,
+    const PatchMap<dim, spacedim>        &patch_map,
+    const InteractionPlan<dim, spacedim> &plan,
+    const std::vector<unsigned char>     &quadrature_indices,
+    const std::vector<Quadrature<dim>>   &quadratures,
+    const DoFHandler<dim, spacedim>      &dof_handler,
+    const Mapping<dim, spacedim>         &mapping,
+    Vector<double>                       &rhs,
+    const ShapeValueCache<dim, spacedim> *shape_value_cache = nullptr);
+
+  /**
+   * Same as above, but for several parts (i.e., Lagrangian meshes, each with
+   * its own finite element field, kernel, and PatchMap) at once: every part is
+   * interpolated on a patch before moving on to the next patch, so each
+   * patch's data is only read through the cache once instead of once per
+   * part. The right-hand side of part @p i is computed in @p rhs[i].
+   *
+   * Patches are processed in parallel if every part uses a kernel
+   * implemented in ib_kernels.h and serially otherwise.
+   */
+  template <int dim, int spacedim>
+  void
+  compute_projection_rhs(
+    const int                                              data_idx,
+    const std::vector<PartInteractionData<dim, spacedim>> &parts,
+    const std::vector<Vector<double> *>                   &rhs);
+
   /**
    * Interpolate Eulerian data at specified Lagrangian points.
    *
@@ -206,6 +539,42 @@ namespace fdl
                  const Mapping<dim, spacedim>       &mapping,
                  const Vector<double>               &solution);
 
+  /**
+   * Same as above, but use precomputed quadrature point positions. If
+   * @p shape_value_cache is not <code>nullptr</code> then its values are used
+   * instead of evaluating shape functions and JxW values with @p mapping.
+   */
+  template <int dim, int spacedim>
+  void
+  compute_spread(
+    const std::string                    &kernel_name,
+    const int                             data_idx,
+    PatchMap<dim, spacedim>              &patch_map,
+    const InteractionPlan<dim, spacedim> &plan,
+    const std::vector<unsigned char>     &quadrature_indices,
+    const std::vector<Quadrature<dim>>   &quadratures,
+    const DoFHandler<dim, spacedim>      &dof_handler,
+    const Mapping<dim, spacedim>         &mapping,
+    const Vector<double>                 &solution,
+    const ShapeValueCache<dim, spacedim> *shape_value_cache = nullptr);
+
+  /**
+   * Same as above, but for several parts at once: every part is spread onto
+   * a patch before moving on to the next patch (see the multi-part version
+   * of compute_projection_rhs()). The field of part @p i is @p solutions[i].
+   * As in that function, patches are processed in parallel if every part uses
+   * a kernel implemented in ib_kernels.h.
+   *
+   * @note Though the PatchMap objects in @p parts are const, the patches
+   * they store pointers to are modified.
+   */
+  template <int dim, int spacedim>
+  void
+  compute_spread(
+    const int                                              data_idx,
+    const std::vector<PartInteractionData<dim, spacedim>> &parts,
+    const std::vector<const Vector<double> *>             &solutions);
+
   /**
    * Spread Lagrangian data at specified Lagrangian points.
    *
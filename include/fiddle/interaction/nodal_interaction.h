@@ -79,6 +79,15 @@ namespace fdl
            const DoFHandler<dim, spacedim> &position_dof_handler,
            const LinearAlgebra::distributed::Vector<double> &position);
 
+    /**
+     * Same as the base class version, but also updates the nodal patch map.
+     */
+    virtual bool
+    reinit_patches(
+      tbox::Pointer<hier::BasePatchHierarchy<spacedim>> p_hierarchy,
+      const int                                         l_number,
+      const double max_displacement) override;
+
     /**
      * Same as base class but also sets up some necessary internal data
      * structures used by this class
@@ -0,0 +1,129 @@
+#ifndef included_fiddle_interaction_tensor_product_evaluator_h
+#define included_fiddle_interaction_tensor_product_evaluator_h
+
+#include <fiddle/base/config.h>
+
+#include <deal.II/base/quadrature.h>
+
+#include <deal.II/fe/fe.h>
+
+#include <array>
+#include <vector>
+
+namespace fdl
+{
+  using namespace dealii;
+
+  /**
+   * Class for evaluating finite element fields at the points of a
+   * tensor-product quadrature rule via sum factorization.
+   *
+   * FEValues evaluates a field by looping over all shape functions at every
+   * quadrature point, which costs O(p^(2 dim)) operations per cell for an
+   * element of degree p. If both the element and the quadrature rule have
+   * tensor-product structure then we can instead apply the 1D shape function
+   * values one coordinate direction at a time, which only costs O(p^(dim +
+   * 1)) operations.
+   *
+   * This class supports FE_Q and FESystems consisting only of FE_Q elements
+   * of equal degree (e.g., the position and force elements of a hexahedral
+   * Part) combined with tensor-product quadrature rules (e.g., QGauss). Since
+   * the field is evaluated on the reference cell, the result is the same as
+   * FEValues::get_function_values() for any mapping.
+   */
+  template <int dim, int spacedim = dim>
+  class TensorProductEvaluator
+  {
+  public:
+    /**
+     * Return <code>true</code> if this class can be used with the given
+     * finite element and quadrature rule.
+     */
+    static bool
+    is_supported(const FiniteElement<dim, spacedim> &fe,
+                 const Quadrature<dim>              &quadrature);
+
+    /**
+     * Constructor.
+     */
+    TensorProductEvaluator(const FiniteElement<dim, spacedim> &fe,
+                           const Quadrature<dim>              &quadrature);
+
+    /**
+     * Number of vector components of the finite element.
+     */
+    unsigned int
+    n_components() const;
+
+    /**
+     * Number of quadrature points.
+     */
+    unsigned int
+    n_q_points() const;
+
+    /**
+     * Evaluate the finite element field defined by the cell-local DoF values
+     * @p dof_values (in the element's own DoF ordering) at each quadrature
+     * point. The results are written to @p values in point-first ordering
+     * (i.e., all components of the first point, then all components of the
+     * second point, etc.).
+     *
+     * @p scratch is resized as needed - it is an argument so that this
+     * function can be called concurrently by multiple threads.
+     */
+    void
+    evaluate(const double        *dof_values,
+             double              *values,
+             std::vector<double> &scratch) const;
+
+  protected:
+    /**
+     * Number of vector components.
+     */
+    unsigned int n_vector_components;
+
+    /**
+     * Number of shape functions in each coordinate direction.
+     */
+    unsigned int n_dofs_1d;
+
+    /**
+     * Number of quadrature points in each coordinate direction.
+     */
+    std::array<unsigned int, dim> n_q_points_1d;
+
+    /**
+     * Values of the 1D shape functions at the 1D quadrature points of each
+     * coordinate direction: the value of shape function i at point q is entry
+     * q * n_dofs_1d + i.
+     */
+    std::array<std::vector<double>, dim> shape_values_1d;
+
+    /**
+     * The DoF of component c with lexicographic index l is entry
+     * c * n_dofs_1d^dim + l.
+     */
+    std::vector<unsigned int> lexicographic_dofs;
+  };
+
+  // --------------------------- inline functions --------------------------- //
+
+  template <int dim, int spacedim>
+  inline unsigned int
+  TensorProductEvaluator<dim, spacedim>::n_components() const
+  {
+    return n_vector_components;
+  }
+
+  template <int dim, int spacedim>
+  inline unsigned int
+  TensorProductEvaluator<dim, spacedim>::n_q_points() const
+  {
+    unsigned int result = 1;
+    for (unsigned int d = 0; d < dim; ++d)
+      result *= n_q_points_1d[d];
+    return result;
+  }
+} // namespace fdl
+
+#endif
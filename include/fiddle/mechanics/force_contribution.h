@@ -7,23 +7,60 @@
 
 #include <fiddle/mechanics/mechanics_values.h>
 
+#include <deal.II/base/array_view.h>
 #include <deal.II/base/quadrature.h>
+#include <deal.II/base/vectorization.h>
 
 #include <deal.II/fe/fe_update_flags.h>
 
 #include <deal.II/lac/la_parallel_vector.h>
 
+#include <vector>
+
 namespace fdl
 {
   using namespace dealii;
 
   /**
    * Interface class for force contributions from various sources to Parts.
+   *
+   * <h3>Thread safety</h3>
+   *
+   * compute_load_vector() and compute_boundary_force_load_vector() assemble
+   * forces with multiple threads (see the <code>n_threads</code> parameter
+   * of IFEDMethod). Hence the const member functions of this class (i.e.,
+   * compute_force(), compute_stress(), and the other compute functions) may
+   * be called concurrently on the same object with different
+   * MechanicsValues objects and must be thread-safe: they should not modify
+   * any member variables (in particular, <code>mutable</code> scratch
+   * arrays are not allowed) and should store temporary values in local
+   * variables instead. setup_force() and finish_force() are always called
+   * by a single thread.
    */
   template <int dim, int spacedim = dim, typename Number = double>
   class ForceContribution
   {
   public:
+    /**
+     * Temporary arrays used to evaluate a force which supports batched
+     * evaluation on a single cell. Callers which evaluate forces on many
+     * cells (e.g., each thread of compute_load_vector()) should keep one
+     * of these around instead of reallocating them for every cell. The
+     * update flags must include those of every force evaluated with it.
+     */
+    struct BatchScratch
+    {
+      BatchScratch(const MechanicsUpdateFlags flags)
+        : values(flags)
+      {}
+
+      BatchedMechanicsValues<dim, spacedim, Number> values;
+
+      std::vector<Tensor<1, spacedim, VectorizedArray<Number>>> forces;
+
+      std::vector<Tensor<2, spacedim, VectorizedArray<Number>>> stresses;
+    };
+
     /**
      * Constructor
      */
@@ -101,6 +138,19 @@ namespace fdl
       return false;
     }
 
+    /**
+     * Boundary forces which only apply to part of the boundary should return
+     * the boundary ids of the faces on which they are nonzero.
+     * compute_boundary_force_load_vector() does not evaluate the force on any
+     * other face. Defaults to an empty vector, which means that the force
+     * applies to every boundary face.
+     */
+    virtual std::vector<types::boundary_id>
+    get_boundary_ids() const
+    {
+      return {};
+    }
+
     /**
      * Some forces that are not defined in a straightforward way (e.g., pressure
      * fields) require additional setup before their force contribution is
@@ -167,33 +217,208 @@ namespace fdl
     }
 
     /**
-     * Compute a volume force. Defaults to calling compute_force.
+     * Compute a volume force. Defaults to calling compute_force() or, if this
+     * force supports batched evaluation, compute_volume_force_batch().
      */
     virtual void
     compute_volume_force(
       const double                          time,
       const MechanicsValues<dim, spacedim> &m_values,
-      const typename Triangulation<dim, spacedim>::active_cell_iterator
-        & /*cell*/,
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
       ArrayView<Tensor<1, spacedim, Number>> &forces) const
     {
-      compute_force(time, m_values, forces);
+      if (supports_batched_evaluation())
+        {
+          BatchScratch scratch(get_mechanics_update_flags());
+          compute_volume_force_with_batch(
+            time, m_values, cell, forces, scratch);
+        }
+      else
+        compute_force(time, m_values, forces);
     }
 
+    /**
+     * Same as the other compute_volume_force(), but forces which support
+     * batched evaluation call compute_volume_force_batch() with the
+     * caller-owned temporary arrays in @p scratch. Since this skips the
+     * per-cell function, overriding compute_volume_force() does not change
+     * what this function computes for such forces.
+     */
+    void
+    compute_volume_force(
+      const double                          time,
+      const MechanicsValues<dim, spacedim> &m_values,
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      ArrayView<Tensor<1, spacedim, Number>> &forces,
+      BatchScratch                           &scratch) const
+    {
+      if (supports_batched_evaluation())
+        compute_volume_force_with_batch(time, m_values, cell, forces, scratch);
+      else
+        compute_volume_force(time, m_values, cell, forces);
+    }
+
+    /**
+     * Compute a stress. Forces which support batched evaluation do not need
+     * to implement this function since it defaults to calling
+     * compute_stress_batch().
+     */
     virtual void
     compute_stress(
       const double                          time,
       const MechanicsValues<dim, spacedim> &me_values,
       const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
       ArrayView<Tensor<2, spacedim, Number>> &stresses) const
+    {
+      AssertThrow(supports_batched_evaluation(),
+                  ExcMessage("Stresses which do not support batched "
+                             "evaluation must implement compute_stress()."));
+      BatchScratch scratch(get_mechanics_update_flags());
+      compute_stress_with_batch(time, me_values, cell, stresses, scratch);
+    }
+
+    /**
+     * Same as the other compute_stress(), but forces which support batched
+     * evaluation call compute_stress_batch() with the caller-owned temporary
+     * arrays in @p scratch. Like the equivalent compute_volume_force(),
+     * overriding compute_stress() does not change what this function
+     * computes for such forces.
+     */
+    void
+    compute_stress(
+      const double                          time,
+      const MechanicsValues<dim, spacedim> &me_values,
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      ArrayView<Tensor<2, spacedim, Number>> &stresses,
+      BatchScratch                           &scratch) const
+    {
+      if (supports_batched_evaluation())
+        compute_stress_with_batch(time, me_values, cell, stresses, scratch);
+      else
+        compute_stress(time, me_values, cell, stresses);
+    }
+
+    /**
+     * Whether or not this force can be computed with compute_stress_batch()
+     * or compute_volume_force_batch(), which evaluate the force on a block of
+     * quadrature points stored in VectorizedArray lanes at once. The
+     * matrix-free version of compute_load_vector() calls these functions once
+     * per batch of cells for forces which support them. Defaults to
+     * <code>false</code>.
+     *
+     * Forces which support batched evaluation only need to implement the
+     * batched functions: the per-cell functions compute_stress() and
+     * compute_volume_force() are implemented in terms of them.
+     */
+    virtual bool
+    supports_batched_evaluation() const
+    {
+      return false;
+    }
+
+    /**
+     * Batched version of compute_stress(). Unlike compute_stress(), the
+     * stress at each quadrature point should be <em>added</em> to
+     * @p stresses, which is shared by all stresses, so that no temporary
+     * arrays are necessary.
+     *
+     * The cell corresponding to a lane is available via
+     * BatchedMechanicsValues::get_cell().
+     */
+    virtual void
+    compute_stress_batch(
+      const double                                         time,
+      const BatchedMechanicsValues<dim, spacedim, Number> &me_values,
+      ArrayView<Tensor<2, spacedim, VectorizedArray<Number>>> &stresses) const
     {
       (void)time;
       (void)me_values;
-      (void)cell;
       (void)stresses;
       Assert(false, ExcFDLInternalError());
     }
 
+    /**
+     * Batched version of compute_volume_force(). Like
+     * compute_stress_batch(), the force at each quadrature point should be
+     * <em>added</em> to @p forces.
+     */
+    virtual void
+    compute_volume_force_batch(
+      const double                                         time,
+      const BatchedMechanicsValues<dim, spacedim, Number> &me_values,
+      ArrayView<Tensor<1, spacedim, VectorizedArray<Number>>> &forces) const
+    {
+      (void)time;
+      (void)me_values;
+      (void)forces;
+      Assert(false, ExcFDLInternalError());
+    }
+
+  protected:
+    /**
+     * Evaluate compute_volume_force_batch() on a single cell. Unlike the
+     * public compute_volume_force() functions this never calls a virtual
+     * per-cell function, so the two can forward to it without recursing.
+     */
+    void
+    compute_volume_force_with_batch(
+      const double                          time,
+      const MechanicsValues<dim, spacedim> &m_values,
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      ArrayView<Tensor<1, spacedim, Number>> &forces,
+      BatchScratch                           &scratch) const
+    {
+      scratch.values.reinit(cell, m_values);
+      scratch.forces.assign(scratch.values.n_entries(),
+                            Tensor<1, spacedim, VectorizedArray<Number>>());
+      auto view = make_array_view(scratch.forces);
+      compute_volume_force_batch(time, scratch.values, view);
+      unpack_batch(scratch.forces, forces);
+    }
+
+    /**
+     * Same as compute_volume_force_with_batch(), but for stresses.
+     */
+    void
+    compute_stress_with_batch(
+      const double                          time,
+      const MechanicsValues<dim, spacedim> &me_values,
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      ArrayView<Tensor<2, spacedim, Number>> &stresses,
+      BatchScratch                           &scratch) const
+    {
+      scratch.values.reinit(cell, me_values);
+      scratch.stresses.assign(scratch.values.n_entries(),
+                              Tensor<2, spacedim, VectorizedArray<Number>>());
+      auto view = make_array_view(scratch.stresses);
+      compute_stress_batch(time, scratch.values, view);
+      unpack_batch(scratch.stresses, stresses);
+    }
+
+    /**
+     * Copy values computed by a batched function with one quadrature point
+     * per lane into an array with one value per quadrature point.
+     */
+    template <int rank>
+    static void
+    unpack_batch(
+      const std::vector<Tensor<rank, spacedim, VectorizedArray<Number>>>
+                                                &batch_values,
+      ArrayView<Tensor<rank, spacedim, Number>> &values)
+    {
+      constexpr unsigned int n_lanes = VectorizedArray<Number>::size();
+      for (unsigned int qp_n = 0; qp_n < values.size(); ++qp_n)
+        for (unsigned int i = 0;
+             i < Tensor<rank, spacedim, Number>::n_independent_components;
+             ++i)
+          {
+            const auto index =
+              Tensor<rank, spacedim, Number>::unrolled_to_component_indices(i);
+            values[qp_n][index] =
+              batch_values[qp_n / n_lanes][index][qp_n % n_lanes];
+          }
+    }
+
   private:
     bool is_volumetric;
 
@@ -81,9 +81,13 @@ namespace fdl
                                                current_position;
     LinearAlgebra::distributed::Vector<double> reference_position;
 
-    mutable std::vector<types::global_dof_index> scratch_cell_dofs;
-    mutable std::vector<double>                  scratch_dof_values;
-    mutable std::vector<Tensor<1, spacedim>>     scratch_qp_values;
+    /**
+     * Compute the spring force at the quadrature points of the cell on which
+     * @p fe_values was last reinitialized.
+     */
+    std::vector<Tensor<1, spacedim>>
+    compute_spring_force_values(
+      const FEValuesBase<dim, spacedim> &fe_values) const;
   };
 
   /**
@@ -210,6 +214,9 @@ namespace fdl
     virtual bool
     is_boundary_force() const override;
 
+    virtual std::vector<types::boundary_id>
+    get_boundary_ids() const override;
+
     virtual void
     compute_boundary_force(
       const double                          time,
@@ -332,6 +339,9 @@ namespace fdl
     virtual bool
     is_boundary_force() const override;
 
+    virtual std::vector<types::boundary_id>
+    get_boundary_ids() const override;
+
     virtual void
     compute_boundary_force(
       const double                          time,
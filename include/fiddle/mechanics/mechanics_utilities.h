@@ -11,6 +11,8 @@
 
 #include <deal.II/lac/la_parallel_vector.h>
 
+#include <deal.II/matrix_free/matrix_free.h>
+
 #include <vector>
 
 namespace fdl
@@ -47,6 +49,32 @@ namespace fdl
     const LinearAlgebra::distributed::Vector<double>      &current_velocity,
     LinearAlgebra::distributed::Vector<double>            &force_rhs);
 
+  /**
+   * A locally owned face on the physical boundary of a mesh (i.e., a boundary
+   * face without a periodic neighbor).
+   */
+  template <int dim, int spacedim = dim>
+  struct BoundaryFace
+  {
+    typename DoFHandler<dim, spacedim>::active_cell_iterator cell;
+
+    unsigned int face_n;
+
+    types::boundary_id boundary_id;
+  };
+
+  /**
+   * Compute the list of locally owned physical boundary faces of
+   * @p dof_handler, sorted by boundary id (and then in the order of the
+   * active cells).
+   *
+   * Computing this list requires looping over all active cells so it should
+   * be computed once and reused (e.g., via Part::get_boundary_faces()).
+   */
+  template <int dim, int spacedim = dim>
+  std::vector<BoundaryFace<dim, spacedim>>
+  make_boundary_faces(const DoFHandler<dim, spacedim> &dof_handler);
+
   /**
    * Compute the contribution of boundary forces and add them to the given load
    * vector.
@@ -62,14 +90,82 @@ namespace fdl
     const LinearAlgebra::distributed::Vector<double>      &current_velocity,
     LinearAlgebra::distributed::Vector<double>            &force_rhs);
 
+  /**
+   * Same as the previous function, but only loop over the faces in
+   * @p boundary_faces, which should be the output of make_boundary_faces().
+   * Each force is only evaluated on faces whose boundary id is in
+   * ForceContribution::get_boundary_ids().
+   */
+  template <int dim, int spacedim = dim>
+  void
+  compute_boundary_force_load_vector(
+    const DoFHandler<dim, spacedim>                       &dof_handler,
+    const Mapping<dim, spacedim>                          &mapping,
+    const std::vector<BoundaryFace<dim, spacedim>>        &boundary_faces,
+    const std::vector<ForceContribution<dim, spacedim> *> &force_contributions,
+    const double                                           time,
+    const LinearAlgebra::distributed::Vector<double>      &current_position,
+    const LinearAlgebra::distributed::Vector<double>      &current_velocity,
+    LinearAlgebra::distributed::Vector<double>            &force_rhs);
+
   /**
    * Combined function that calls all of the previous functions.
+   *
+   * The loops over cells in this function and
+   * compute_boundary_force_load_vector() are run in parallel with WorkStream
+   * (using up to MultithreadInfo::n_threads() threads) so the force
+   * contributions must be thread-safe - see ForceContribution.
+   */
+  template <int dim, int spacedim = dim>
+  void
+  compute_load_vector(
+    const DoFHandler<dim, spacedim>                       &dof_handler,
+    const Mapping<dim, spacedim>                          &mapping,
+    const std::vector<ForceContribution<dim, spacedim> *> &force_contributions,
+    const double                                           time,
+    const LinearAlgebra::distributed::Vector<double>      &current_position,
+    const LinearAlgebra::distributed::Vector<double>      &current_velocity,
+    LinearAlgebra::distributed::Vector<double>            &force_rhs);
+
+  /**
+   * Same as the previous function, but use @p matrix_free (i.e., FEEvaluation
+   * and sum factorization) to compute the contributions of stresses and
+   * volume forces which support batched evaluation (see
+   * ForceContribution::supports_batched_evaluation()) and whose cell
+   * quadrature is one of the quadrature rules @p matrix_free was set up with
+   * (Part::get_matrix_free() is set up with the quadratures of the part's
+   * forces). All other forces are computed in the same way as the previous
+   * function.
+   *
+   * @p matrix_free must have been set up with @p dof_handler and @p mapping
+   * and the vectors must use its partitioning (e.g., Part::get_matrix_free()).
+   * Since MatrixFree does not support codimension one meshes, this function is
+   * equivalent to the previous one when dim != spacedim.
+   */
+  template <int dim, int spacedim = dim>
+  void
+  compute_load_vector(
+    const DoFHandler<dim, spacedim>                       &dof_handler,
+    const Mapping<dim, spacedim>                          &mapping,
+    const MatrixFree<dim, double>                         &matrix_free,
+    const std::vector<ForceContribution<dim, spacedim> *> &force_contributions,
+    const double                                           time,
+    const LinearAlgebra::distributed::Vector<double>      &current_position,
+    const LinearAlgebra::distributed::Vector<double>      &current_velocity,
+    LinearAlgebra::distributed::Vector<double>            &force_rhs);
+
+  /**
+   * Same as the previous function, but use the precomputed list of boundary
+   * faces @p boundary_faces (e.g., Part::get_boundary_faces()) to compute
+   * the contributions of boundary forces.
    */
   template <int dim, int spacedim = dim>
   void
   compute_load_vector(
     const DoFHandler<dim, spacedim>                       &dof_handler,
     const Mapping<dim, spacedim>                          &mapping,
+    const MatrixFree<dim, double>                         &matrix_free,
+    const std::vector<BoundaryFace<dim, spacedim>>        &boundary_faces,
     const std::vector<ForceContribution<dim, spacedim> *> &force_contributions,
     const double                                           time,
     const LinearAlgebra::distributed::Vector<double>      &current_position,
@@ -3,14 +3,20 @@
 
 #include <fiddle/base/config.h>
 
+#include <deal.II/base/array_view.h>
 #include <deal.II/base/subscriptor.h>
 #include <deal.II/base/symmetric_tensor.h>
 #include <deal.II/base/tensor.h>
+#include <deal.II/base/vectorization.h>
 
 #include <deal.II/fe/fe_values.h>
 
+#include <deal.II/grid/tria.h>
+
 #include <deal.II/lac/la_parallel_vector.h>
 
+#include <algorithm>
+#include <array>
 #include <vector>
 
 namespace fdl
@@ -98,7 +104,7 @@ namespace fdl
 
   // Manipulation routines for flags
 
-  inline MechanicsUpdateFlags
+  constexpr MechanicsUpdateFlags
   operator|(const MechanicsUpdateFlags f1, const MechanicsUpdateFlags f2)
   {
     return static_cast<MechanicsUpdateFlags>(static_cast<unsigned int>(f1) |
@@ -112,7 +118,7 @@ namespace fdl
     return f1;
   }
 
-  inline MechanicsUpdateFlags
+  constexpr MechanicsUpdateFlags
   operator&(const MechanicsUpdateFlags f1, const MechanicsUpdateFlags f2)
   {
     return static_cast<MechanicsUpdateFlags>(static_cast<unsigned int>(f1) &
@@ -160,6 +166,12 @@ namespace fdl
     const FEValuesBase<dim, spacedim> &
     get_fe_values() const;
 
+    /**
+     * Get the update flags, including all of their dependencies.
+     */
+    MechanicsUpdateFlags
+    get_update_flags() const;
+
     const std::vector<Tensor<2, spacedim>> &
     get_FF() const;
 
@@ -231,6 +243,157 @@ namespace fdl
     std::vector<double> scratch_velocity_values;
   };
 
+  /**
+   * Structure-of-arrays version of MechanicsValues which stores the values at
+   * a block of quadrature points in VectorizedArray lanes. This is the input
+   * to the batched functions in ForceContribution (e.g.,
+   * ForceContribution::compute_stress_batch()).
+   *
+   * The lanes are filled in one of two ways:
+   * <ol>
+   *   <li>With one cell per lane (e.g., when evaluating with FEEvaluation)
+   *   and one entry per quadrature point, in which case each entry contains
+   *   the values at one quadrature point on several cells.</li>
+   *   <li>With one quadrature point per lane by packing the values of a
+   *   MechanicsValues object, in which case every lane corresponds to the
+   *   same cell and the last entry is padded by repeating the last
+   *   quadrature point.</li>
+   * </ol>
+   * In both cases get_cell() returns the cell corresponding to a lane.
+   * Unfilled lanes (i.e., lanes with index at least n_filled_lanes()) contain
+   * copies of the first lane so that computing, e.g., the inverse of FF never
+   * divides by zero.
+   *
+   * Only dim == spacedim is supported when computing values from FF since,
+   * like MechanicsValues, the derived quantities are only defined in that
+   * case.
+   */
+  template <int dim, int spacedim = dim, typename Number = double>
+  class BatchedMechanicsValues
+  {
+  public:
+    using VectorizedArrayType = VectorizedArray<Number>;
+
+    using cell_iterator =
+      typename Triangulation<dim, spacedim>::active_cell_iterator;
+
+    /**
+     * Constructor. The dependencies of @p flags are resolved in the same way
+     * as they are in MechanicsValues. update_deformed_normal_vectors is not
+     * supported.
+     */
+    BatchedMechanicsValues(const MechanicsUpdateFlags flags);
+
+    /**
+     * Set up the values for a block of quadrature points from the deformation
+     * gradient, position, and velocity at each quadrature point and compute
+     * all other requested values. Arrays which are not required by the update
+     * flags may be empty.
+     *
+     * @p new_cells contains one cell per filled lane.
+     */
+    void
+    reinit(
+      const ArrayView<const cell_iterator> &new_cells,
+      const ArrayView<const Tensor<2, spacedim, VectorizedArrayType>> &new_FF,
+      const ArrayView<const Tensor<1, spacedim, VectorizedArrayType>>
+        &new_position_values,
+      const ArrayView<const Tensor<1, spacedim, VectorizedArrayType>>
+        &new_velocity_values);
+
+    /**
+     * Set up the values by packing the already computed values of
+     * @p me_values, which must have been reinitialized on @p cell, into
+     * lanes.
+     */
+    template <typename VectorType>
+    void
+    reinit(const cell_iterator                               &cell,
+           const MechanicsValues<dim, spacedim, VectorType> &me_values);
+
+    /**
+     * Number of entries in each array, i.e., number of quadrature points
+     * divided by the number of lanes.
+     */
+    unsigned int
+    n_entries() const;
+
+    unsigned int
+    n_filled_lanes() const;
+
+    const cell_iterator &
+    get_cell(const unsigned int lane) const;
+
+    MechanicsUpdateFlags
+    get_update_flags() const;
+
+    const std::vector<Tensor<2, spacedim, VectorizedArrayType>> &
+    get_FF() const;
+
+    const std::vector<Tensor<2, spacedim, VectorizedArrayType>> &
+    get_FF_inv_T() const;
+
+    const std::vector<VectorizedArrayType> &
+    get_det_FF() const;
+
+    const std::vector<VectorizedArrayType> &
+    get_n23_det_FF() const;
+
+    const std::vector<Tensor<1, spacedim, VectorizedArrayType>> &
+    get_position_values() const;
+
+    const std::vector<Tensor<1, spacedim, VectorizedArrayType>> &
+    get_velocity_values() const;
+
+    const std::vector<SymmetricTensor<2, spacedim, VectorizedArrayType>> &
+    get_right_cauchy_green() const;
+
+    const std::vector<VectorizedArrayType> &
+    get_first_invariant() const;
+
+    const std::vector<VectorizedArrayType> &
+    get_second_invariant() const;
+
+    const std::vector<VectorizedArrayType> &
+    get_third_invariant() const;
+
+  protected:
+    /**
+     * Resize all arrays required by the update flags.
+     */
+    void
+    resize(const unsigned int n_entries);
+
+    MechanicsUpdateFlags update_flags;
+
+    unsigned int n_entries_;
+
+    unsigned int n_filled_lanes_;
+
+    std::array<cell_iterator, VectorizedArrayType::size()> cells;
+
+    std::vector<Tensor<2, spacedim, VectorizedArrayType>> FF;
+
+    std::vector<Tensor<2, spacedim, VectorizedArrayType>> FF_inv_T;
+
+    std::vector<VectorizedArrayType> det_FF;
+
+    std::vector<VectorizedArrayType> n23_det_FF;
+
+    std::vector<Tensor<1, spacedim, VectorizedArrayType>> position_values;
+
+    std::vector<Tensor<1, spacedim, VectorizedArrayType>> velocity_values;
+
+    std::vector<SymmetricTensor<2, spacedim, VectorizedArrayType>>
+      right_cauchy_green;
+
+    std::vector<VectorizedArrayType> first_invariant;
+
+    std::vector<VectorizedArrayType> second_invariant;
+
+    std::vector<VectorizedArrayType> third_invariant;
+  };
+
   template <int dim, int spacedim, typename VectorType>
   inline const FEValuesBase<dim, spacedim> &
   MechanicsValues<dim, spacedim, VectorType>::get_fe_values() const
@@ -238,6 +401,13 @@ namespace fdl
     return *fe_values;
   }
 
+  template <int dim, int spacedim, typename VectorType>
+  inline MechanicsUpdateFlags
+  MechanicsValues<dim, spacedim, VectorType>::get_update_flags() const
+  {
+    return update_flags;
+  }
+
   // Access functions
 
   template <int dim, int spacedim, typename VectorType>
@@ -336,6 +506,185 @@ namespace fdl
            ExcMessage("Needs update_third_invariant"));
     return third_invariant;
   }
+
+  template <int dim, int spacedim, typename Number>
+  template <typename VectorType>
+  void
+  BatchedMechanicsValues<dim, spacedim, Number>::reinit(
+    const cell_iterator                               &cell,
+    const MechanicsValues<dim, spacedim, VectorType> &me_values)
+  {
+    Assert((me_values.get_update_flags() & update_flags) == update_flags,
+           ExcMessage("The MechanicsValues object must compute (at least) "
+                      "all values required by this object."));
+    constexpr unsigned int n_lanes = VectorizedArrayType::size();
+    const unsigned int     n_q_points =
+      me_values.get_fe_values().n_quadrature_points;
+    resize((n_q_points + n_lanes - 1) / n_lanes);
+    n_filled_lanes_ = n_lanes;
+    std::fill(cells.begin(), cells.end(), cell);
+
+    for (unsigned int entry_n = 0; entry_n < n_entries_; ++entry_n)
+      for (unsigned int lane = 0; lane < n_lanes; ++lane)
+        {
+          const unsigned int qp_n =
+            std::min(entry_n * n_lanes + lane, n_q_points - 1);
+          for (unsigned int i = 0; i < spacedim; ++i)
+            {
+              for (unsigned int j = 0; j < spacedim; ++j)
+                {
+                  if (update_flags & update_FF)
+                    FF[entry_n][i][j][lane] = me_values.get_FF()[qp_n][i][j];
+                  if (update_flags & update_FF_inv_T)
+                    FF_inv_T[entry_n][i][j][lane] =
+                      me_values.get_FF_inv_T()[qp_n][i][j];
+                  if ((update_flags & update_right_cauchy_green) && j >= i)
+                    right_cauchy_green[entry_n][i][j][lane] =
+                      me_values.get_right_cauchy_green()[qp_n][i][j];
+                }
+              if (update_flags & update_position_values)
+                position_values[entry_n][i][lane] =
+                  me_values.get_position_values()[qp_n][i];
+              if (update_flags & update_velocity_values)
+                velocity_values[entry_n][i][lane] =
+                  me_values.get_velocity_values()[qp_n][i];
+            }
+          if (update_flags & update_det_FF)
+            det_FF[entry_n][lane] = me_values.get_det_FF()[qp_n];
+          if (update_flags & update_n23_det_FF)
+            n23_det_FF[entry_n][lane] = me_values.get_n23_det_FF()[qp_n];
+          if (update_flags & update_first_invariant)
+            first_invariant[entry_n][lane] =
+              me_values.get_first_invariant()[qp_n];
+          if (update_flags & update_second_invariant)
+            second_invariant[entry_n][lane] =
+              me_values.get_second_invariant()[qp_n];
+          if (update_flags & update_third_invariant)
+            third_invariant[entry_n][lane] =
+              me_values.get_third_invariant()[qp_n];
+        }
+  }
+
+  // Access functions
+
+  template <int dim, int spacedim, typename Number>
+  inline unsigned int
+  BatchedMechanicsValues<dim, spacedim, Number>::n_entries() const
+  {
+    return n_entries_;
+  }
+
+  template <int dim, int spacedim, typename Number>
+  inline unsigned int
+  BatchedMechanicsValues<dim, spacedim, Number>::n_filled_lanes() const
+  {
+    return n_filled_lanes_;
+  }
+
+  template <int dim, int spacedim, typename Number>
+  inline const typename BatchedMechanicsValues<dim, spacedim, Number>::
+    cell_iterator &
+    BatchedMechanicsValues<dim, spacedim, Number>::get_cell(
+      const unsigned int lane) const
+  {
+    AssertIndexRange(lane, n_filled_lanes_);
+    return cells[lane];
+  }
+
+  template <int dim, int spacedim, typename Number>
+  inline MechanicsUpdateFlags
+  BatchedMechanicsValues<dim, spacedim, Number>::get_update_flags() const
+  {
+    return update_flags;
+  }
+
+  template <int dim, int spacedim, typename Number>
+  inline const std::vector<Tensor<2, spacedim, VectorizedArray<Number>>> &
+  BatchedMechanicsValues<dim, spacedim, Number>::get_FF() const
+  {
+    Assert(update_flags & update_FF, ExcMessage("Needs update_FF"));
+    return FF;
+  }
+
+  template <int dim, int spacedim, typename Number>
+  inline const std::vector<Tensor<2, spacedim, VectorizedArray<Number>>> &
+  BatchedMechanicsValues<dim, spacedim, Number>::get_FF_inv_T() const
+  {
+    Assert(update_flags & update_FF_inv_T, ExcMessage("Needs update_FF_inv_T"));
+    return FF_inv_T;
+  }
+
+  template <int dim, int spacedim, typename Number>
+  inline const std::vector<VectorizedArray<Number>> &
+  BatchedMechanicsValues<dim, spacedim, Number>::get_det_FF() const
+  {
+    Assert(update_flags & update_det_FF, ExcMessage("Needs update_det_FF"));
+    return det_FF;
+  }
+
+  template <int dim, int spacedim, typename Number>
+  inline const std::vector<VectorizedArray<Number>> &
+  BatchedMechanicsValues<dim, spacedim, Number>::get_n23_det_FF() const
+  {
+    Assert(update_flags & update_n23_det_FF,
+           ExcMessage("Needs update_n23_det_FF"));
+    return n23_det_FF;
+  }
+
+  template <int dim, int spacedim, typename Number>
+  inline const std::vector<Tensor<1, spacedim, VectorizedArray<Number>>> &
+  BatchedMechanicsValues<dim, spacedim, Number>::get_position_values() const
+  {
+    Assert(update_flags & update_position_values,
+           ExcMessage("Needs update_position_values"));
+    return position_values;
+  }
+
+  template <int dim, int spacedim, typename Number>
+  inline const std::vector<Tensor<1, spacedim, VectorizedArray<Number>>> &
+  BatchedMechanicsValues<dim, spacedim, Number>::get_velocity_values() const
+  {
+    Assert(update_flags & update_velocity_values,
+           ExcMessage("Needs update_velocity_values"));
+    return velocity_values;
+  }
+
+  template <int dim, int spacedim, typename Number>
+  inline const std::vector<
+    SymmetricTensor<2, spacedim, VectorizedArray<Number>>> &
+  BatchedMechanicsValues<dim, spacedim, Number>::get_right_cauchy_green() const
+  {
+    Assert(update_flags & update_right_cauchy_green,
+           ExcMessage("Needs update_right_cauchy_green"));
+    return right_cauchy_green;
+  }
+
+  template <int dim, int spacedim, typename Number>
+  inline const std::vector<VectorizedArray<Number>> &
+  BatchedMechanicsValues<dim, spacedim, Number>::get_first_invariant() const
+  {
+    Assert(update_flags & update_first_invariant,
+           ExcMessage("Needs update_first_invariant"));
+    return first_invariant;
+  }
+
+  template <int dim, int spacedim, typename Number>
+  inline const std::vector<VectorizedArray<Number>> &
+  BatchedMechanicsValues<dim, spacedim, Number>::get_second_invariant() const
+  {
+    Assert(update_flags & update_second_invariant,
+           ExcMessage("Needs update_second_invariant"));
+    return second_invariant;
+  }
+
+  template <int dim, int spacedim, typename Number>
+  inline const std::vector<VectorizedArray<Number>> &
+  BatchedMechanicsValues<dim, spacedim, Number>::get_third_invariant() const
+  {
+    Assert(update_flags & update_third_invariant,
+           ExcMessage("Needs update_third_invariant"));
+    return third_invariant;
+  }
 } // namespace fdl
 
 #endif
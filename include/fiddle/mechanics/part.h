@@ -6,6 +6,7 @@
 #include <fiddle/base/exceptions.h>
 
 #include <fiddle/mechanics/force_contribution.h>
+#include <fiddle/mechanics/mechanics_utilities.h>
 #include <fiddle/mechanics/mechanics_values.h>
 
 #include <deal.II/base/bounding_box.h>
@@ -128,7 +129,9 @@ namespace fdl
      * Add another force contribution.
      *
      * Typically, force contributions should be set by the constructor, but it
-     * is sometimes necessary to add additional forces later on.
+     * is sometimes necessary to add additional forces later on. If @p force
+     * uses a cell quadrature not already known to the MatrixFree object then
+     * that object (and the mass operator) is set up again.
      */
     void
     add_force_contribution(
@@ -141,6 +144,14 @@ namespace fdl
     const DoFHandler<dim, spacedim> &
     get_dof_handler() const;
 
+    /**
+     * Get the locally owned faces on the physical boundary of the part, sorted
+     * by boundary id. Useful for computing boundary forces (see
+     * compute_load_vector()).
+     */
+    const std::vector<BoundaryFace<dim, spacedim>> &
+    get_boundary_faces() const;
+
     /**
      * Get the shared vector partitioner for the position, velocity, and force.
      * Useful if users want to set up their own vectors and re-use the parallel
@@ -152,6 +163,11 @@ namespace fdl
     /**
      * Get the MatrixFree object used to set up the matrix-free operators.
      * Useful if a second FE solver also needs to do matrix-free calculations.
+     *
+     * Quadrature index 0 is get_quadrature(). The remaining quadrature
+     * indices are the distinct cell quadratures of the stresses and volume
+     * forces, so that compute_load_vector() can evaluate those forces with
+     * FEEvaluation.
      */
     std::shared_ptr<const MatrixFree<dim, double>>
     get_matrix_free() const;
@@ -224,6 +240,14 @@ namespace fdl
     void
     serialize(Archive &ar, const unsigned int version);
 
+    /**
+     * Set up (or set up again) matrix_free with quadrature and the cell
+     * quadratures of the force contributions, as well as the mass operator
+     * if it already exists.
+     */
+    void
+    reinit_matrix_free();
+
     /**
      * Triangulation of the part.
      */
@@ -254,6 +278,12 @@ namespace fdl
      */
     std::shared_ptr<const Utilities::MPI::Partitioner> partitioner;
 
+    /**
+     * Locally owned faces on the physical boundary, computed by
+     * make_boundary_faces().
+     */
+    std::vector<BoundaryFace<dim, spacedim>> boundary_faces;
+
     // Quadrature used for the position, velocity, and force.
     Quadrature<dim> quadrature;
 
@@ -263,6 +293,9 @@ namespace fdl
     // MatrixFree object.
     std::shared_ptr<MatrixFree<dim, double>> matrix_free;
 
+    // Quadratures used to set up matrix_free, indexed by quadrature index.
+    std::vector<Quadrature<dim>> matrix_free_quadratures;
+
     // Mass operator. Used for L2 projections.
     std::unique_ptr<MatrixFreeOperators::Base<dim>> mass_operator;
 
@@ -307,6 +340,13 @@ namespace fdl
     return *dof_handler;
   }
 
+  template <int dim, int spacedim>
+  const std::vector<BoundaryFace<dim, spacedim>> &
+  Part<dim, spacedim>::get_boundary_faces() const
+  {
+    return boundary_faces;
+  }
+
   template <int dim, int spacedim>
   std::shared_ptr<const Utilities::MPI::Partitioner>
   Part<dim, spacedim>::get_partitioner() const
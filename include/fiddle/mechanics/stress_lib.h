@@ -0,0 +1,640 @@
+#ifndef included_fiddle_mechanics_stress_lib_h
+#define included_fiddle_mechanics_stress_lib_h
+
+#include <fiddle/base/config.h>
+
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/mechanics/force_contribution.h>
+#include <fiddle/mechanics/mechanics_values.h>
+
+#include <deal.II/base/quadrature.h>
+#include <deal.II/base/tensor.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/grid/tria.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <initializer_list>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace fdl
+{
+  using namespace dealii;
+
+  /**
+   * Hyperelastic stress laws which can be combined at compile time by
+   * HyperelasticStress.
+   *
+   * Each law is a small class with two members:
+   * <ol>
+   *   <li>A static constexpr function get_mechanics_update_flags() returning
+   *   exactly the MechanicsUpdateFlags required by the law.</li>
+   *   <li>A function template add_stress() which adds the PK1 stress at one
+   *   quadrature point to its last argument. The first argument is either a
+   *   MechanicsValues or a BatchedMechanicsValues object and the scalar type
+   *   of the stress (i.e., double or VectorizedArray<double>) matches.</li>
+   * </ol>
+   * User-defined laws following the same pattern may also be used with
+   * HyperelasticStress.
+   *
+   * Like MechanicsValues, in 2D all laws correspond to the 3D law with a unit
+   * out-of-plane stretch: e.g., the first invariant is tr(C) + 1. All laws
+   * are only valid when dim == spacedim.
+   */
+  namespace StressLaws
+  {
+    /**
+     * Modified neo-Hookean law
+     *
+     * W = mu / 2 (I1_bar - 3)
+     *
+     * in which I1_bar = J^{-2/3} I1.
+     */
+    template <int spacedim>
+    class NeoHookean
+    {
+    public:
+      NeoHookean(const double shear_modulus)
+        : shear_modulus(shear_modulus)
+      {}
+
+      static constexpr MechanicsUpdateFlags
+      get_mechanics_update_flags()
+      {
+        return update_FF | update_FF_inv_T | update_n23_det_FF |
+               update_first_invariant;
+      }
+
+      template <typename MechanicsValuesType, typename Number>
+      void
+      add_stress(const MechanicsValuesType    &me_values,
+                 const unsigned int            qp_n,
+                 Tensor<2, spacedim, Number> &stress) const
+      {
+        const Number &n23_J    = me_values.get_n23_det_FF()[qp_n];
+        const Number &I1       = me_values.get_first_invariant()[qp_n];
+        const auto   &FF       = me_values.get_FF()[qp_n];
+        const auto   &FF_inv_T = me_values.get_FF_inv_T()[qp_n];
+        stress += (shear_modulus * n23_J) * (FF - (I1 / 3.0) * FF_inv_T);
+      }
+
+    private:
+      double shear_modulus;
+    };
+
+    /**
+     * Modified Mooney-Rivlin law
+     *
+     * W = c1 (I1_bar - 3) + c2 (I2_bar - 3)
+     *
+     * in which I1_bar = J^{-2/3} I1 and I2_bar = J^{-4/3} I2.
+     */
+    template <int spacedim>
+    class MooneyRivlin
+    {
+    public:
+      MooneyRivlin(const double c1, const double c2)
+        : c1(c1)
+        , c2(c2)
+      {}
+
+      static constexpr MechanicsUpdateFlags
+      get_mechanics_update_flags()
+      {
+        return update_FF | update_FF_inv_T | update_n23_det_FF |
+               update_first_invariant | update_second_invariant;
+      }
+
+      template <typename MechanicsValuesType, typename Number>
+      void
+      add_stress(const MechanicsValuesType    &me_values,
+                 const unsigned int            qp_n,
+                 Tensor<2, spacedim, Number> &stress) const
+      {
+        const Number &n23_J    = me_values.get_n23_det_FF()[qp_n];
+        const Number &I1       = me_values.get_first_invariant()[qp_n];
+        const Number &I2       = me_values.get_second_invariant()[qp_n];
+        const auto   &FF       = me_values.get_FF()[qp_n];
+        const auto   &FF_inv_T = me_values.get_FF_inv_T()[qp_n];
+        // d(I2)/d(FF) = 2 (I1 FF - FF C)
+        const Tensor<2, spacedim, Number> FF_CC = FF * (transpose(FF) * FF);
+        stress += (2.0 * c1 * n23_J) * (FF - (I1 / 3.0) * FF_inv_T);
+        stress += (2.0 * c2 * n23_J * n23_J) *
+                  (I1 * FF - FF_CC - (2.0 / 3.0 * I2) * FF_inv_T);
+      }
+
+    private:
+      double c1;
+
+      double c2;
+    };
+
+    /**
+     * The Holzapfel-Ogden law for myocardium
+     *
+     * W = a / (2 b) (exp(b (I1_bar - 3)) - 1)
+     *   + a_f / (2 b_f) (exp(b_f (I4f - 1)_+^2) - 1)
+     *   + a_s / (2 b_s) (exp(b_s (I4s - 1)_+^2) - 1)
+     *   + a_fs / (2 b_fs) (exp(b_fs I8fs^2) - 1)
+     *
+     * in which I4f = f0 . C f0, I4s = s0 . C s0, I8fs = f0 . C s0, and
+     * (x)_+ = max(x, 0) so that the fibers and sheets only resist extension.
+     * The fiber and sheet directions f0 and s0 are the same at every
+     * quadrature point.
+     */
+    template <int spacedim>
+    class HolzapfelOgden
+    {
+    public:
+      /**
+       * Constructor. The material parameters are, in order, a, b, a_f, b_f,
+       * a_s, b_s, a_fs, and b_fs. @p fiber_direction and @p sheet_direction
+       * should be orthonormal.
+       */
+      HolzapfelOgden(const std::array<double, 8> &parameters,
+                     const Tensor<1, spacedim>   &fiber_direction,
+                     const Tensor<1, spacedim>   &sheet_direction)
+        : parameters(parameters)
+        , fiber_direction(fiber_direction)
+        , sheet_direction(sheet_direction)
+      {
+        for (unsigned int i = 1; i < parameters.size(); i += 2)
+          AssertThrow(parameters[i] > 0.0,
+                      ExcMessage("The exponential coefficients must be "
+                                 "positive."));
+      }
+
+      static constexpr MechanicsUpdateFlags
+      get_mechanics_update_flags()
+      {
+        return update_FF | update_FF_inv_T | update_n23_det_FF |
+               update_first_invariant;
+      }
+
+      template <typename MechanicsValuesType, typename Number>
+      void
+      add_stress(const MechanicsValuesType    &me_values,
+                 const unsigned int            qp_n,
+                 Tensor<2, spacedim, Number> &stress) const
+      {
+        const double a = parameters[0], b = parameters[1];
+        const double a_f = parameters[2], b_f = parameters[3];
+        const double a_s = parameters[4], b_s = parameters[5];
+        const double a_fs = parameters[6], b_fs = parameters[7];
+
+        const Number &n23_J    = me_values.get_n23_det_FF()[qp_n];
+        const Number &I1       = me_values.get_first_invariant()[qp_n];
+        const auto   &FF       = me_values.get_FF()[qp_n];
+        const auto   &FF_inv_T = me_values.get_FF_inv_T()[qp_n];
+
+        stress += (a * std::exp(b * (n23_J * I1 - 3.0)) * n23_J) *
+                  (FF - (I1 / 3.0) * FF_inv_T);
+
+        Tensor<1, spacedim, Number> FF_f, FF_s;
+        for (unsigned int i = 0; i < spacedim; ++i)
+          for (unsigned int j = 0; j < spacedim; ++j)
+            {
+              FF_f[i] += FF[i][j] * fiber_direction[j];
+              FF_s[i] += FF[i][j] * sheet_direction[j];
+            }
+        const Number zero = 0.0;
+        const Number E4f  = std::max(FF_f * FF_f - 1.0, zero);
+        const Number E4s  = std::max(FF_s * FF_s - 1.0, zero);
+        const Number I8fs = FF_f * FF_s;
+        const Number c_f  = 2.0 * a_f * E4f * std::exp(b_f * E4f * E4f);
+        const Number c_s  = 2.0 * a_s * E4s * std::exp(b_s * E4s * E4s);
+        const Number c_fs = a_fs * I8fs * std::exp(b_fs * I8fs * I8fs);
+        for (unsigned int i = 0; i < spacedim; ++i)
+          for (unsigned int j = 0; j < spacedim; ++j)
+            stress[i][j] += c_f * FF_f[i] * fiber_direction[j] +
+                            c_s * FF_s[i] * sheet_direction[j] +
+                            c_fs * (FF_f[i] * sheet_direction[j] +
+                                    FF_s[i] * fiber_direction[j]);
+      }
+
+    private:
+      std::array<double, 8> parameters;
+
+      Tensor<1, spacedim> fiber_direction;
+
+      Tensor<1, spacedim> sheet_direction;
+    };
+
+    /**
+     * The Guccione law for myocardium
+     *
+     * W = C / 2 (exp(Q) - 1)
+     *
+     * in which, with E = 1/2 (C - I) written in the fiber (f), sheet (s), and
+     * sheet-normal (n) basis,
+     *
+     * Q = b_f E_ff^2 + b_t (E_ss^2 + E_nn^2 + 2 E_sn^2)
+     *   + 2 b_fs (E_fs^2 + E_fn^2).
+     *
+     * The fiber and sheet directions are the same at every quadrature point.
+     * In 2D the sheet-normal direction is the out-of-plane direction, on
+     * which E vanishes.
+     */
+    template <int spacedim>
+    class Guccione
+    {
+    public:
+      /**
+       * Constructor. @p fiber_direction and @p sheet_direction should be
+       * orthonormal.
+       */
+      Guccione(const double               C,
+               const double               b_f,
+               const double               b_t,
+               const double               b_fs,
+               const Tensor<1, spacedim> &fiber_direction,
+               const Tensor<1, spacedim> &sheet_direction)
+        : C(C)
+      {
+        basis[0] = fiber_direction;
+        basis[1] = sheet_direction;
+        // cross_product_3d() is only defined in 3D so compute it manually
+        if (spacedim == 3)
+          for (unsigned int i = 0; i < spacedim; ++i)
+            {
+              const unsigned int j = (i + 1) % 3;
+              const unsigned int k = (i + 2) % 3;
+              basis[spacedim - 1][i] = fiber_direction[j] * sheet_direction[k] -
+                                       fiber_direction[k] * sheet_direction[j];
+            }
+        for (unsigned int a = 0; a < spacedim; ++a)
+          for (unsigned int b = 0; b < spacedim; ++b)
+            weights[a][b] = (a == 0 && b == 0) ? b_f :
+                            (a == 0 || b == 0) ? b_fs :
+                                                 b_t;
+      }
+
+      static constexpr MechanicsUpdateFlags
+      get_mechanics_update_flags()
+      {
+        return update_FF;
+      }
+
+      template <typename MechanicsValuesType, typename Number>
+      void
+      add_stress(const MechanicsValuesType    &me_values,
+                 const unsigned int            qp_n,
+                 Tensor<2, spacedim, Number> &stress) const
+      {
+        const auto                 &FF = me_values.get_FF()[qp_n];
+        Tensor<2, spacedim, Number> EE = 0.5 * (transpose(FF) * FF);
+        for (unsigned int i = 0; i < spacedim; ++i)
+          EE[i][i] -= 0.5;
+
+        // Transform to the local basis, compute S = dW/dE there, and
+        // transform back:
+        Tensor<2, spacedim, Number> local_EE;
+        Number                      Q = 0.0;
+        for (unsigned int a = 0; a < spacedim; ++a)
+          for (unsigned int b = 0; b < spacedim; ++b)
+            {
+              for (unsigned int i = 0; i < spacedim; ++i)
+                for (unsigned int j = 0; j < spacedim; ++j)
+                  local_EE[a][b] += basis[a][i] * EE[i][j] * basis[b][j];
+              Q += weights[a][b] * local_EE[a][b] * local_EE[a][b];
+            }
+        const Number                scale = C * std::exp(Q);
+        Tensor<2, spacedim, Number> SS;
+        for (unsigned int a = 0; a < spacedim; ++a)
+          for (unsigned int b = 0; b < spacedim; ++b)
+            {
+              const Number local_SS = scale * weights[a][b] * local_EE[a][b];
+              for (unsigned int i = 0; i < spacedim; ++i)
+                for (unsigned int j = 0; j < spacedim; ++j)
+                  SS[i][j] += local_SS * basis[a][i] * basis[b][j];
+            }
+        stress += FF * SS;
+      }
+
+    private:
+      double C;
+
+      std::array<Tensor<1, spacedim>, spacedim> basis;
+
+      Tensor<2, spacedim> weights;
+    };
+
+    /**
+     * Volumetric penalty U(J) = kappa / 2 (J - 1)^2.
+     */
+    template <int spacedim>
+    class QuadraticVolumetricPenalty
+    {
+    public:
+      QuadraticVolumetricPenalty(const double bulk_modulus)
+        : bulk_modulus(bulk_modulus)
+      {}
+
+      static constexpr MechanicsUpdateFlags
+      get_mechanics_update_flags()
+      {
+        return update_det_FF | update_FF_inv_T;
+      }
+
+      template <typename MechanicsValuesType, typename Number>
+      void
+      add_stress(const MechanicsValuesType    &me_values,
+                 const unsigned int            qp_n,
+                 Tensor<2, spacedim, Number> &stress) const
+      {
+        // PP = U'(J) J FF^{-T}
+        const Number &J = me_values.get_det_FF()[qp_n];
+        stress += (bulk_modulus * (J - 1.0) * J) *
+                  me_values.get_FF_inv_T()[qp_n];
+      }
+
+    private:
+      double bulk_modulus;
+    };
+
+    /**
+     * Volumetric penalty U(J) = kappa / 2 log(J)^2.
+     */
+    template <int spacedim>
+    class LogSquaredVolumetricPenalty
+    {
+    public:
+      LogSquaredVolumetricPenalty(const double bulk_modulus)
+        : bulk_modulus(bulk_modulus)
+      {}
+
+      static constexpr MechanicsUpdateFlags
+      get_mechanics_update_flags()
+      {
+        return update_det_FF | update_FF_inv_T;
+      }
+
+      template <typename MechanicsValuesType, typename Number>
+      void
+      add_stress(const MechanicsValuesType    &me_values,
+                 const unsigned int            qp_n,
+                 Tensor<2, spacedim, Number> &stress) const
+      {
+        const Number &J = me_values.get_det_FF()[qp_n];
+        stress += (bulk_modulus * std::log(J)) * me_values.get_FF_inv_T()[qp_n];
+      }
+
+    private:
+      double bulk_modulus;
+    };
+
+    /**
+     * Volumetric penalty U(J) = kappa / 4 (J^2 - 1 - 2 log(J)) (i.e., the one
+     * proposed by Simo and Taylor).
+     */
+    template <int spacedim>
+    class SimoTaylorVolumetricPenalty
+    {
+    public:
+      SimoTaylorVolumetricPenalty(const double bulk_modulus)
+        : bulk_modulus(bulk_modulus)
+      {}
+
+      static constexpr MechanicsUpdateFlags
+      get_mechanics_update_flags()
+      {
+        return update_det_FF | update_FF_inv_T;
+      }
+
+      template <typename MechanicsValuesType, typename Number>
+      void
+      add_stress(const MechanicsValuesType    &me_values,
+                 const unsigned int            qp_n,
+                 Tensor<2, spacedim, Number> &stress) const
+      {
+        const Number &J = me_values.get_det_FF()[qp_n];
+        stress += (0.5 * bulk_modulus * (J * J - 1.0)) *
+                  me_values.get_FF_inv_T()[qp_n];
+      }
+
+    private:
+      double bulk_modulus;
+    };
+
+    /**
+     * Volumetric penalty U(J) = kappa (J log(J) - J + 1).
+     */
+    template <int spacedim>
+    class JLogJVolumetricPenalty
+    {
+    public:
+      JLogJVolumetricPenalty(const double bulk_modulus)
+        : bulk_modulus(bulk_modulus)
+      {}
+
+      static constexpr MechanicsUpdateFlags
+      get_mechanics_update_flags()
+      {
+        return update_det_FF | update_FF_inv_T;
+      }
+
+      template <typename MechanicsValuesType, typename Number>
+      void
+      add_stress(const MechanicsValuesType    &me_values,
+                 const unsigned int            qp_n,
+                 Tensor<2, spacedim, Number> &stress) const
+      {
+        const Number &J = me_values.get_det_FF()[qp_n];
+        stress += (bulk_modulus * J * std::log(J)) *
+                  me_values.get_FF_inv_T()[qp_n];
+      }
+
+    private:
+      double bulk_modulus;
+    };
+  } // namespace StressLaws
+
+  /**
+   * Stress given by the sum of several laws from StressLaws (or user-defined
+   * laws following the same pattern). Since the laws are template arguments
+   * the sum is evaluated in a single loop over quadrature points without any
+   * virtual function calls or temporary arrays, and this class requests
+   * exactly the union of the MechanicsUpdateFlags required by the laws.
+   *
+   * This class supports batched evaluation. It is usually easiest to create
+   * with make_hyperelastic_stress().
+   */
+  template <int dim, int spacedim, typename... Laws>
+  class HyperelasticStress : public ForceContribution<dim, spacedim>
+  {
+  public:
+    /**
+     * Constructor. If @p material_ids is not empty then the stress is only
+     * applied on cells with those material ids.
+     */
+    HyperelasticStress(const Quadrature<dim>                 &quad,
+                       const std::vector<types::material_id> &material_ids,
+                       const Laws &...laws)
+      : ForceContribution<dim, spacedim>(quad)
+      , material_ids(material_ids)
+      , laws(laws...)
+    {
+      static_assert(dim == spacedim, "Only implemented for dim == spacedim");
+    }
+
+    static constexpr MechanicsUpdateFlags
+    get_law_update_flags()
+    {
+      MechanicsUpdateFlags flags = update_nothing;
+      for (const MechanicsUpdateFlags law_flags :
+           {update_nothing, Laws::get_mechanics_update_flags()...})
+        flags = flags | law_flags;
+      return flags;
+    }
+
+    virtual MechanicsUpdateFlags
+    get_mechanics_update_flags() const override
+    {
+      return get_law_update_flags();
+    }
+
+    virtual bool
+    is_stress() const override
+    {
+      return true;
+    }
+
+    virtual bool
+    supports_batched_evaluation() const override
+    {
+      return true;
+    }
+
+    virtual void
+    compute_stress(
+      const double /*time*/,
+      const MechanicsValues<dim, spacedim> &me_values,
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      ArrayView<Tensor<2, spacedim>> &stresses) const override
+    {
+      if (!applies_to(cell))
+        {
+          std::fill(stresses.begin(), stresses.end(), Tensor<2, spacedim>());
+          return;
+        }
+
+      for (unsigned int qp_n = 0; qp_n < stresses.size(); ++qp_n)
+        {
+          Tensor<2, spacedim> stress;
+          add_stress(me_values,
+                     qp_n,
+                     stress,
+                     std::index_sequence_for<Laws...>());
+          stresses[qp_n] = stress;
+        }
+    }
+
+    virtual void
+    compute_stress_batch(
+      const double /*time*/,
+      const BatchedMechanicsValues<dim, spacedim>             &me_values,
+      ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &stresses)
+      const override
+    {
+      // Each lane may correspond to a different cell
+      VectorizedArray<double> mask       = 0.0;
+      unsigned int            n_selected = 0;
+      for (unsigned int lane = 0; lane < me_values.n_filled_lanes(); ++lane)
+        if (applies_to(me_values.get_cell(lane)))
+          {
+            mask[lane] = 1.0;
+            ++n_selected;
+          }
+      if (n_selected == 0)
+        return;
+
+      const VectorizedArray<double> one  = 1.0;
+      const VectorizedArray<double> zero = 0.0;
+      for (unsigned int qp_n = 0; qp_n < stresses.size(); ++qp_n)
+        {
+          Tensor<2, spacedim, VectorizedArray<double>> stress;
+          add_stress(me_values,
+                     qp_n,
+                     stress,
+                     std::index_sequence_for<Laws...>());
+          // Values in unfilled lanes are never used.
+          if (n_selected == me_values.n_filled_lanes())
+            {
+              stresses[qp_n] += stress;
+              continue;
+            }
+          // The laws may compute inf or NaN on lanes of cells they do not
+          // apply to (e.g., log(J) with J <= 0), so select values instead of
+          // multiplying by the mask.
+          for (unsigned int i = 0; i < spacedim; ++i)
+            for (unsigned int j = 0; j < spacedim; ++j)
+              stresses[qp_n][i][j] +=
+                compare_and_apply_mask<SIMDComparison::equal>(mask,
+                                                              one,
+                                                              stress[i][j],
+                                                              zero);
+        }
+    }
+
+  protected:
+    bool
+    applies_to(const typename Triangulation<dim, spacedim>::active_cell_iterator
+                 &cell) const
+    {
+      return material_ids.size() == 0 ||
+             std::find(material_ids.begin(),
+                       material_ids.end(),
+                       cell->material_id()) != material_ids.end();
+    }
+
+    template <typename MechanicsValuesType,
+              typename Number,
+              std::size_t... law_indices>
+    void
+    add_stress(const MechanicsValuesType    &me_values,
+               const unsigned int            qp_n,
+               Tensor<2, spacedim, Number> &stress,
+               std::index_sequence<law_indices...>) const
+    {
+      (void)me_values;
+      (void)qp_n;
+      (void)stress;
+      (void)std::initializer_list<int>{
+        (std::get<law_indices>(laws).add_stress(me_values, qp_n, stress),
+         0)...};
+    }
+
+    std::vector<types::material_id> material_ids;
+
+    std::tuple<Laws...> laws;
+  };
+
+  /**
+   * Create a HyperelasticStress object from a set of laws, e.g.,
+   *
+   * @code
+   * auto stress = make_hyperelastic_stress<2>(
+   *   quadrature,
+   *   {},
+   *   StressLaws::NeoHookean<2>(mu),
+   *   StressLaws::LogSquaredVolumetricPenalty<2>(kappa));
+   * @endcode
+   */
+  template <int dim, int spacedim = dim, typename... Laws>
+  std::unique_ptr<HyperelasticStress<dim, spacedim, Laws...>>
+  make_hyperelastic_stress(const Quadrature<dim>                 &quad,
+                           const std::vector<types::material_id> &material_ids,
+                           const Laws &...laws)
+  {
+    return std::make_unique<HyperelasticStress<dim, spacedim, Laws...>>(
+      quad, material_ids, laws...);
+  }
+} // namespace fdl
+
+#endif
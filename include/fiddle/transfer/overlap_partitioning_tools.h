@@ -21,7 +21,9 @@ namespace fdl
    * overlap dofs are the array indices and the native dofs are the values.
    *
    * @note This function is collective over the communicator used by @p
-   * native_dof_handler.
+   * native_dof_handler, but only communicates if the native triangulation has
+   * artificial cells (since, otherwise, every processor already knows the
+   * DoFs on every cell).
    */
   template <int dim, int spacedim = dim>
   std::vector<types::global_dof_index>
@@ -4,12 +4,16 @@
 #include <fiddle/base/config.h>
 
 #include <deal.II/base/index_set.h>
+#include <deal.II/base/partitioner.h>
 
 #include <deal.II/lac/la_parallel_vector.h>
 #include <deal.II/lac/vector.h>
 
 #include <mpi.h>
 
+#include <memory>
+#include <vector>
+
 namespace fdl
 {
   using namespace dealii;
@@ -24,6 +28,18 @@ namespace fdl
    * at a time: i.e., after each start the corresponding finish function must be
    * called.
    *
+   * The translation from overlap indices to local indices of native vectors is
+   * computed once by the constructor. Entries of the overlap vector which are
+   * locally owned are read from (or written to) the native vector directly -
+   * only ghost entries are communicated.
+   *
+   * Communication uses persistent MPI requests (i.e., MPI_Send_init() and
+   * MPI_Recv_init()), which are created the first time a given combination of
+   * direction, channel, and number of vectors is used and are reused by
+   * subsequent scatters. Hence Scatter objects should be kept around (e.g., as
+   * InteractionBase does) until the communication pattern changes. For this
+   * reason Scatter objects can be moved but not copied.
+   *
    * @todo Add a constructor taking a dealii::MPI::Partitioner object to share
    * communication data between instances.
    */
@@ -36,6 +52,17 @@ namespace fdl
      */
     Scatter() = default;
 
+    /**
+     * Move constructor.
+     */
+    Scatter(Scatter<T> &&) = default;
+
+    /**
+     * Move assignment.
+     */
+    Scatter<T> &
+    operator=(Scatter<T> &&) = default;
+
     /**
      * Constructor.
      */
@@ -71,11 +98,16 @@ namespace fdl
      * data layout matches the overlap indices provided to the constructor. No
      * ghost data is read from @p input (instead, a temporary array does a ghost
      * update).
+     *
+     * If @p reduced_precision is <code>true</code> then values are sent to
+     * other processes as floats, which halves the amount of communicated data
+     * when T is double. Locally owned values are always copied exactly.
      */
     void
     global_to_overlap_start(const LinearAlgebra::distributed::Vector<T> &input,
                             const unsigned int channel,
-                            Vector<T> &        output);
+                            Vector<T> &        output,
+                            const bool         reduced_precision = false);
 
     /**
      * Finish the global to overlap scatter.
@@ -84,10 +116,140 @@ namespace fdl
     global_to_overlap_finish(const LinearAlgebra::distributed::Vector<T> &input,
                              Vector<T> &output);
 
+    /**
+     * Like the single vector version, but scatter several vectors at once.
+     * Values from all vectors are packed together so that only one message is
+     * sent to each neighboring process, regardless of the number of vectors.
+     *
+     * All vectors in @p inputs must have the same layout as the index set
+     * provided to the constructor and all vectors in @p outputs must be indexed
+     * by the overlap dofs.
+     */
+    void
+    global_to_overlap_start(
+      const std::vector<const LinearAlgebra::distributed::Vector<T> *> &inputs,
+      const unsigned int                                                channel,
+      const std::vector<Vector<T> *> &outputs,
+      const bool                      reduced_precision = false);
+
+    /**
+     * Finish the global to overlap scatter of several vectors.
+     */
+    void
+    global_to_overlap_finish(
+      const std::vector<const LinearAlgebra::distributed::Vector<T> *> &inputs,
+      const std::vector<Vector<T> *> &outputs);
+
+    /**
+     * Return <code>true</code> if the communication of the current scatter
+     * has completed, i.e., if the corresponding finish function will not
+     * wait. Returns <code>true</code> if no scatter has been started.
+     */
+    bool
+    test();
+
   protected:
+    /**
+     * Persistent requests and buffers for one combination of direction,
+     * channel, and number of vectors.
+     */
+    struct PersistentTransfer
+    {
+      /**
+       * Destructor. Frees the requests.
+       */
+      ~PersistentTransfer();
+
+      /// Whether data moves from native to overlap vectors.
+      bool to_overlap;
+
+      /// Communication channel.
+      unsigned int channel;
+
+      /// Number of vectors packed into each message.
+      std::size_t n_vectors;
+
+      /// Whether or not values are communicated as floats.
+      bool reduced_precision;
+
+      /**
+       * Buffer for ghost values, with the vector index varying fastest.
+       * Written to asynchronously by MPI.
+       */
+      std::vector<T> ghost_values;
+
+      /**
+       * Buffer for values sent to (or received from) the owning processes,
+       * with the vector index varying fastest. Written to asynchronously by
+       * MPI.
+       */
+      std::vector<T> import_values;
+
+      /**
+       * Same as ghost_values, but used when values are communicated as
+       * floats.
+       */
+      std::vector<float> reduced_ghost_values;
+
+      /**
+       * Same as import_values, but used when values are communicated as
+       * floats.
+       */
+      std::vector<float> reduced_import_values;
+
+      /// Persistent requests for the receives and sends (in that order).
+      std::vector<MPI_Request> requests;
+    };
+
+    /**
+     * Return the persistent transfer object for the given parameters, setting
+     * it up if necessary.
+     */
+    PersistentTransfer &
+    get_transfer(const bool         to_overlap,
+                 const unsigned int channel,
+                 const std::size_t  n_vectors,
+                 const bool         reduced_precision = false);
+
     std::vector<types::global_dof_index> overlap_dofs;
 
-    LinearAlgebra::distributed::Vector<T> scatterer;
+    /**
+     * Partitioner describing the native vectors (with the ghost DoFs present
+     * in the overlap).
+     */
+    std::shared_ptr<const Utilities::MPI::Partitioner> partitioner =
+      std::make_shared<const Utilities::MPI::Partitioner>();
+
+    /**
+     * Indices of overlap entries which are locally owned.
+     */
+    std::vector<unsigned int> owned_overlap_indices;
+
+    /**
+     * Local indices, in the native vector, corresponding to
+     * owned_overlap_indices.
+     */
+    std::vector<unsigned int> owned_local_indices;
+
+    /**
+     * Indices of overlap entries which are not locally owned.
+     */
+    std::vector<unsigned int> ghost_overlap_indices;
+
+    /**
+     * Indices into the ghost values corresponding to ghost_overlap_indices.
+     */
+    std::vector<unsigned int> ghost_indices;
+
+    /**
+     * All persistent transfers set up so far.
+     */
+    std::vector<std::unique_ptr<PersistentTransfer>> transfers;
+
+    /**
+     * Transfer used by the current scatter.
+     */
+    PersistentTransfer *active_transfer = nullptr;
   };
 } // namespace fdl
 #endif
@@ -0,0 +1,69 @@
+#include <fiddle/grid/intersection_predicate.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/numerics/rtree.h>
+
+namespace fdl
+{
+  using namespace dealii;
+
+  template <int dim, int spacedim>
+  BoxIntersectionPredicate<dim, spacedim>::BoxIntersectionPredicate(
+    const std::vector<BoundingBox<spacedim, float>>      &a_cell_bboxes,
+    const std::vector<BoundingBox<spacedim>>             &p_bboxes,
+    const parallel::shared::Triangulation<dim, spacedim> &tria)
+    : tria(&tria)
+    , active_cell_bboxes(a_cell_bboxes)
+    , patch_bboxes(p_bboxes)
+  {
+    Assert(active_cell_bboxes.size() == tria.n_active_cells(),
+           ExcMessage("There should be a bounding box for each active cell"));
+    // Cell indices may be larger than the number of cells on a level (e.g.,
+    // after coarsening), so use the number of raw cells:
+    cell_intersects.resize(tria.n_levels());
+    for (unsigned int level_n = 0; level_n < tria.n_levels(); ++level_n)
+      cell_intersects[level_n].resize(tria.n_raw_cells(level_n), false);
+
+    // Speed up intersection by putting the patch bboxes in an rtree
+    const auto rtree = pack_rtree_of_indices(patch_bboxes);
+    for (const auto &cell : tria.active_cell_iterators())
+      {
+        // boost::geometry needs both boxes to have the same type - converting
+        // to double is exact.
+        const BoundingBox<spacedim, float> &float_bbox =
+          active_cell_bboxes[cell->active_cell_index()];
+        std::pair<Point<spacedim>, Point<spacedim>> corners;
+        for (unsigned int d = 0; d < spacedim; ++d)
+          {
+            corners.first[d]  = float_bbox.lower_bound(d);
+            corners.second[d] = float_bbox.upper_bound(d);
+          }
+        const BoundingBox<spacedim> cell_bbox(corners);
+
+        namespace bgi = boost::geometry::index;
+        cell_intersects[cell->level()][cell->index()] =
+          rtree.qbegin(bgi::intersects(cell_bbox)) != rtree.qend();
+      }
+
+    // A parent cell intersects a patch if one of its children does. Children
+    // are always one level finer than their parents so we can set all values
+    // by working from the finest level to the coarsest.
+    for (int level_n = static_cast<int>(tria.n_levels()) - 2; level_n >= 0;
+         --level_n)
+      for (const auto &cell : tria.cell_iterators_on_level(level_n))
+        if (cell->has_children())
+          {
+            const unsigned int n_children = cell->n_children();
+            for (unsigned int child_n = 0; child_n < n_children; ++child_n)
+              if (cell_intersects[level_n + 1][cell->child(child_n)->index()])
+                {
+                  cell_intersects[level_n][cell->index()] = true;
+                  break;
+                }
+          }
+  }
+
+  template class BoxIntersectionPredicate<NDIM - 1, NDIM>;
+  template class BoxIntersectionPredicate<NDIM, NDIM>;
+} // namespace fdl
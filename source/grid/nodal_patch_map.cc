@@ -63,6 +63,20 @@ namespace fdl
       index_set.compress();
   }
 
+  template <int dim, int spacedim>
+  void
+  NodalPatchMap<dim, spacedim>::reinit_patches(
+    const std::vector<tbox::Pointer<hier::Patch<spacedim>>> &new_patches)
+  {
+    AssertDimension(new_patches.size(), patches.size());
+#ifdef DEBUG
+    for (std::size_t patch_n = 0; patch_n < patches.size(); ++patch_n)
+      Assert(new_patches[patch_n]->getBox() == patches[patch_n]->getBox(),
+             ExcMessage("The new patches must have the same boxes."));
+#endif
+    patches = new_patches;
+  }
+
 
   template class NodalPatchMap<NDIM - 1, NDIM>;
   template class NodalPatchMap<NDIM, NDIM>;
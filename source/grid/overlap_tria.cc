@@ -18,6 +18,15 @@ namespace fdl
 
 
 
+  template <int dim, int spacedim>
+  OverlapTriangulation<dim, spacedim>::~OverlapTriangulation()
+  {
+    for (auto &connection : native_tria_listeners)
+      connection.disconnect();
+  }
+
+
+
   template <int dim, int spacedim>
   types::subdomain_id
   OverlapTriangulation<dim, spacedim>::locally_owned_subdomain() const
@@ -28,15 +37,42 @@ namespace fdl
 
 
   template <int dim, int spacedim>
-  void
+  bool
   OverlapTriangulation<dim, spacedim>::reinit(
     const parallel::shared::Triangulation<dim, spacedim> &shared_tria,
     const IntersectionPredicate<dim, spacedim>           &predicate)
   {
-    // todo - clear signals, etc. if there is a new shared tria
-    native_tria = &shared_tria;
+    // The overlap triangulation is completely determined by the native
+    // triangulation and the value of the predicate on each native cell, so if
+    // neither has changed then there is nothing to do. Evaluating the
+    // predicate on every cell is much cheaper than building a new
+    // triangulation.
+    std::vector<bool> predicate_values;
+    predicate_values.reserve(shared_tria.n_cells());
+    for (const auto &cell : shared_tria.cell_iterators())
+      predicate_values.push_back(predicate(cell));
+
+    if (native_tria == &shared_tria && !native_tria_changed &&
+        predicate_values == native_cell_predicate_values)
+      return false;
+
+    if (native_tria != &shared_tria)
+      {
+        for (auto &connection : native_tria_listeners)
+          connection.disconnect();
+        native_tria_listeners.clear();
+        native_tria_listeners.push_back(shared_tria.signals.any_change.connect(
+          [this]() { native_tria_changed = true; }));
+        native_tria_listeners.push_back(
+          shared_tria.signals.mesh_movement.connect(
+            [this]() { native_tria_changed = true; }));
+      }
+    native_tria                  = &shared_tria;
+    native_cell_predicate_values = std::move(predicate_values);
+    native_tria_changed          = false;
 
     reinit_overlapping_tria(predicate);
+    return true;
   }
 
 
@@ -160,10 +196,46 @@ namespace fdl
         cells.push_back(std::move(cell_data));
         // TODO - should we bother setting up boundary data?
       }
+    // Only give create_triangulation() the vertices of the selected cells
+    // (instead of every vertex of the native triangulation) so that the memory
+    // used by this object scales with the number of overlapping cells. New
+    // vertices created by refinement are set up by deal.II.
+    std::vector<unsigned int> used_vertices;
+    for (const auto &cell_data : cells)
+      used_vertices.insert(used_vertices.end(),
+                           cell_data.vertices.begin(),
+                           cell_data.vertices.end());
+    std::sort(used_vertices.begin(), used_vertices.end());
+    used_vertices.erase(std::unique(used_vertices.begin(), used_vertices.end()),
+                        used_vertices.end());
+
+    const std::vector<Point<spacedim>> &native_vertices =
+      native_tria->get_vertices();
+    std::vector<Point<spacedim>> vertices;
+    vertices.reserve(used_vertices.size());
+    for (const unsigned int vertex_n : used_vertices)
+      vertices.push_back(native_vertices[vertex_n]);
+
+    auto renumber = [&](std::vector<unsigned int> &vertex_indices) {
+      for (unsigned int &vertex_n : vertex_indices)
+        {
+          const auto it = std::lower_bound(used_vertices.begin(),
+                                           used_vertices.end(),
+                                           vertex_n);
+          Assert(it != used_vertices.end() && *it == vertex_n,
+                 ExcFDLInternalError());
+          vertex_n = it - used_vertices.begin();
+        }
+    };
+    for (auto &cell_data : cells)
+      renumber(cell_data.vertices);
+    for (auto &line_data : subcell_data.boundary_lines)
+      renumber(line_data.vertices);
+    for (auto &quad_data : subcell_data.boundary_quads)
+      renumber(quad_data.vertices);
+
     // Set up the coarsest level of the new overlap triangulation:
-    this->create_triangulation(native_tria->get_vertices(),
-                               cells,
-                               subcell_data);
+    this->create_triangulation(vertices, cells, subcell_data);
 
     for (auto &cell : this->active_cell_iterators())
       {
@@ -82,6 +82,20 @@ namespace fdl
       }
   }
 
+  template <int dim, int spacedim>
+  void
+  PatchMap<dim, spacedim>::reinit_patches(
+    const std::vector<tbox::Pointer<hier::Patch<spacedim>>> &new_patches)
+  {
+    AssertDimension(new_patches.size(), patches.size());
+#ifdef DEBUG
+    for (std::size_t patch_n = 0; patch_n < patches.size(); ++patch_n)
+      Assert(new_patches[patch_n]->getBox() == patches[patch_n]->getBox(),
+             ExcMessage("The new patches must have the same boxes."));
+#endif
+    patches = new_patches;
+  }
+
   // Since we depend on SAMRAI types (and SAMRAI uses 2D or 3D libraries) we
   // instantiate based on NDIM (provided by IBTK)
 
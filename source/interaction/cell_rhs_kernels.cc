@@ -0,0 +1,92 @@
+#include <fiddle/interaction/cell_rhs_kernels.h>
+
+#include <algorithm>
+
+namespace fdl
+{
+  void
+  compute_cell_rhs_generic(const unsigned int n_base_dofs,
+                           const unsigned int n_components,
+                           const unsigned int n_q_points,
+                           const double      *base_shape_values,
+                           const double      *values,
+                           const double      *JxW_values,
+                           double            *base_rhs)
+  {
+    std::fill(base_rhs, base_rhs + n_base_dofs * n_components, 0.0);
+    for (unsigned int q = 0; q < n_q_points; ++q)
+      {
+        const double *const q_shape_values =
+          base_shape_values + q * n_base_dofs;
+        const double *const q_values = values + q * n_components;
+        for (unsigned int k = 0; k < n_base_dofs; ++k)
+          {
+            const double shape_JxW = q_shape_values[k] * JxW_values[q];
+            for (unsigned int c = 0; c < n_components; ++c)
+              base_rhs[k * n_components + c] += shape_JxW * q_values[c];
+          }
+      }
+  }
+
+
+
+  namespace
+  {
+    template <int n_base_dofs>
+    CellRHSKernel
+    get_kernel(const unsigned int n_components)
+    {
+      switch (n_components)
+        {
+          case 1:
+            return &compute_cell_rhs<n_base_dofs, 1>;
+          case 2:
+            return &compute_cell_rhs<n_base_dofs, 2>;
+          case 3:
+            return &compute_cell_rhs<n_base_dofs, 3>;
+          default:
+            return nullptr;
+        }
+    }
+  } // namespace
+
+
+
+  bool
+  has_compiled_cell_rhs_kernel(const unsigned int n_base_dofs,
+                               const unsigned int n_components)
+  {
+    return get_cell_rhs_kernel(n_base_dofs, n_components) !=
+           &compute_cell_rhs_generic;
+  }
+
+
+
+  CellRHSKernel
+  get_cell_rhs_kernel(const unsigned int n_base_dofs,
+                      const unsigned int n_components)
+  {
+    CellRHSKernel kernel = nullptr;
+    switch (n_base_dofs)
+      {
+#define CASE(n)                           \
+  case n:                                 \
+    kernel = get_kernel<n>(n_components); \
+    break;
+        CASE(3)
+        CASE(4)
+        CASE(6)
+        CASE(8)
+        CASE(9)
+        CASE(10)
+        CASE(16)
+        CASE(27)
+        CASE(64)
+#undef CASE
+        default:
+          break;
+      }
+
+    return kernel ? kernel : &compute_cell_rhs_generic;
+  }
+} // namespace fdl
@@ -5,10 +5,9 @@
 
 #include <deal.II/base/mpi.h>
 
-#include <deal.II/fe/mapping_fe_field.h>
-
 #include <CartesianPatchGeometry.h>
 
+#include <algorithm>
 #include <cmath>
 #include <numeric>
 
@@ -21,11 +20,15 @@ namespace fdl
   ElementalInteraction<dim, spacedim>::ElementalInteraction(
     const unsigned int min_n_points_1D,
     const double       point_density,
-    const DensityKind  density_kind)
+    const DensityKind  density_kind,
+    const bool         cache_interaction_plan,
+    const bool         morton_order_cells)
     : InteractionBase<dim, spacedim>()
     , min_n_points_1D(min_n_points_1D)
     , point_density(point_density)
     , density_kind(density_kind)
+    , cache_interaction_plan(cache_interaction_plan)
+    , morton_order_cells(morton_order_cells)
   {}
 
   template <int dim, int spacedim>
@@ -37,10 +40,14 @@ namespace fdl
     const int                                             level_number,
     const unsigned int                                    min_n_points_1D,
     const double                                          point_density,
-    const DensityKind                                     density_kind)
+    const DensityKind                                     density_kind,
+    const bool cache_interaction_plan,
+    const bool morton_order_cells)
     : ElementalInteraction<dim, spacedim>(min_n_points_1D,
                                           point_density,
-                                          density_kind)
+                                          density_kind,
+                                          cache_interaction_plan,
+                                          morton_order_cells)
   {
     reinit(native_tria,
            active_cell_bboxes,
@@ -63,6 +70,12 @@ namespace fdl
                                            active_cell_lengths,
                                            patch_hierarchy,
                                            level_number);
+    // The overlap triangulation and patches changed so any plan is now
+    // invalid:
+    interaction_plan = InteractionPlan<dim, spacedim>();
+    invalidate_interaction_plan();
+    shape_value_caches.clear();
+
     // We need to implement some more quadrature families
     const auto reference_cells = native_tria.get_reference_cells();
     Assert(reference_cells.size() == 1, ExcFDLNotImplemented());
@@ -112,6 +125,111 @@ namespace fdl
       quadratures.push_back((*quadrature_family)[i]);
   }
 
+  template <int dim, int spacedim>
+  bool
+  ElementalInteraction<dim, spacedim>::reinit_patches(
+    tbox::Pointer<hier::BasePatchHierarchy<spacedim>> p_hierarchy,
+    const int                                         l_number,
+    const double                                      max_displacement)
+  {
+    if (!InteractionBase<dim, spacedim>::reinit_patches(p_hierarchy,
+                                                        l_number,
+                                                        max_displacement))
+      return false;
+
+    // The plan refers to the old patches:
+    interaction_plan = InteractionPlan<dim, spacedim>();
+    invalidate_interaction_plan();
+    return true;
+  }
+
+  template <int dim, int spacedim>
+  void
+  ElementalInteraction<dim, spacedim>::invalidate_interaction_plan()
+  {
+    cached_interaction_plans.clear();
+  }
+
+  template <int dim, int spacedim>
+  const InteractionPlan<dim, spacedim> &
+  ElementalInteraction<dim, spacedim>::get_interaction_plan(
+    const DoFHandler<dim, spacedim> &position_dof_handler,
+    const Vector<double>            &overlap_position) const
+  {
+    const auto compute_plan = [&](InteractionPlan<dim, spacedim> &plan) {
+      compute_interaction_plan(this->patch_map,
+                               position_dof_handler,
+                               overlap_position,
+                               quadrature_indices,
+                               quadratures,
+                               plan);
+      if (morton_order_cells)
+        morton_order_interaction_plan(this->patch_map, plan);
+    };
+
+    if (!cache_interaction_plan)
+      {
+        compute_plan(interaction_plan);
+        return interaction_plan;
+      }
+
+    // FNV-1a hash of the bytes of the position values
+    std::size_t hash = 14695981039346656037ull;
+    for (const double value : overlap_position)
+      {
+        const auto *bytes = reinterpret_cast<const unsigned char *>(&value);
+        for (unsigned int i = 0; i < sizeof(double); ++i)
+          hash = (hash ^ bytes[i]) * 1099511628211ull;
+      }
+
+    for (auto it = cached_interaction_plans.begin();
+         it != cached_interaction_plans.end();
+         ++it)
+      if (it->position_dof_handler == &position_dof_handler &&
+          it->position_hash == hash &&
+          it->overlap_position.size() == overlap_position.size() &&
+          std::equal(overlap_position.begin(),
+                     overlap_position.end(),
+                     it->overlap_position.begin()))
+        {
+          cached_interaction_plans.splice(cached_interaction_plans.begin(),
+                                          cached_interaction_plans,
+                                          it);
+          return it->plan;
+        }
+
+    if (cached_interaction_plans.size() >= max_cached_interaction_plans)
+      cached_interaction_plans.pop_back();
+    cached_interaction_plans.emplace_front();
+    CachedInteractionPlan &entry = cached_interaction_plans.front();
+    entry.position_dof_handler   = &position_dof_handler;
+    entry.position_hash          = hash;
+    entry.overlap_position       = overlap_position;
+    compute_plan(entry.plan);
+    return entry.plan;
+  }
+
+  template <int dim, int spacedim>
+  const ShapeValueCache<dim, spacedim> *
+  ElementalInteraction<dim, spacedim>::get_shape_value_cache(
+    const DoFHandler<dim, spacedim> &dof_handler,
+    const Mapping<dim, spacedim>    &mapping) const
+  {
+    if (!supports_shape_value_cache(dof_handler.get_fe()))
+      return nullptr;
+
+    const auto key = std::make_pair(&dof_handler, &mapping);
+    auto       it  = shape_value_caches.find(key);
+    if (it == shape_value_caches.end())
+      {
+        it = shape_value_caches.emplace(key, ShapeValueCache<dim, spacedim>())
+               .first;
+        compute_shape_value_cache(
+          dof_handler, mapping, quadrature_indices, quadratures, it->second);
+      }
+    return &it->second;
+  }
+
   template <int dim, int spacedim>
   bool
   ElementalInteraction<dim, spacedim>::projection_is_interpolation() const
@@ -124,83 +242,152 @@ namespace fdl
   ElementalInteraction<dim, spacedim>::compute_projection_rhs_intermediate(
     std::unique_ptr<TransactionBase> t_ptr) const
   {
-    auto &trans = dynamic_cast<Transaction<dim, spacedim> &>(*t_ptr);
-    Assert((trans.operation ==
-            Transaction<dim, spacedim>::Operation::Interpolation),
-           ExcMessage("Transaction operation should be Interpolation"));
-    Assert((trans.next_state ==
-            Transaction<dim, spacedim>::State::Intermediate),
-           ExcMessage("Transaction state should be Intermediate"));
+    std::vector<std::unique_ptr<TransactionBase>> transactions;
+    transactions.push_back(std::move(t_ptr));
+    auto result =
+      fused_compute_projection_rhs_intermediate({this},
+                                                std::move(transactions));
+    return std::move(result[0]);
+  }
 
-    // Finish communication:
-    trans.position_scatter.global_to_overlap_finish(*trans.native_position,
-                                                    trans.overlap_position);
+  template <int dim, int spacedim>
+  std::unique_ptr<TransactionBase>
+  ElementalInteraction<dim, spacedim>::compute_spread_intermediate(
+    std::unique_ptr<TransactionBase> t_ptr)
+  {
+    std::vector<std::unique_ptr<TransactionBase>> transactions;
+    transactions.push_back(std::move(t_ptr));
+    auto result =
+      fused_compute_spread_intermediate({this}, std::move(transactions));
+    return std::move(result[0]);
+  }
 
-    MappingFEField<dim, spacedim, Vector<double>> position_mapping(
-      this->get_overlap_dof_handler(*trans.native_position_dof_handler),
-      trans.overlap_position);
+  template <int dim, int spacedim>
+  std::vector<std::unique_ptr<TransactionBase>>
+  ElementalInteraction<dim, spacedim>::fused_compute_projection_rhs_intermediate(
+    const std::vector<const ElementalInteraction<dim, spacedim> *>
+                                                  &interactions,
+    std::vector<std::unique_ptr<TransactionBase>> transactions)
+  {
+    AssertDimension(interactions.size(), transactions.size());
+    std::vector<PartInteractionData<dim, spacedim>> parts(interactions.size());
+    std::vector<Vector<double> *>                   rhs(interactions.size());
+    int                                             data_idx = -1;
+    for (unsigned int i = 0; i < interactions.size(); ++i)
+      {
+        const ElementalInteraction<dim, spacedim> &interaction =
+          *interactions[i];
+        auto &trans =
+          dynamic_cast<Transaction<dim, spacedim> &>(*transactions[i]);
+        Assert((trans.operation ==
+                Transaction<dim, spacedim>::Operation::Interpolation),
+               ExcMessage("Transaction operation should be Interpolation"));
+        Assert((trans.next_state ==
+                Transaction<dim, spacedim>::State::Intermediate),
+               ExcMessage("Transaction state should be Intermediate"));
+        Assert(i == 0 || trans.current_data_idx == data_idx,
+               ExcMessage("All transactions should use the same data index"));
+        data_idx = trans.current_data_idx;
+
+        // Finish communication:
+        trans.position_scatter.global_to_overlap_finish(*trans.native_position,
+                                                        trans.overlap_position);
+
+        const DoFHandler<dim, spacedim> &dof_handler =
+          interaction.get_overlap_dof_handler(*trans.native_dof_handler);
+        parts[i].kernel_name   = trans.kernel_name;
+        parts[i].native_kernel = trans.native_kernel;
+        parts[i].patch_map     = &interaction.patch_map;
+        parts[i].plan          = &interaction.get_interaction_plan(
+          interaction.get_overlap_dof_handler(
+            *trans.native_position_dof_handler),
+          trans.overlap_position);
+        parts[i].quadrature_indices = &interaction.quadrature_indices;
+        parts[i].quadratures        = &interaction.quadratures;
+        parts[i].dof_handler        = &dof_handler;
+        parts[i].mapping            = &*trans.mapping;
+        parts[i].shape_value_cache =
+          interaction.get_shape_value_cache(dof_handler, *trans.mapping);
+        rhs[i] = &trans.overlap_rhs;
+      }
 
     // Actually do the interpolation:
-    compute_projection_rhs(trans.kernel_name,
-                           trans.current_data_idx,
-                           this->patch_map,
-                           position_mapping,
-                           quadrature_indices,
-                           quadratures,
-                           this->get_overlap_dof_handler(
-                             *trans.native_dof_handler),
-                           *trans.mapping,
-                           trans.overlap_rhs);
+    if (parts.size() > 0)
+      compute_projection_rhs(data_idx, parts, rhs);
 
     // After we compute we begin the scatter back to the native partitioning:
-    trans.rhs_scatter.overlap_to_global_start(trans.overlap_rhs,
-                                              trans.rhs_scatter_back_op,
-                                              0,
-                                              *trans.native_rhs);
+    for (std::unique_ptr<TransactionBase> &t_ptr : transactions)
+      {
+        auto &trans = dynamic_cast<Transaction<dim, spacedim> &>(*t_ptr);
+        trans.rhs_scatter.overlap_to_global_start(trans.overlap_rhs,
+                                                  trans.rhs_scatter_back_op,
+                                                  0,
+                                                  *trans.native_rhs);
 
-    trans.next_state = Transaction<dim, spacedim>::State::Finish;
+        trans.next_state = Transaction<dim, spacedim>::State::Finish;
+      }
 
-    return t_ptr;
+    return transactions;
   }
 
   template <int dim, int spacedim>
-  std::unique_ptr<TransactionBase>
-  ElementalInteraction<dim, spacedim>::compute_spread_intermediate(
-    std::unique_ptr<TransactionBase> t_ptr)
+  std::vector<std::unique_ptr<TransactionBase>>
+  ElementalInteraction<dim, spacedim>::fused_compute_spread_intermediate(
+    const std::vector<ElementalInteraction<dim, spacedim> *> &interactions,
+    std::vector<std::unique_ptr<TransactionBase>>             transactions)
   {
-    auto &trans = dynamic_cast<Transaction<dim, spacedim> &>(*t_ptr);
-    Assert((trans.operation ==
-            Transaction<dim, spacedim>::Operation::Spreading),
-           ExcMessage("Transaction operation should be Spreading"));
-    Assert((trans.next_state ==
-            Transaction<dim, spacedim>::State::Intermediate),
-           ExcMessage("Transaction state should be Intermediate"));
-
-    // Finish communication:
-    trans.position_scatter.global_to_overlap_finish(*trans.native_position,
-                                                    trans.overlap_position);
-
-    trans.solution_scatter.global_to_overlap_finish(*trans.native_solution,
-                                                    trans.overlap_solution);
-
-    MappingFEField<dim, spacedim, Vector<double>> position_mapping(
-      this->get_overlap_dof_handler(*trans.native_position_dof_handler),
-      trans.overlap_position);
+    AssertDimension(interactions.size(), transactions.size());
+    std::vector<PartInteractionData<dim, spacedim>> parts(interactions.size());
+    std::vector<const Vector<double> *> solutions(interactions.size());
+    int                                 data_idx = -1;
+    for (unsigned int i = 0; i < interactions.size(); ++i)
+      {
+        const ElementalInteraction<dim, spacedim> &interaction =
+          *interactions[i];
+        auto &trans =
+          dynamic_cast<Transaction<dim, spacedim> &>(*transactions[i]);
+        Assert((trans.operation ==
+                Transaction<dim, spacedim>::Operation::Spreading),
+               ExcMessage("Transaction operation should be Spreading"));
+        Assert((trans.next_state ==
+                Transaction<dim, spacedim>::State::Intermediate),
+               ExcMessage("Transaction state should be Intermediate"));
+        Assert(i == 0 || trans.current_data_idx == data_idx,
+               ExcMessage("All transactions should use the same data index"));
+        data_idx = trans.current_data_idx;
+
+        // Finish communication:
+        InteractionBase<dim, spacedim>::finish_spread_scatters(trans);
+
+        const DoFHandler<dim, spacedim> &dof_handler =
+          interaction.get_overlap_dof_handler(*trans.native_dof_handler);
+        parts[i].kernel_name   = trans.kernel_name;
+        parts[i].native_kernel = trans.native_kernel;
+        parts[i].patch_map     = &interaction.patch_map;
+        parts[i].plan          = &interaction.get_interaction_plan(
+          interaction.get_overlap_dof_handler(
+            *trans.native_position_dof_handler),
+          trans.overlap_position);
+        parts[i].quadrature_indices = &interaction.quadrature_indices;
+        parts[i].quadratures        = &interaction.quadratures;
+        parts[i].dof_handler        = &dof_handler;
+        parts[i].mapping            = &*trans.mapping;
+        parts[i].shape_value_cache =
+          interaction.get_shape_value_cache(dof_handler, *trans.mapping);
+        solutions[i] = &trans.overlap_solution;
+      }
 
     // Actually do the spreading:
-    compute_spread(trans.kernel_name,
-                   trans.current_data_idx,
-                   this->patch_map,
-                   position_mapping,
-                   quadrature_indices,
-                   quadratures,
-                   this->get_overlap_dof_handler(*trans.native_dof_handler),
-                   *trans.mapping,
-                   trans.overlap_solution);
-
-    trans.next_state = Transaction<dim, spacedim>::State::Finish;
+    if (parts.size() > 0)
+      compute_spread(data_idx, parts, solutions);
 
-    return t_ptr;
+    for (std::unique_ptr<TransactionBase> &t_ptr : transactions)
+      {
+        auto &trans      = dynamic_cast<Transaction<dim, spacedim> &>(*t_ptr);
+        trans.next_state = Transaction<dim, spacedim>::State::Finish;
+      }
+
+    return transactions;
   }
 
   template <int dim, int spacedim>
@@ -217,15 +404,11 @@ namespace fdl
     trans.position_scatter.global_to_overlap_finish(*trans.native_position,
                                                     trans.overlap_position);
 
-    MappingFEField<dim, spacedim, Vector<double>> position_mapping(
+    const InteractionPlan<dim, spacedim> &plan = get_interaction_plan(
       this->get_overlap_dof_handler(*trans.native_position_dof_handler),
       trans.overlap_position);
 
-    count_quadrature_points(trans.workload_index,
-                            this->patch_map,
-                            position_mapping,
-                            quadrature_indices,
-                            quadratures);
+    count_quadrature_points(trans.workload_index, this->patch_map, plan);
 
     trans.next_state = WorkloadTransaction<dim, spacedim>::State::Finish;
 
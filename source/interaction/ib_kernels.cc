@@ -0,0 +1,853 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/interaction/ib_kernels.h>
+
+#include <deal.II/base/parallel.h>
+
+#include <boost/container/small_vector.hpp>
+
+#include <ibtk/IndexUtilities.h>
+#include <ibtk/LEInteractor.h>
+
+#include <CartesianPatchGeometry.h>
+#include <CellData.h>
+#include <EdgeData.h>
+#include <NodeData.h>
+#include <SideData.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+namespace fdl
+{
+  using namespace dealii;
+  using namespace SAMRAI;
+
+  namespace
+  {
+    /**
+     * A set of Cartesian grid points (the values stored in a single ArrayData
+     * object) offset from the cell corners by @p centering, measured in units
+     * of grid spacing. For example, cell-centered data has centering 0.5 in
+     * every coordinate direction.
+     */
+    template <int spacedim>
+    struct CenteredArray
+    {
+      pdat::ArrayData<spacedim, double> *array;
+      std::array<double, spacedim>       centering;
+    };
+
+    template <int spacedim>
+    boost::container::small_vector<CenteredArray<spacedim>, spacedim>
+    get_centered_arrays(pdat::CellData<spacedim, double> &data)
+    {
+      CenteredArray<spacedim> result;
+      result.array = &data.getArrayData();
+      result.centering.fill(0.5);
+      return {result};
+    }
+
+    template <int spacedim>
+    boost::container::small_vector<CenteredArray<spacedim>, spacedim>
+    get_centered_arrays(pdat::NodeData<spacedim, double> &data)
+    {
+      CenteredArray<spacedim> result;
+      result.array = &data.getArrayData();
+      result.centering.fill(0.0);
+      return {result};
+    }
+
+    template <int spacedim>
+    boost::container::small_vector<CenteredArray<spacedim>, spacedim>
+    get_centered_arrays(pdat::SideData<spacedim, double> &data)
+    {
+      boost::container::small_vector<CenteredArray<spacedim>, spacedim> result;
+      for (unsigned int axis = 0; axis < spacedim; ++axis)
+        {
+          CenteredArray<spacedim> array;
+          array.array = &data.getArrayData(axis);
+          array.centering.fill(0.5);
+          array.centering[axis] = 0.0;
+          result.push_back(array);
+        }
+      return result;
+    }
+
+    template <int spacedim>
+    boost::container::small_vector<CenteredArray<spacedim>, spacedim>
+    get_centered_arrays(pdat::EdgeData<spacedim, double> &)
+    {
+      // has_native_ib_kernel() always returns false for edge-centered data
+      Assert(false, ExcFDLNotImplemented());
+      return {};
+    }
+
+
+
+    /**
+     * Lower corner and weights of a kernel stencil centered at a single point.
+     */
+    template <typename Kernel, int spacedim>
+    struct Stencil
+    {
+      std::array<int, spacedim>                               lower;
+      std::array<std::array<double, Kernel::width>, spacedim> weights;
+
+      /**
+       * Range of stencil entries, in each coordinate direction, which are
+       * inside the data array. These are only different from [0, width) if
+       * the stencil was clipped by compute_stencil_offset().
+       */
+      std::array<int, spacedim> begin;
+      std::array<int, spacedim> end;
+      bool                      clipped;
+    };
+
+    template <typename Kernel, int spacedim>
+    inline void
+    compute_stencil(const double                       *X,
+                    const double                       *x_lower,
+                    const double                       *dx,
+                    const hier::Index<spacedim>        &ilower,
+                    const std::array<double, spacedim> &centering,
+                    Stencil<Kernel, spacedim>          &stencil)
+    {
+      for (unsigned int d = 0; d < spacedim; ++d)
+        {
+          // position in index space relative to the data points:
+          const double s =
+            (X[d] - x_lower[d]) / dx[d] + ilower(d) - centering[d];
+          // first grid point with |s - i| < width / 2
+          const int lower  = int(std::floor(s + 1.0 - 0.5 * Kernel::width));
+          stencil.lower[d] = lower;
+          for (int j = 0; j < Kernel::width; ++j)
+            stencil.weights[d][j] = Kernel::value(s - double(lower + j));
+        }
+    }
+
+    /**
+     * Offset, into a single depth of @p array, of the first entry of the
+     * stencil inside the array. The strides of the array are also computed.
+     *
+     * Like LEInteractor, stencils which extend past the ghost region of the
+     * data are clipped (i.e., entries outside the array are ignored) - this
+     * happens when the patch data has fewer ghost cells than the kernel
+     * needs.
+     */
+    template <typename Kernel, int spacedim>
+    inline std::ptrdiff_t
+    compute_stencil_offset(Stencil<Kernel, spacedim>               &stencil,
+                           const pdat::ArrayData<spacedim, double> &array,
+                           std::array<std::ptrdiff_t, spacedim>    &strides)
+    {
+      const hier::Box<spacedim> &array_box = array.getBox();
+      std::ptrdiff_t             offset    = 0;
+      std::ptrdiff_t             stride    = 1;
+      bool                       empty     = false;
+      stencil.clipped                      = false;
+      for (unsigned int d = 0; d < spacedim; ++d)
+        {
+          stencil.begin[d] =
+            std::max(0, array_box.lower(d) - stencil.lower[d]);
+          stencil.end[d] = std::min(Kernel::width,
+                                    array_box.upper(d) - stencil.lower[d] + 1);
+          stencil.clipped = stencil.clipped || stencil.begin[d] != 0 ||
+                            stencil.end[d] != Kernel::width;
+          empty = empty || stencil.begin[d] >= stencil.end[d];
+
+          strides[d] = stride;
+          offset += (stencil.lower[d] + stencil.begin[d] - array_box.lower(d)) *
+                    stride;
+          stride *= array_box.numberCells(d);
+        }
+      // Nothing will be read or written so don't compute a pointer outside
+      // the array
+      return empty ? 0 : offset;
+    }
+
+    template <typename Kernel>
+    inline double
+    interpolate_stencil(const Stencil<Kernel, 2>            &stencil,
+                        const double                        *start,
+                        const std::array<std::ptrdiff_t, 2> &strides)
+    {
+      double result = 0.0;
+      for (int j1 = 0; j1 < Kernel::width; ++j1)
+        {
+          const double *const row   = start + j1 * strides[1];
+          double              value = 0.0;
+          for (int j0 = 0; j0 < Kernel::width; ++j0)
+            value += stencil.weights[0][j0] * row[j0];
+          result += stencil.weights[1][j1] * value;
+        }
+      return result;
+    }
+
+    template <typename Kernel>
+    inline double
+    interpolate_stencil(const Stencil<Kernel, 3>            &stencil,
+                        const double                        *start,
+                        const std::array<std::ptrdiff_t, 3> &strides)
+    {
+      double result = 0.0;
+      for (int j2 = 0; j2 < Kernel::width; ++j2)
+        {
+          double plane_value = 0.0;
+          for (int j1 = 0; j1 < Kernel::width; ++j1)
+            {
+              const double *const row =
+                start + j2 * strides[2] + j1 * strides[1];
+              double value = 0.0;
+              for (int j0 = 0; j0 < Kernel::width; ++j0)
+                value += stencil.weights[0][j0] * row[j0];
+              plane_value += stencil.weights[1][j1] * value;
+            }
+          result += stencil.weights[2][j2] * plane_value;
+        }
+      return result;
+    }
+
+    template <typename Kernel>
+    inline void
+    spread_stencil(const Stencil<Kernel, 2>            &stencil,
+                   const double                         value,
+                   double                              *start,
+                   const std::array<std::ptrdiff_t, 2> &strides)
+    {
+      for (int j1 = 0; j1 < Kernel::width; ++j1)
+        {
+          double *const row        = start + j1 * strides[1];
+          const double  row_weight = stencil.weights[1][j1] * value;
+          for (int j0 = 0; j0 < Kernel::width; ++j0)
+            row[j0] += stencil.weights[0][j0] * row_weight;
+        }
+    }
+
+    template <typename Kernel>
+    inline void
+    spread_stencil(const Stencil<Kernel, 3>            &stencil,
+                   const double                         value,
+                   double                              *start,
+                   const std::array<std::ptrdiff_t, 3> &strides)
+    {
+      for (int j2 = 0; j2 < Kernel::width; ++j2)
+        for (int j1 = 0; j1 < Kernel::width; ++j1)
+          {
+            double *const row = start + j2 * strides[2] + j1 * strides[1];
+            const double  row_weight =
+              stencil.weights[2][j2] * stencil.weights[1][j1] * value;
+            for (int j0 = 0; j0 < Kernel::width; ++j0)
+              row[j0] += stencil.weights[0][j0] * row_weight;
+          }
+    }
+
+    /**
+     * Versions of the above functions for clipped stencils. These are slower
+     * since the loop bounds are not known at compile time. Here @p start
+     * points to the first entry of the stencil inside the array.
+     */
+    template <typename Kernel>
+    inline double
+    interpolate_clipped_stencil(const Stencil<Kernel, 2>            &stencil,
+                                const double                        *start,
+                                const std::array<std::ptrdiff_t, 2> &strides)
+    {
+      const auto &b      = stencil.begin;
+      double      result = 0.0;
+      for (int j1 = b[1]; j1 < stencil.end[1]; ++j1)
+        {
+          const double *const row   = start + (j1 - b[1]) * strides[1];
+          double              value = 0.0;
+          for (int j0 = b[0]; j0 < stencil.end[0]; ++j0)
+            value += stencil.weights[0][j0] * row[j0 - b[0]];
+          result += stencil.weights[1][j1] * value;
+        }
+      return result;
+    }
+
+    template <typename Kernel>
+    inline double
+    interpolate_clipped_stencil(const Stencil<Kernel, 3>            &stencil,
+                                const double                        *start,
+                                const std::array<std::ptrdiff_t, 3> &strides)
+    {
+      const auto &b      = stencil.begin;
+      double      result = 0.0;
+      for (int j2 = b[2]; j2 < stencil.end[2]; ++j2)
+        {
+          double plane_value = 0.0;
+          for (int j1 = b[1]; j1 < stencil.end[1]; ++j1)
+            {
+              const double *const row =
+                start + (j2 - b[2]) * strides[2] + (j1 - b[1]) * strides[1];
+              double value = 0.0;
+              for (int j0 = b[0]; j0 < stencil.end[0]; ++j0)
+                value += stencil.weights[0][j0] * row[j0 - b[0]];
+              plane_value += stencil.weights[1][j1] * value;
+            }
+          result += stencil.weights[2][j2] * plane_value;
+        }
+      return result;
+    }
+
+    template <typename Kernel>
+    inline void
+    spread_clipped_stencil(const Stencil<Kernel, 2>            &stencil,
+                           const double                         value,
+                           double                              *start,
+                           const std::array<std::ptrdiff_t, 2> &strides)
+    {
+      const auto &b = stencil.begin;
+      for (int j1 = b[1]; j1 < stencil.end[1]; ++j1)
+        {
+          double *const row        = start + (j1 - b[1]) * strides[1];
+          const double  row_weight = stencil.weights[1][j1] * value;
+          for (int j0 = b[0]; j0 < stencil.end[0]; ++j0)
+            row[j0 - b[0]] += stencil.weights[0][j0] * row_weight;
+        }
+    }
+
+    template <typename Kernel>
+    inline void
+    spread_clipped_stencil(const Stencil<Kernel, 3>            &stencil,
+                           const double                         value,
+                           double                              *start,
+                           const std::array<std::ptrdiff_t, 3> &strides)
+    {
+      const auto &b = stencil.begin;
+      for (int j2 = b[2]; j2 < stencil.end[2]; ++j2)
+        for (int j1 = b[1]; j1 < stencil.end[1]; ++j1)
+          {
+            double *const row =
+              start + (j2 - b[2]) * strides[2] + (j1 - b[1]) * strides[1];
+            const double row_weight =
+              stencil.weights[2][j2] * stencil.weights[1][j1] * value;
+            for (int j0 = b[0]; j0 < stencil.end[0]; ++j0)
+              row[j0 - b[0]] += stencil.weights[0][j0] * row_weight;
+          }
+    }
+
+
+
+    /**
+     * The parts of a CartesianPatchGeometry we need. Copying tbox::Pointer
+     * objects is not thread-safe so we extract these once before starting any
+     * tasks.
+     */
+    template <int spacedim>
+    struct PatchGeometry
+    {
+      PatchGeometry(const hier::Patch<spacedim> &patch)
+        : patch_box(patch.getBox())
+      {
+        const tbox::Pointer<geom::CartesianPatchGeometry<spacedim>>
+          patch_geom = patch.getPatchGeometry();
+        Assert(patch_geom, ExcMessage("Type mismatch"));
+        x_lower = patch_geom->getXLower();
+        x_upper = patch_geom->getXUpper();
+        dx      = patch_geom->getDx();
+      }
+
+      hier::Index<spacedim>
+      get_cell_index(const double *X) const
+      {
+        return IBTK::IndexUtilities::getCellIndex(X,
+                                                  x_lower,
+                                                  x_upper,
+                                                  dx,
+                                                  patch_box.lower(),
+                                                  patch_box.upper());
+      }
+
+      const hier::Box<spacedim> &patch_box;
+      const double              *x_lower;
+      const double              *x_upper;
+      const double              *dx;
+    };
+
+    /**
+     * Number of points each task should work on at once.
+     */
+    constexpr int point_grainsize = 256;
+
+    template <typename Kernel, int spacedim, typename patch_type>
+    void
+    interpolate_internal(
+      double                                     *values,
+      const int                                   n_values,
+      const int                                   depth,
+      const double                               *positions,
+      const int                                   n_positions,
+      const tbox::Pointer<patch_type>            &data,
+      const tbox::Pointer<hier::Patch<spacedim>> &patch,
+      const hier::Box<spacedim>                  &box)
+    {
+      const PatchGeometry<spacedim> geometry(*patch);
+
+      // As with LEInteractor, depth is the number of components of each value
+      // (i.e., it includes the spacedim factor for side-centered data)
+      const auto arrays       = get_centered_arrays(*data);
+      const int  n_components = depth;
+      const int  array_depth  = n_components / int(arrays.size());
+      const int  n_points     = n_positions / spacedim;
+      Assert(array_depth * int(arrays.size()) == n_components,
+             ExcMessage("The number of components should be a multiple of the "
+                        "number of data arrays."));
+      (void)n_values;
+      Assert(n_values == n_points * n_components,
+             ExcMessage("The number of values and number of points should "
+                        "match."));
+
+      // Each point is independent so we can interpolate in parallel.
+      parallel::apply_to_subranges(
+        0,
+        n_points,
+        [&](const int begin, const int end) {
+          Stencil<Kernel, spacedim>            stencil;
+          std::array<std::ptrdiff_t, spacedim> strides;
+          for (int point_n = begin; point_n < end; ++point_n)
+            {
+              const double *const X = positions + point_n * spacedim;
+              if (!box.contains(geometry.get_cell_index(X)))
+                continue;
+
+              for (unsigned int array_n = 0; array_n < arrays.size();
+                   ++array_n)
+                {
+                  const auto &array = arrays[array_n];
+                  compute_stencil(X,
+                                  geometry.x_lower,
+                                  geometry.dx,
+                                  geometry.patch_box.lower(),
+                                  array.centering,
+                                  stencil);
+                  const std::ptrdiff_t offset =
+                    compute_stencil_offset(stencil, *array.array, strides);
+                  double *const point_values =
+                    values + point_n * n_components + array_n * array_depth;
+                  for (int d = 0; d < array_depth; ++d)
+                    {
+                      const double *const start =
+                        array.array->getPointer(d) + offset;
+                      point_values[d] =
+                        stencil.clipped ?
+                          interpolate_clipped_stencil(stencil, start, strides) :
+                          interpolate_stencil(stencil, start, strides);
+                    }
+                }
+            }
+        },
+        point_grainsize);
+    }
+
+    template <typename Kernel, int spacedim, typename patch_type>
+    void
+    spread_internal(tbox::Pointer<patch_type>                  &data,
+                    const double                               *values,
+                    const int                                   n_values,
+                    const int                                   depth,
+                    const double                               *positions,
+                    const int                                   n_positions,
+                    const tbox::Pointer<hier::Patch<spacedim>> &patch,
+                    const hier::Box<spacedim>                  &box)
+    {
+      const PatchGeometry<spacedim> geometry(*patch);
+      double                        cell_volume = 1.0;
+      for (unsigned int d = 0; d < spacedim; ++d)
+        cell_volume *= geometry.dx[d];
+
+      // As with LEInteractor, depth is the number of components of each value
+      // (i.e., it includes the spacedim factor for side-centered data)
+      const auto arrays       = get_centered_arrays(*data);
+      const int  n_components = depth;
+      const int  array_depth  = n_components / int(arrays.size());
+      const int  n_points     = n_positions / spacedim;
+      Assert(array_depth * int(arrays.size()) == n_components,
+             ExcMessage("The number of components should be a multiple of the "
+                        "number of data arrays."));
+      (void)n_values;
+      Assert(n_values == n_points * n_components,
+             ExcMessage("The number of values and number of points should "
+                        "match."));
+
+      // Different points may write to the same Eulerian data, so we cannot
+      // naively spread in parallel. Instead, sort the points into slabs of
+      // Eulerian cells (along the last coordinate direction) which are wide
+      // enough that the stencils of points in non-adjacent slabs cannot
+      // overlap (stencils may be offset by an extra cell due to data
+      // centering, so add some padding). All even slabs are then spread in
+      // parallel, followed by all odd slabs. Since the order in which values
+      // are added to each Eulerian data point does not depend on the number
+      // of threads, the result is bitwise identical for any number of threads.
+      constexpr int              slab_axis  = spacedim - 1;
+      constexpr int              slab_width = Kernel::width + 2;
+      const hier::Box<spacedim> &patch_box  = geometry.patch_box;
+      const int                  n_slabs =
+        (patch_box.numberCells(slab_axis) + slab_width - 1) / slab_width;
+
+      // Counting sort. Points outside the box are never spread so skip them
+      // here.
+      std::vector<int> point_slabs(n_points, -1);
+      std::vector<int> slab_offsets(n_slabs + 1);
+      for (int point_n = 0; point_n < n_points; ++point_n)
+        {
+          const hier::Index<spacedim> i =
+            geometry.get_cell_index(positions + point_n * spacedim);
+          if (box.contains(i))
+            {
+              const int slab =
+                (i(slab_axis) - patch_box.lower(slab_axis)) / slab_width;
+              point_slabs[point_n] = std::min(std::max(slab, 0), n_slabs - 1);
+              ++slab_offsets[point_slabs[point_n] + 1];
+            }
+        }
+      std::partial_sum(slab_offsets.begin(),
+                       slab_offsets.end(),
+                       slab_offsets.begin());
+      std::vector<int> sorted_points(slab_offsets.back());
+      {
+        std::vector<int> slab_ends(slab_offsets.begin(),
+                                   slab_offsets.end() - 1);
+        for (int point_n = 0; point_n < n_points; ++point_n)
+          if (point_slabs[point_n] != -1)
+            sorted_points[slab_ends[point_slabs[point_n]]++] = point_n;
+      }
+
+      const auto spread_slab = [&](const int slab) {
+        Stencil<Kernel, spacedim>            stencil;
+        std::array<std::ptrdiff_t, spacedim> strides;
+        for (int j = slab_offsets[slab]; j < slab_offsets[slab + 1]; ++j)
+          {
+            const int           point_n = sorted_points[j];
+            const double *const X       = positions + point_n * spacedim;
+            for (unsigned int array_n = 0; array_n < arrays.size(); ++array_n)
+              {
+                const auto &array = arrays[array_n];
+                compute_stencil(X,
+                                geometry.x_lower,
+                                geometry.dx,
+                                patch_box.lower(),
+                                array.centering,
+                                stencil);
+                const std::ptrdiff_t offset =
+                  compute_stencil_offset(stencil, *array.array, strides);
+                const double *const point_values =
+                  values + point_n * n_components + array_n * array_depth;
+                for (int d = 0; d < array_depth; ++d)
+                  {
+                    double *const start = array.array->getPointer(d) + offset;
+                    const double  value = point_values[d] / cell_volume;
+                    if (stencil.clipped)
+                      spread_clipped_stencil(stencil, value, start, strides);
+                    else
+                      spread_stencil(stencil, value, start, strides);
+                  }
+              }
+          }
+      };
+
+      for (int color = 0; color < 2; ++color)
+        parallel::apply_to_subranges(
+          0,
+          (n_slabs - color + 1) / 2,
+          [&](const int begin, const int end) {
+            for (int j = begin; j < end; ++j)
+              spread_slab(2 * j + color);
+          },
+          1);
+    }
+
+
+
+    /**
+     * Call @p f with an instance of the kernel corresponding to @p kernel.
+     * Returns <code>false</code> if there is no such kernel.
+     */
+    template <typename F>
+    bool
+    dispatch_kernel(const NativeIBKernel kernel, F &&f)
+    {
+      switch (kernel)
+        {
+          case NativeIBKernel::IB3:
+            f(IB3Kernel());
+            return true;
+          case NativeIBKernel::IB4:
+            f(IB4Kernel());
+            return true;
+          case NativeIBKernel::IB6:
+            f(IB6Kernel());
+            return true;
+          case NativeIBKernel::BSpline2:
+            f(BSplineKernel<2>());
+            return true;
+          case NativeIBKernel::BSpline3:
+            f(BSplineKernel<3>());
+            return true;
+          case NativeIBKernel::BSpline4:
+            f(BSplineKernel<4>());
+            return true;
+          case NativeIBKernel::BSpline5:
+            f(BSplineKernel<5>());
+            return true;
+          case NativeIBKernel::BSpline6:
+            f(BSplineKernel<6>());
+            return true;
+          case NativeIBKernel::None:
+            return false;
+        }
+
+      Assert(false, ExcFDLInternalError());
+      return false;
+    }
+  } // namespace
+
+
+
+  NativeIBKernel
+  get_native_ib_kernel(const std::string &kernel_name)
+  {
+    if (kernel_name == "IB_3")
+      return NativeIBKernel::IB3;
+    else if (kernel_name == "IB_4")
+      return NativeIBKernel::IB4;
+    else if (kernel_name == "IB_6")
+      return NativeIBKernel::IB6;
+    else if (kernel_name == "PIECEWISE_LINEAR")
+      return NativeIBKernel::BSpline2;
+    else if (kernel_name == "BSPLINE_3")
+      return NativeIBKernel::BSpline3;
+    else if (kernel_name == "BSPLINE_4")
+      return NativeIBKernel::BSpline4;
+    else if (kernel_name == "BSPLINE_5")
+      return NativeIBKernel::BSpline5;
+    else if (kernel_name == "BSPLINE_6")
+      return NativeIBKernel::BSpline6;
+    else
+      return NativeIBKernel::None;
+  }
+
+
+
+  template <int spacedim, typename patch_type>
+  bool
+  has_native_ib_kernel(const NativeIBKernel kernel)
+  {
+    // We don't yet support edge-centered data
+    if (std::is_same<patch_type, pdat::EdgeData<spacedim, double>>::value)
+      return false;
+    return kernel != NativeIBKernel::None;
+  }
+
+
+
+  template <int spacedim, typename patch_type>
+  bool
+  has_native_ib_kernel(const std::string &kernel_name)
+  {
+    return has_native_ib_kernel<spacedim, patch_type>(
+      get_native_ib_kernel(kernel_name));
+  }
+
+
+
+  template <int spacedim, typename patch_type>
+  void
+  interpolate_from_patch(
+    double                                     *values,
+    const int                                   n_values,
+    const int                                   depth,
+    const double                               *positions,
+    const int                                   n_positions,
+    const tbox::Pointer<patch_type>            &data,
+    const tbox::Pointer<hier::Patch<spacedim>> &patch,
+    const hier::Box<spacedim>                  &box,
+    const std::string                          &kernel_name,
+    const NativeIBKernel                        native_kernel)
+  {
+    Assert(data, ExcMessage("Type mismatch"));
+    Assert(native_kernel == get_native_ib_kernel(kernel_name),
+           ExcMessage("The native kernel should match the kernel name."));
+    // We only know LEInteractor's ordering of values for side-centered data
+    // with depth 1
+    const bool native =
+      (!std::is_same<patch_type, pdat::SideData<spacedim, double>>::value ||
+       data->getDepth() == 1) &&
+      has_native_ib_kernel<spacedim, patch_type>(native_kernel) &&
+      dispatch_kernel(native_kernel, [&](const auto &kernel) {
+        using Kernel = typename std::decay<decltype(kernel)>::type;
+        interpolate_internal<Kernel>(
+          values, n_values, depth, positions, n_positions, data, patch, box);
+      });
+
+    if (!native)
+      IBTK::LEInteractor::interpolate(values,
+                                      n_values,
+                                      depth,
+                                      positions,
+                                      n_positions,
+                                      spacedim,
+                                      data,
+                                      patch,
+                                      box,
+                                      kernel_name);
+  }
+
+
+
+  template <int spacedim, typename patch_type>
+  void
+  interpolate_from_patch(
+    double                                     *values,
+    const int                                   n_values,
+    const int                                   depth,
+    const double                               *positions,
+    const int                                   n_positions,
+    const tbox::Pointer<patch_type>            &data,
+    const tbox::Pointer<hier::Patch<spacedim>> &patch,
+    const hier::Box<spacedim>                  &box,
+    const std::string                          &kernel_name)
+  {
+    interpolate_from_patch(values,
+                           n_values,
+                           depth,
+                           positions,
+                           n_positions,
+                           data,
+                           patch,
+                           box,
+                           kernel_name,
+                           get_native_ib_kernel(kernel_name));
+  }
+
+
+
+  template <int spacedim, typename patch_type>
+  void
+  spread_to_patch(tbox::Pointer<patch_type>                  &data,
+                  const double                               *values,
+                  const int                                   n_values,
+                  const int                                   depth,
+                  const double                               *positions,
+                  const int                                   n_positions,
+                  const tbox::Pointer<hier::Patch<spacedim>> &patch,
+                  const hier::Box<spacedim>                  &box,
+                  const std::string                          &kernel_name,
+                  const NativeIBKernel                        native_kernel)
+  {
+    Assert(data, ExcMessage("Type mismatch"));
+    Assert(native_kernel == get_native_ib_kernel(kernel_name),
+           ExcMessage("The native kernel should match the kernel name."));
+    // We only know LEInteractor's ordering of values for side-centered data
+    // with depth 1
+    const bool native =
+      (!std::is_same<patch_type, pdat::SideData<spacedim, double>>::value ||
+       data->getDepth() == 1) &&
+      has_native_ib_kernel<spacedim, patch_type>(native_kernel) &&
+      dispatch_kernel(native_kernel, [&](const auto &kernel) {
+        using Kernel = typename std::decay<decltype(kernel)>::type;
+        spread_internal<Kernel>(
+          data, values, n_values, depth, positions, n_positions, patch, box);
+      });
+
+    if (!native)
+      IBTK::LEInteractor::spread(data,
+                                 values,
+                                 n_values,
+                                 depth,
+                                 positions,
+                                 n_positions,
+                                 spacedim,
+                                 patch,
+                                 box,
+                                 kernel_name);
+  }
+
+
+
+  template <int spacedim, typename patch_type>
+  void
+  spread_to_patch(tbox::Pointer<patch_type>                  &data,
+                  const double                               *values,
+                  const int                                   n_values,
+                  const int                                   depth,
+                  const double                               *positions,
+                  const int                                   n_positions,
+                  const tbox::Pointer<hier::Patch<spacedim>> &patch,
+                  const hier::Box<spacedim>                  &box,
+                  const std::string                          &kernel_name)
+  {
+    spread_to_patch(data,
+                    values,
+                    n_values,
+                    depth,
+                    positions,
+                    n_positions,
+                    patch,
+                    box,
+                    kernel_name,
+                    get_native_ib_kernel(kernel_name));
+  }
+
+  // instantiations
+
+#define INSTANTIATE(patch_type)                                             \
+  template bool has_native_ib_kernel<NDIM, patch_type>(                     \
+    const NativeIBKernel kernel);                                           \
+  template bool has_native_ib_kernel<NDIM, patch_type>(                     \
+    const std::string &kernel_name);                                        \
+  template void interpolate_from_patch(                                     \
+    double                                 *values,                         \
+    const int                               n_values,                       \
+    const int                               depth,                          \
+    const double                           *positions,                      \
+    const int                               n_positions,                    \
+    const tbox::Pointer<patch_type>        &data,                           \
+    const tbox::Pointer<hier::Patch<NDIM>> &patch,                          \
+    const hier::Box<NDIM>                  &box,                            \
+    const std::string                      &kernel_name,                    \
+    const NativeIBKernel                    native_kernel);                 \
+  template void interpolate_from_patch(                                     \
+    double                                 *values,                         \
+    const int                               n_values,                       \
+    const int                               depth,                          \
+    const double                           *positions,                      \
+    const int                               n_positions,                    \
+    const tbox::Pointer<patch_type>        &data,                           \
+    const tbox::Pointer<hier::Patch<NDIM>> &patch,                          \
+    const hier::Box<NDIM>                  &box,                            \
+    const std::string                      &kernel_name);                   \
+  template void spread_to_patch(                                            \
+    tbox::Pointer<patch_type>              &data,                           \
+    const double                           *values,                         \
+    const int                               n_values,                       \
+    const int                               depth,                          \
+    const double                           *positions,                      \
+    const int                               n_positions,                    \
+    const tbox::Pointer<hier::Patch<NDIM>> &patch,                          \
+    const hier::Box<NDIM>                  &box,                            \
+    const std::string                      &kernel_name,                    \
+    const NativeIBKernel                    native_kernel);                 \
+  template void spread_to_patch(                                            \
+    tbox::Pointer<patch_type>              &data,                           \
+    const double                           *values,                         \
+    const int                               n_values,                       \
+    const int                               depth,                          \
+    const double                           *positions,                      \
+    const int                               n_positions,                    \
+    const tbox::Pointer<hier::Patch<NDIM>> &patch,                          \
+    const hier::Box<NDIM>                  &box,                            \
+    const std::string                      &kernel_name)
+
+  INSTANTIATE(pdat::CellData<NDIM, double>);
+  INSTANTIATE(pdat::EdgeData<NDIM, double>);
+  INSTANTIATE(pdat::NodeData<NDIM, double>);
+  INSTANTIATE(pdat::SideData<NDIM, double>);
+
+#undef INSTANTIATE
+} // namespace fdl
@@ -33,7 +33,10 @@
 #include <tbox/RestartManager.h>
 #include <tbox/TimerManager.h>
 
+#include <algorithm>
+#include <cmath>
 #include <deque>
+#include <functional>
 
 namespace
 {
@@ -63,6 +66,52 @@ namespace fdl
   using namespace dealii;
   using namespace SAMRAI;
 
+  namespace
+  {
+    // Bound the ratio between the largest displacement of any point in a
+    // cell and the largest displacement of any position DoF. This is the
+    // Lebesgue constant of the base element of the position element: 1 for
+    // linear elements, whose shape functions are nonnegative, and estimated
+    // by sampling the reference cell otherwise.
+    template <int dim, int spacedim>
+    double
+    compute_displacement_scale(const FiniteElement<dim, spacedim> &fe)
+    {
+      const FiniteElement<dim, spacedim> &base_fe = fe.base_element(0);
+      if (base_fe.degree <= 1)
+        return 1.0;
+
+      // sample on a lattice with spacing 1 / n_intervals
+      const unsigned int n_intervals = 4 * base_fe.degree;
+      const bool         is_simplex =
+        base_fe.reference_cell() != ReferenceCells::get_hypercube<dim>();
+      double scale = 1.0;
+      for (unsigned int index = 0;
+           index < Utilities::pow(n_intervals + 1, dim);
+           ++index)
+        {
+          Point<dim>   point;
+          unsigned int remainder = index;
+          unsigned int sum       = 0;
+          for (unsigned int d = 0; d < dim; ++d)
+            {
+              const unsigned int i = remainder % (n_intervals + 1);
+              remainder /= n_intervals + 1;
+              point[d] = double(i) / n_intervals;
+              sum += i;
+            }
+          if (is_simplex && sum > n_intervals)
+            continue;
+
+          double lebesgue_function = 0.0;
+          for (unsigned int i = 0; i < base_fe.dofs_per_cell; ++i)
+            lebesgue_function += std::abs(base_fe.shape_value(i, point));
+          scale = std::max(scale, lebesgue_function);
+        }
+      return scale;
+    }
+  } // namespace
+
   //
   // Initialization
   //
@@ -87,9 +136,13 @@ namespace fdl
                           input_db->getDatabase("GriddingAlgorithm"),
                           input_db->getDatabase("LoadBalancer"))
   {
-    // IBAMR does not support using threads so unconditionally disable them
-    // here.
-    MultithreadInfo::set_thread_limit(1);
+    // IBAMR does not support using threads so disable them by default. The
+    // interaction routines only use threads in code paths which do not call
+    // IBAMR.
+    const int n_threads = input_db->getIntegerWithDefault("n_threads", 1);
+    AssertThrow(n_threads > 0,
+                ExcMessage("The number of threads should be positive."));
+    MultithreadInfo::set_thread_limit(n_threads);
 
     const std::string interaction =
       input_db->getStringWithDefault("interaction", "ELEMENTAL");
@@ -115,12 +168,21 @@ namespace fdl
         else
           AssertThrow(false, ExcFDLNotImplemented());
 
+        const bool cache_interaction_plan =
+          input_db->getBoolWithDefault("cache_interaction_plan", false);
+        const bool morton_order_cells =
+          input_db->getBoolWithDefault("morton_order_cells", false);
+
         for (unsigned int part_n = 0; part_n < n_parts(); ++part_n)
           {
             const unsigned int n_points_1D =
               parts[part_n].get_dof_handler().get_fe().tensor_degree() + 1;
             interactions.emplace_back(new ElementalInteraction<dim, spacedim>(
-              n_points_1D, density, density_kind));
+              n_points_1D,
+              density,
+              density_kind,
+              cache_interaction_plan,
+              morton_order_cells));
             force_guesses.emplace_back(
               input_db->getIntegerWithDefault("n_guess_vectors", 10));
             velocity_guesses.emplace_back(
@@ -139,6 +201,16 @@ namespace fdl
                                "."));
       }
 
+    const bool reduced_precision_transfers =
+      input_db->getBoolWithDefault("reduced_precision_transfers", false);
+    for (auto &interaction : interactions)
+      interaction->set_reduced_precision_transfers(reduced_precision_transfers);
+
+    const double extra_ghost_cell_fraction =
+      input_db->getDoubleWithDefault("extra_ghost_cell_fraction", 1.0);
+    for (auto &interaction : interactions)
+      interaction->set_extra_ghost_cell_fraction(extra_ghost_cell_fraction);
+
     AssertThrow(input_db->keyExists("IB_kernel"),
                 ExcMessage(
                   "The IB kernel should be set in the input database."));
@@ -325,20 +397,37 @@ namespace fdl
             rhs_vecs[part_n]));
       }
 
-    // Compute:
-    for (unsigned int part_n = 0; part_n < n_parts(); ++part_n)
-      transactions[part_n] =
-        interactions[part_n]->compute_projection_rhs_intermediate(
-          std::move(transactions[part_n]));
-
-    // Collect:
-    for (unsigned int part_n = 0; part_n < n_parts(); ++part_n)
-      interactions[part_n]->compute_projection_rhs_finish(
-        std::move(transactions[part_n]));
-    // We cannot start the linear solve without first finishing this, so use a
-    // barrier to keep the timers accurate
-    const int ierr = MPI_Barrier(IBTK::IBTK_MPI::getCommunicator());
-    AssertThrowMPI(ierr);
+    // Compute and collect. Parts are processed in whatever order their
+    // communication finishes, except for the computations of fused
+    // interaction (which handles all parts at once).
+    std::function<std::unique_ptr<TransactionBase>(
+      std::size_t, std::unique_ptr<TransactionBase>)>
+      intermediate;
+    if (use_fused_interaction())
+      {
+        std::vector<const ElementalInteraction<dim, spacedim> *>
+          elemental_interactions;
+        for (const auto &interaction : interactions)
+          elemental_interactions.push_back(
+            &dynamic_cast<const ElementalInteraction<dim, spacedim> &>(
+              *interaction));
+        transactions = ElementalInteraction<dim, spacedim>::
+          fused_compute_projection_rhs_intermediate(elemental_interactions,
+                                                    std::move(transactions));
+      }
+    else
+      intermediate = [&](const std::size_t                part_n,
+                         std::unique_ptr<TransactionBase> t_ptr) {
+        return interactions[part_n]->compute_projection_rhs_intermediate(
+          std::move(t_ptr));
+      };
+
+    complete_transactions(
+      transactions,
+      intermediate,
+      [&](const std::size_t part_n, std::unique_ptr<TransactionBase> t_ptr) {
+        interactions[part_n]->compute_projection_rhs_finish(std::move(t_ptr));
+      });
     IBAMR_TIMER_STOP(t_interpolate_velocity_rhs);
 
     // Project:
@@ -428,15 +517,40 @@ namespace fdl
           part_vectors.get_force(part_n, data_time)));
       }
 
-    // Compute:
-    for (unsigned int part_n = 0; part_n < n_parts(); ++part_n)
-      transactions[part_n] = interactions[part_n]->compute_spread_intermediate(
-        std::move(transactions[part_n]));
-
-    // Collect:
-    for (unsigned int part_n = 0; part_n < n_parts(); ++part_n)
-      interactions[part_n]->compute_spread_finish(
-        std::move(transactions[part_n]));
+    // Compute and collect. Parts are finished in whatever order their
+    // communication finishes, but since every part adds into the same
+    // Eulerian data the spreading itself is always done in part order (or,
+    // with fused interaction, for all parts at once) so that the result does
+    // not depend on the timing of communication.
+    std::function<std::unique_ptr<TransactionBase>(
+      std::size_t, std::unique_ptr<TransactionBase>)>
+      intermediate;
+    if (use_fused_interaction())
+      {
+        std::vector<ElementalInteraction<dim, spacedim> *>
+          elemental_interactions;
+        for (auto &interaction : interactions)
+          elemental_interactions.push_back(
+            &dynamic_cast<ElementalInteraction<dim, spacedim> &>(
+              *interaction));
+        transactions = ElementalInteraction<dim, spacedim>::
+          fused_compute_spread_intermediate(elemental_interactions,
+                                            std::move(transactions));
+      }
+    else
+      intermediate = [&](const std::size_t                part_n,
+                         std::unique_ptr<TransactionBase> t_ptr) {
+        return interactions[part_n]->compute_spread_intermediate(
+          std::move(t_ptr));
+      };
+
+    complete_transactions(
+      transactions,
+      intermediate,
+      [&](const std::size_t part_n, std::unique_ptr<TransactionBase> t_ptr) {
+        interactions[part_n]->compute_spread_finish(std::move(t_ptr));
+      },
+      true);
 
     // Deal with force values spread outside the physical domain. Since these
     // are spread into ghost regions that don't correspond to actual degrees
@@ -696,6 +810,8 @@ namespace fdl
         IBAMR_TIMER_START(t_compute_lagrangian_force_pk1);
         compute_load_vector(part.get_dof_handler(),
                             part.get_mapping(),
+                            *part.get_matrix_free(),
+                            part.get_boundary_faces(),
                             part.get_force_contributions(),
                             data_time,
                             position,
@@ -759,14 +875,56 @@ namespace fdl
   // Data redistribution
   //
 
+  template <int dim, int spacedim>
+  bool
+  IFEDMethod<dim, spacedim>::use_fused_interaction() const
+  {
+    return input_db->getStringWithDefault("interaction", "ELEMENTAL") ==
+             "ELEMENTAL" &&
+           input_db->getBoolWithDefault("fuse_part_interactions", false);
+  }
+
+
+
   template <int dim, int spacedim>
   void
   IFEDMethod<dim, spacedim>::reinit_interactions()
   {
+    const bool lazy_reinit =
+      input_db->getBoolWithDefault("lazy_reinit_interactions", false);
     for (unsigned int part_n = 0; part_n < n_parts(); ++part_n)
       {
         const Part<dim, spacedim> &part = parts[part_n];
 
+        // Skip reinitialization if the interaction can keep its current
+        // setup, i.e., if the patches did not change and the part has not
+        // moved further than the extra ghost region.
+        if (lazy_reinit && part_n < interaction_positions.size())
+          {
+            const LinearAlgebra::distributed::Vector<double> &position =
+              part.get_position();
+            const LinearAlgebra::distributed::Vector<double> &old_position =
+              interaction_positions[part_n];
+            double max_displacement = 0.0;
+            for (unsigned int i = 0; i < position.locally_owned_size(); ++i)
+              max_displacement =
+                std::max(max_displacement,
+                         std::abs(position.local_element(i) -
+                                  old_position.local_element(i)));
+            // Points between the position DoFs may move further than the
+            // DoFs themselves for higher-degree elements.
+            max_displacement =
+              compute_displacement_scale(part.get_dof_handler().get_fe()) *
+              Utilities::MPI::max(max_displacement,
+                                  position.get_mpi_communicator());
+
+            if (interactions[part_n]->reinit_patches(
+                  secondary_hierarchy.getSecondaryHierarchy(),
+                  primary_hierarchy->getFinestLevelNumber(),
+                  max_displacement))
+              continue;
+          }
+
         const auto &tria =
           dynamic_cast<const parallel::shared::Triangulation<dim, spacedim> &>(
             part.get_triangulation());
@@ -816,6 +974,12 @@ namespace fdl
         // DoFHandler we always need
         interactions[part_n]->add_dof_handler(part.get_dof_handler());
         IBAMR_TIMER_STOP(t_reinit_interactions_objects);
+
+        if (lazy_reinit)
+          {
+            interaction_positions.resize(n_parts());
+            interaction_positions[part_n] = part.get_position();
+          }
       }
   }
 
@@ -867,16 +1031,18 @@ namespace fdl
               part.get_dof_handler()));
           }
 
-        // Compute:
-        for (unsigned int part_n = 0; part_n < n_parts(); ++part_n)
-          transactions[part_n] =
-            interactions[part_n]->add_workload_intermediate(
-              std::move(transactions[part_n]));
-
-        // Finish:
-        for (unsigned int part_n = 0; part_n < n_parts(); ++part_n)
-          interactions[part_n]->add_workload_finish(
-            std::move(transactions[part_n]));
+        // Compute and finish, in whatever order communication finishes:
+        complete_transactions(
+          transactions,
+          [&](const std::size_t                part_n,
+              std::unique_ptr<TransactionBase> t_ptr) {
+            return interactions[part_n]->add_workload_intermediate(
+              std::move(t_ptr));
+          },
+          [&](const std::size_t                part_n,
+              std::unique_ptr<TransactionBase> t_ptr) {
+            interactions[part_n]->add_workload_finish(std::move(t_ptr));
+          });
 
         // Move to primary hierarchy (we will read it back in
         // endDataRedistribution)
@@ -15,11 +15,15 @@
 
 #include <deal.II/numerics/rtree.h>
 
+#include <CartesianPatchGeometry.h>
+
 #include <boost/container/small_vector.hpp>
 
 #include <ibtk/IndexUtilities.h>
 #include <ibtk/LEInteractor.h>
 
+#include <algorithm>
+#include <limits>
 #include <memory>
 #include <vector>
 
@@ -28,6 +32,102 @@ namespace fdl
   using namespace dealii;
   using namespace SAMRAI;
 
+  void
+  complete_transactions(
+    std::vector<std::unique_ptr<TransactionBase>> &transactions,
+    const std::function<std::unique_ptr<TransactionBase>(
+      std::size_t,
+      std::unique_ptr<TransactionBase>)> &intermediate,
+    const std::function<void(std::size_t, std::unique_ptr<TransactionBase>)>
+              &finish,
+    const bool ordered_intermediate)
+  {
+    const std::size_t n_transactions = transactions.size();
+    std::vector<bool> intermediate_done(n_transactions, !intermediate);
+    std::vector<bool> finish_done(n_transactions, false);
+
+    // Perform the next step of a transaction:
+    std::size_t n_remaining = n_transactions;
+    auto        advance     = [&](const std::size_t i) {
+      if (!intermediate_done[i])
+        {
+          transactions[i]      = intermediate(i, std::move(transactions[i]));
+          intermediate_done[i] = true;
+        }
+      else
+        {
+          finish(i, std::move(transactions[i]));
+          finish_done[i] = true;
+          --n_remaining;
+        }
+    };
+
+    // With ordered intermediate steps, transaction i can only perform its
+    // intermediate step after transaction i - 1 has:
+    auto may_advance = [&](const std::size_t i) {
+      return !finish_done[i] &&
+             (intermediate_done[i] || !ordered_intermediate || i == 0 ||
+              intermediate_done[i - 1]);
+    };
+
+    while (n_remaining > 0)
+      {
+        bool progress = false;
+        for (std::size_t i = 0; i < n_transactions; ++i)
+          if (may_advance(i) && transactions[i]->ready())
+            {
+              advance(i);
+              progress = true;
+            }
+
+        // Nothing is ready, so wait. Intermediate steps only wait on
+        // communication posted by start steps (which already happened on
+        // every process) so do those first.
+        if (!progress)
+          {
+            std::size_t next = 0;
+            while (next < n_transactions && intermediate_done[next])
+              ++next;
+            if (next == n_transactions)
+              {
+                next = 0;
+                while (finish_done[next])
+                  ++next;
+              }
+            advance(next);
+          }
+      }
+  }
+
+
+
+  namespace
+  {
+    // FNV-1a hash of the DoF indices of all locally owned cells. This detects
+    // renumberings (e.g., DoFRenumbering::Cuthill_McKee()) which do not change
+    // the set of locally owned DoFs.
+    template <int dim, int spacedim>
+    std::size_t
+    compute_dof_numbering_hash(const DoFHandler<dim, spacedim> &dof_handler)
+    {
+      std::size_t                          hash = 14695981039346656037ull;
+      std::vector<types::global_dof_index> dofs;
+      for (const auto &cell : dof_handler.active_cell_iterators())
+        if (cell->is_locally_owned())
+          {
+            dofs.resize(cell->get_fe().dofs_per_cell);
+            cell->get_dof_indices(dofs);
+            const auto bytes = reinterpret_cast<const unsigned char *>(
+              dofs.data());
+            for (std::size_t i = 0; i < dofs.size() * sizeof(dofs[0]); ++i)
+              hash = (hash ^ bytes[i]) * 1099511628211ull;
+          }
+      return hash;
+    }
+  } // namespace
+
+
+
   template <int dim, int spacedim>
   InteractionBase<dim, spacedim>::InteractionBase()
     : communicator(MPI_COMM_NULL)
@@ -98,88 +198,125 @@ namespace fdl
     AssertIndexRange(l_number, patch_hierarchy->getNumberOfLevels());
 
     // Set up the patch map:
+    bool overlap_tria_changed = false;
     {
       const auto patches =
         extract_patches(patch_hierarchy->getPatchLevel(level_number));
-      // TODO we need to make extra ghost cell fraction a parameter
+      patch_boxes.clear();
+      double local_dx_min = std::numeric_limits<double>::max();
+      for (const auto &patch : patches)
+        {
+          patch_boxes.push_back(patch->getBox());
+          const tbox::Pointer<geom::CartesianPatchGeometry<spacedim>>
+                              geometry = patch->getPatchGeometry();
+          const double *const dx       = geometry->getDx();
+          local_dx_min =
+            std::min(local_dx_min, *std::min_element(dx, dx + spacedim));
+        }
+      patch_dx_min = Utilities::MPI::min(local_dx_min, communicator);
+
       const std::vector<BoundingBox<spacedim>> patch_bboxes =
-        compute_patch_bboxes(patches, 1.0);
+        compute_patch_bboxes(patches, extra_ghost_cell_fraction);
       BoxIntersectionPredicate<dim, spacedim> predicate(
         global_active_cell_bboxes, patch_bboxes, *native_tria);
-      overlap_tria.reinit(*native_tria, predicate);
-
-      // Yes, this is much more complex than necessary since
-      // global_active_cell_bboxes is an argument to this function, but we don't
-      // want to rely on that and p::s::T more than we have to since that
-      // approach ultimately needs to go.
-      //
-      // TODO - we should refactor this into a more general function so we can
-      // test it
-      std::vector<CellId> bbox_cellids;
-      for (const auto &cell : overlap_tria.active_cell_iterators())
-        bbox_cellids.push_back(overlap_tria.get_native_cell_id(cell));
-
-      // 1. Figure out who owns the bounding boxes we need:
-      std::vector<types::subdomain_id> ranks =
-        GridTools::get_subdomain_association(*native_tria, bbox_cellids);
-
-      // 2. Send each processor the list of bboxes we need:
-      std::map<types::subdomain_id,
-               std::vector<std::pair<unsigned int, CellId>>>
-        corresponding_requested_cellids;
-      // Keep the overlap active cell index along for the ride
-      for (unsigned int i = 0; i < ranks.size(); ++i)
-        corresponding_requested_cellids[ranks[i]].emplace_back(i,
-                                                               bbox_cellids[i]);
-
-      const std::map<types::subdomain_id,
-                     std::vector<std::pair<unsigned int, CellId>>>
-        corresponding_cellids_to_send =
-          Utilities::MPI::some_to_some(communicator,
-                                       corresponding_requested_cellids);
-
-      // 3. Send each processor the actual bboxes:
-      std::map<
-        types::subdomain_id,
-        std::vector<std::pair<unsigned int, BoundingBox<spacedim, float>>>>
-        requested_bboxes;
-      for (const auto &pair : corresponding_cellids_to_send)
-        {
-          const auto  rank                = pair.first;
-          const auto &indices_and_cellids = pair.second;
+      overlap_tria_changed = overlap_tria.reinit(*native_tria, predicate);
 
-          auto &bboxes = requested_bboxes[rank];
-          for (const auto &index_and_cellid : indices_and_cellids)
+      std::vector<BoundingBox<spacedim, float>> overlap_bboxes(
+        overlap_tria.n_active_cells());
+      if (!native_tria->with_artificial_cells())
+        {
+          // Every processor has every cell, so we can look up the bounding
+          // boxes directly without any communication.
+          for (const auto &cell : overlap_tria.active_cell_iterators())
+            overlap_bboxes[cell->active_cell_index()] =
+              global_active_cell_bboxes[overlap_tria.get_native_cell(cell)
+                                          ->active_cell_index()];
+        }
+      else
+        {
+          // Yes, this is much more complex than necessary since
+          // global_active_cell_bboxes is an argument to this function, but we
+          // don't want to rely on that and p::s::T more than we have to since
+          // that approach ultimately needs to go. Processors will only know
+          // about some cells with distributed Triangulations, so use the same
+          // algorithm here when p::s::T has artificial cells.
+          //
+          // TODO - we should refactor this into a more general function so we
+          // can test it
+          std::vector<CellId> bbox_cellids;
+          for (const auto &cell : overlap_tria.active_cell_iterators())
+            bbox_cellids.push_back(overlap_tria.get_native_cell_id(cell));
+
+          // 1. Figure out who owns the bounding boxes we need:
+          std::vector<types::subdomain_id> ranks =
+            GridTools::get_subdomain_association(*native_tria, bbox_cellids);
+
+          // 2. Send each processor the list of bboxes we need:
+          std::map<types::subdomain_id,
+                   std::vector<std::pair<unsigned int, CellId>>>
+            corresponding_requested_cellids;
+          // Keep the overlap active cell index along for the ride
+          for (unsigned int i = 0; i < ranks.size(); ++i)
+            corresponding_requested_cellids[ranks[i]].emplace_back(
+              i, bbox_cellids[i]);
+
+          const std::map<types::subdomain_id,
+                         std::vector<std::pair<unsigned int, CellId>>>
+            corresponding_cellids_to_send =
+              Utilities::MPI::some_to_some(communicator,
+                                           corresponding_requested_cellids);
+
+          // 3. Send each processor the actual bboxes:
+          std::map<
+            types::subdomain_id,
+            std::vector<std::pair<unsigned int, BoundingBox<spacedim, float>>>>
+            requested_bboxes;
+          for (const auto &pair : corresponding_cellids_to_send)
             {
-              auto it =
-                native_tria->create_cell_iterator(index_and_cellid.second);
-              bboxes.emplace_back(
-                index_and_cellid.first,
-                global_active_cell_bboxes[it->active_cell_index()]);
+              const auto  rank                = pair.first;
+              const auto &indices_and_cellids = pair.second;
+
+              auto &bboxes = requested_bboxes[rank];
+              for (const auto &index_and_cellid : indices_and_cellids)
+                {
+                  auto it =
+                    native_tria->create_cell_iterator(index_and_cellid.second);
+                  bboxes.emplace_back(
+                    index_and_cellid.first,
+                    global_active_cell_bboxes[it->active_cell_index()]);
+                }
             }
-        }
 
-      const auto received_bboxes =
-        Utilities::MPI::some_to_some(communicator, requested_bboxes);
+          const auto received_bboxes =
+            Utilities::MPI::some_to_some(communicator, requested_bboxes);
 
-      std::vector<BoundingBox<spacedim, float>> overlap_bboxes(
-        overlap_tria.n_active_cells());
-      for (const auto &pair : received_bboxes)
-        for (const auto &index_and_bbox : pair.second)
-          {
-            AssertIndexRange(index_and_bbox.first, overlap_bboxes.size());
-            overlap_bboxes[index_and_bbox.first] = index_and_bbox.second;
-          }
+          for (const auto &pair : received_bboxes)
+            for (const auto &index_and_bbox : pair.second)
+              {
+                AssertIndexRange(index_and_bbox.first, overlap_bboxes.size());
+                overlap_bboxes[index_and_bbox.first] = index_and_bbox.second;
+              }
+        }
 
-      // TODO add the ghost cell width as an input argument to this class
-      patch_map.reinit(patches, 1.0, overlap_tria, overlap_bboxes);
+      patch_map.reinit(patches,
+                       extra_ghost_cell_fraction,
+                       overlap_tria,
+                       overlap_bboxes);
     }
 
-    // clear old dof info:
-    native_dof_handlers.clear();
-    overlap_dof_handlers.clear();
-    overlap_to_native_dof_translations.clear();
-    scatters.clear();
+    // If the overlap triangulation did not change then the overlap DoFs, the
+    // DoF translations, and the Scatter objects (which depend only on those
+    // translations) are still valid provided that the native DoFs did not
+    // change - add_dof_handler() checks that. Otherwise clear old dof info:
+    if (overlap_tria_changed)
+      {
+        native_dof_handlers.clear();
+        native_locally_owned_dofs.clear();
+        native_dof_numbering_hashes.clear();
+        overlap_dof_handlers.clear();
+        overlap_to_native_dof_translations.clear();
+        scatters.clear();
+      }
   }
 
 
@@ -235,6 +372,28 @@ namespace fdl
 
 
 
+  template <int dim, int spacedim>
+  void
+  InteractionBase<dim, spacedim>::finish_spread_scatters(
+    Transaction<dim, spacedim> &transaction)
+  {
+    if (transaction.packed_spread_scatter)
+      {
+        transaction.position_scatter.global_to_overlap_finish(
+          {transaction.native_position, transaction.native_solution},
+          {&transaction.overlap_position, &transaction.overlap_solution});
+      }
+    else
+      {
+        transaction.position_scatter.global_to_overlap_finish(
+          *transaction.native_position, transaction.overlap_position);
+        transaction.solution_scatter.global_to_overlap_finish(
+          *transaction.native_solution, transaction.overlap_solution);
+      }
+  }
+
+
+
   template <int dim, int spacedim>
   Scatter<double>
   InteractionBase<dim, spacedim>::get_scatter(
@@ -288,7 +447,47 @@ namespace fdl
     if (index >= scatters.size())
       scatters.resize(index + 1);
     std::vector<Scatter<double>> &this_dh_scatters = scatters[index];
-    this_dh_scatters.emplace_back(scatter);
+    this_dh_scatters.emplace_back(std::move(scatter));
+  }
+
+
+
+  template <int dim, int spacedim>
+  bool
+  InteractionBase<dim, spacedim>::dof_handler_is_current(
+    const DoFHandler<dim, spacedim> &native_dof_handler)
+  {
+    auto iter = std::find(native_dof_handlers.begin(),
+                          native_dof_handlers.end(),
+                          &native_dof_handler);
+    if (iter == native_dof_handlers.end())
+      return false;
+
+    const std::size_t index = iter - native_dof_handlers.begin();
+    Assert(index < native_locally_owned_dofs.size(), ExcFDLInternalError());
+    Assert(index < native_dof_numbering_hashes.size(), ExcFDLInternalError());
+    // The DoF translation and Scatters must agree on every processor, so
+    // all processors must make the same decision here. Renumbering DoFs may
+    // not change the locally owned DoFs so check the numbering too.
+    const int changed =
+      native_locally_owned_dofs[index] !=
+        native_dof_handler.locally_owned_dofs() ||
+      native_dof_numbering_hashes[index] !=
+        compute_dof_numbering_hash(native_dof_handler);
+    if (Utilities::MPI::max(changed, communicator) == 0)
+      return true;
+
+    native_dof_handlers.erase(iter);
+    native_locally_owned_dofs.erase(native_locally_owned_dofs.begin() +
+                                    index);
+    native_dof_numbering_hashes.erase(native_dof_numbering_hashes.begin() +
+                                      index);
+    overlap_dof_handlers.erase(overlap_dof_handlers.begin() + index);
+    overlap_to_native_dof_translations.erase(
+      overlap_to_native_dof_translations.begin() + index);
+    if (index < scatters.size())
+      scatters.erase(scatters.begin() + index);
+    return false;
   }
 
 
@@ -302,11 +501,13 @@ namespace fdl
                 ExcMessage("The DoFHandler must use the underlying native "
                            "triangulation."));
     const auto ptr = &native_dof_handler;
-    if (std::find(native_dof_handlers.begin(),
-                  native_dof_handlers.end(),
-                  ptr) == native_dof_handlers.end())
+    if (!dof_handler_is_current(native_dof_handler))
       {
         native_dof_handlers.emplace_back(ptr);
+        native_locally_owned_dofs.emplace_back(
+          native_dof_handler.locally_owned_dofs());
+        native_dof_numbering_hashes.emplace_back(
+          compute_dof_numbering_hash(native_dof_handler));
         // TODO - implement a move ctor for DH in deal.II
         overlap_dof_handlers.emplace_back(
           std::make_unique<DoFHandler<dim, spacedim>>(overlap_tria));
@@ -370,6 +571,7 @@ namespace fdl
     Transaction<dim, spacedim> &transaction = *t_ptr;
     // set up everything we will need later
     transaction.kernel_name      = kernel_name;
+    transaction.native_kernel    = get_native_ib_kernel(kernel_name);
     transaction.current_data_idx = data_idx;
 
     // Setup position info:
@@ -497,6 +699,7 @@ namespace fdl
     Transaction<dim, spacedim> &transaction = *t_ptr;
     // set up everything we will need later
     transaction.kernel_name      = kernel_name;
+    transaction.native_kernel    = get_native_ib_kernel(kernel_name);
     transaction.current_data_idx = data_idx;
 
     // Setup position info:
@@ -508,8 +711,12 @@ namespace fdl
 
     // Setup solution info:
     transaction.native_dof_handler = &dof_handler;
-    transaction.solution_scatter   = get_scatter(dof_handler);
-    transaction.mapping            = &mapping;
+    // If possible, send position and solution values together to halve the
+    // number of messages:
+    transaction.packed_spread_scatter = &position_dof_handler == &dof_handler;
+    if (!transaction.packed_spread_scatter)
+      transaction.solution_scatter = get_scatter(dof_handler);
+    transaction.mapping = &mapping;
     transaction.native_solution    = &solution;
     transaction.overlap_solution.reinit(
       get_overlap_dof_handler(dof_handler).n_dofs());
@@ -522,11 +729,28 @@ namespace fdl
 
     // Since we set up our own communicator in this object we can fearlessly use
     // channels 0 and 1 to guarantee traffic is not accidentally mingled
-    transaction.position_scatter.global_to_overlap_start(
-      *transaction.native_position, 0, transaction.overlap_position);
-
-    transaction.solution_scatter.global_to_overlap_start(
-      *transaction.native_solution, 1, transaction.overlap_solution);
+    if (transaction.packed_spread_scatter)
+      {
+        transaction.position_scatter.global_to_overlap_start(
+          {transaction.native_position, transaction.native_solution},
+          0,
+          {&transaction.overlap_position, &transaction.overlap_solution},
+          reduced_precision_transfers);
+      }
+    else
+      {
+        transaction.position_scatter.global_to_overlap_start(
+          *transaction.native_position,
+          0,
+          transaction.overlap_position,
+          reduced_precision_transfers);
+
+        transaction.solution_scatter.global_to_overlap_start(
+          *transaction.native_solution,
+          1,
+          transaction.overlap_solution,
+          reduced_precision_transfers);
+      }
 
     return t_ptr;
   }
@@ -546,10 +770,7 @@ namespace fdl
             Transaction<dim, spacedim>::State::Intermediate),
            ExcMessage("Transaction state should be Intermediate"));
 
-    trans.position_scatter.global_to_overlap_finish(*trans.native_position,
-                                                    trans.overlap_position);
-    trans.solution_scatter.global_to_overlap_finish(*trans.native_solution,
-                                                    trans.overlap_solution);
+    finish_spread_scatters(trans);
 
     // this is the point at which a base class would normally do computations.
 
@@ -578,8 +799,9 @@ namespace fdl
 
     return_scatter(*trans.native_position_dof_handler,
                    std::move(trans.position_scatter));
-    return_scatter(*trans.native_dof_handler,
-                   std::move(trans.solution_scatter));
+    if (!trans.packed_spread_scatter)
+      return_scatter(*trans.native_dof_handler,
+                     std::move(trans.solution_scatter));
   }
 
   template <int dim, int spacedim>
@@ -606,7 +828,10 @@ namespace fdl
       WorkloadTransaction<dim, spacedim>::State::Intermediate;
 
     transaction.position_scatter.global_to_overlap_start(
-      *transaction.native_position, 0, transaction.overlap_position);
+      *transaction.native_position,
+      0,
+      transaction.overlap_position,
+      reduced_precision_transfers);
 
     return t_ptr;
   }
@@ -635,6 +860,71 @@ namespace fdl
                          std::move(trans.position_scatter));
   }
 
+
+
+  template <int dim, int spacedim>
+  void
+  InteractionBase<dim, spacedim>::set_reduced_precision_transfers(
+    const bool use_reduced_precision)
+  {
+    reduced_precision_transfers = use_reduced_precision;
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  InteractionBase<dim, spacedim>::set_extra_ghost_cell_fraction(
+    const double fraction)
+  {
+    AssertThrow(fraction >= 0.0,
+                ExcMessage("The extra ghost cell fraction must be "
+                           "nonnegative."));
+    extra_ghost_cell_fraction = fraction;
+  }
+
+
+
+  template <int dim, int spacedim>
+  bool
+  InteractionBase<dim, spacedim>::reinit_patches(
+    tbox::Pointer<hier::BasePatchHierarchy<spacedim>> p_hierarchy,
+    const int                                         l_number,
+    const double                                      max_displacement)
+  {
+    Assert(p_hierarchy,
+           ExcMessage("The provided pointer to a patch hierarchy should not be "
+                      "null."));
+    // Every processor has to make the same decision since reinit() is
+    // collective. The structure may move up to one more Eulerian cell
+    // before the next regrid, so keep room for that in the extra ghost
+    // region.
+    int can_reuse =
+      l_number == level_number &&
+      l_number < p_hierarchy->getNumberOfLevels() &&
+      max_displacement < (extra_ghost_cell_fraction - 1.0) * patch_dx_min;
+    std::vector<tbox::Pointer<hier::Patch<spacedim>>> patches;
+    if (can_reuse)
+      {
+        patches = extract_patches(p_hierarchy->getPatchLevel(l_number));
+        if (patches.size() != patch_boxes.size())
+          can_reuse = false;
+        else
+          for (std::size_t patch_n = 0; patch_n < patches.size(); ++patch_n)
+            if (!(patches[patch_n]->getBox() == patch_boxes[patch_n]))
+              {
+                can_reuse = false;
+                break;
+              }
+      }
+    if (Utilities::MPI::min(can_reuse, communicator) == 0)
+      return false;
+
+    patch_hierarchy = p_hierarchy;
+    patch_map.reinit_patches(patches);
+    return true;
+  }
+
   // instantiations
 
   template class InteractionBase<NDIM - 1, NDIM>;
@@ -2,21 +2,32 @@
 
 #include <fiddle/grid/box_utilities.h>
 
+#include <fiddle/interaction/cell_rhs_kernels.h>
+#include <fiddle/interaction/ib_kernels.h>
 #include <fiddle/interaction/interaction_utilities.h>
+#include <fiddle/interaction/tensor_product_evaluator.h>
 
 #include <fiddle/transfer/overlap_partitioning_tools.h>
 
+#include <deal.II/base/parallel.h>
+
 #include <deal.II/fe/fe_nothing.h>
 #include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_fe_field.h>
 
 #include <deal.II/numerics/rtree.h>
 
 #include <boost/container/small_vector.hpp>
 
 #include <ibtk/IndexUtilities.h>
-#include <ibtk/LEInteractor.h>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
 #include <memory>
+#include <numeric>
 #include <type_traits>
 #include <vector>
 
@@ -71,6 +82,181 @@ namespace fdl
                  ExcMessage("Not enough quadrature rules"));
         }
     }
+
+
+
+    /**
+     * Collection of FEValues objects, one per quadrature rule, which are only
+     * set up when they are first used. We probably don't need more than 16
+     * quadrature rules.
+     */
+    template <int dim, int spacedim>
+    using FEValuesCollection =
+      boost::container::small_vector<std::unique_ptr<FEValues<dim, spacedim>>,
+                                     16>;
+
+    template <int dim, int spacedim>
+    FEValues<dim, spacedim> &
+    get_fe_values(FEValuesCollection<dim, spacedim>  &collection,
+                  const unsigned char                 quad_index,
+                  const Mapping<dim, spacedim>       &mapping,
+                  const FiniteElement<dim, spacedim> &fe,
+                  const std::vector<Quadrature<dim>> &quadratures,
+                  const UpdateFlags                   update_flags)
+    {
+      AssertIndexRange(quad_index, quadratures.size());
+      if (collection.size() < quadratures.size())
+        collection.resize(quadratures.size());
+      if (!collection[quad_index])
+        collection[quad_index] = std::make_unique<FEValues<dim, spacedim>>(
+          mapping, fe, quadratures[quad_index], update_flags);
+      return *collection[quad_index];
+    }
+
+    /**
+     * Number of cells each task should work on at once.
+     */
+    constexpr std::size_t cell_grainsize = 32;
+
+    /**
+     * Convert an iterator stored in an InteractionPlan into a DoFHandler
+     * iterator.
+     */
+    template <int dim, int spacedim>
+    typename DoFHandler<dim, spacedim>::active_cell_iterator
+    to_dof_cell(
+      const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+      const DoFHandler<dim, spacedim> &dof_handler)
+    {
+      Assert(&cell->get_triangulation() == &dof_handler.get_triangulation(),
+             ExcMessage("The InteractionPlan and DoFHandler should use the "
+                        "same Triangulation."));
+      return typename DoFHandler<dim, spacedim>::active_cell_iterator(
+        &dof_handler.get_triangulation(),
+        cell->level(),
+        cell->index(),
+        &dof_handler);
+    }
+
+    /**
+     * Check that @p plan was computed with @p patch_map.
+     */
+    template <int dim, int spacedim>
+    void
+    check_plan(const InteractionPlan<dim, spacedim> &plan,
+               const PatchMap<dim, spacedim>        &patch_map)
+    {
+      (void)plan;
+      (void)patch_map;
+      Assert(plan.patch_cell_offsets.size() == patch_map.size() + 1,
+             ExcMessage("The InteractionPlan should have been computed with "
+                        "the same PatchMap."));
+    }
+
+    /**
+     * Set up everything in @p plan except the quadrature point positions,
+     * which are set to zero.
+     */
+    template <int dim, int spacedim>
+    void
+    setup_plan_cells(const PatchMap<dim, spacedim>      &patch_map,
+                     const std::vector<unsigned char>   &quadrature_indices,
+                     const std::vector<Quadrature<dim>> &quadratures,
+                     InteractionPlan<dim, spacedim>     &plan)
+    {
+      const Triangulation<dim, spacedim> &tria = patch_map.get_triangulation();
+      check_quadratures(quadrature_indices, quadratures, tria);
+
+      // PatchMap only supports looping over DoFHandler iterators, so we need
+      // to make one and never use it explicitly
+      // No mixed meshes yet
+      Assert(tria.get_reference_cells().size() == 1, ExcNotImplemented());
+      const ReferenceCell reference_cell = tria.get_reference_cells().front();
+      FE_Nothing<dim, spacedim> fe_nothing(reference_cell);
+      DoFHandler<dim, spacedim> dof_handler(tria);
+      dof_handler.distribute_dofs(fe_nothing);
+
+      // Storing the cells (and the offsets of their quadrature points)
+      // contiguously lets us split work between threads in chunks of cells
+      // rather than whole patches, which matters since the number of cells
+      // per patch varies a lot.
+      plan.cells.clear();
+      plan.patch_cell_offsets.clear();
+      plan.cell_q_point_offsets.clear();
+      plan.patch_cell_offsets.push_back(0);
+      plan.cell_q_point_offsets.push_back(0);
+      for (unsigned int patch_n = 0; patch_n < patch_map.size(); ++patch_n)
+        {
+          auto       iter = patch_map.begin(patch_n, dof_handler);
+          const auto end  = patch_map.end(patch_n, dof_handler);
+          for (; iter != end; ++iter)
+            {
+              const auto cell = *iter;
+              plan.cells.emplace_back(&tria, cell->level(), cell->index());
+              plan.cell_q_point_offsets.push_back(
+                plan.cell_q_point_offsets.back() +
+                quadratures[quadrature_indices[cell->active_cell_index()]]
+                  .size());
+            }
+          plan.patch_cell_offsets.push_back(plan.cells.size());
+        }
+
+      plan.q_points.clear();
+      plan.q_points.resize(spacedim * plan.n_q_points());
+    }
+
+    /**
+     * Copy the quadrature points of @p fe_values into @p q_points in
+     * point-first ordering.
+     */
+    template <int dim, int spacedim>
+    void
+    copy_q_points(const FEValues<dim, spacedim> &fe_values, double *q_points)
+    {
+      for (const Point<spacedim> &q_point : fe_values.get_quadrature_points())
+        {
+          for (unsigned int d = 0; d < spacedim; ++d)
+            q_points[d] = q_point[d];
+          q_points += spacedim;
+        }
+    }
+
+    /**
+     * Call @p f on each patch index - in parallel if @p use_threads is true.
+     */
+    template <typename F>
+    void
+    for_each_patch(const std::size_t n_patches, const bool use_threads, F &&f)
+    {
+      if (use_threads)
+        parallel::apply_to_subranges(
+          std::size_t(0),
+          n_patches,
+          [&](const std::size_t begin, const std::size_t end) {
+            for (std::size_t patch_n = begin; patch_n < end; ++patch_n)
+              f(patch_n);
+          },
+          1);
+      else
+        for (std::size_t patch_n = 0; patch_n < n_patches; ++patch_n)
+          f(patch_n);
+    }
+
+    /**
+     * Compute a Morton key by interleaving the bits of @p indices. Only the
+     * lowest 64 / spacedim bits of each index are used.
+     */
+    template <int spacedim>
+    std::uint64_t
+    morton_key(const std::array<std::uint64_t, spacedim> &indices)
+    {
+      constexpr unsigned int n_bits = 64 / spacedim;
+      std::uint64_t          key    = 0;
+      for (unsigned int b = 0; b < n_bits; ++b)
+        for (unsigned int d = 0; d < spacedim; ++d)
+          key |= ((indices[d] >> b) & std::uint64_t(1)) << (b * spacedim + d);
+      return key;
+    }
   } // namespace
 
 
@@ -199,73 +385,388 @@ namespace fdl
 
 
 
-  template <int dim, int spacedim, typename Scalar>
+  template <int dim, int spacedim>
   void
-  count_quadrature_points_internal(
-    const int                           qp_data_idx,
-    PatchMap<dim, spacedim>            &patch_map,
-    const Mapping<dim, spacedim>       &position_mapping,
+  compute_interaction_plan(const PatchMap<dim, spacedim>    &patch_map,
+                           const Mapping<dim, spacedim>     &position_mapping,
+                           const std::vector<unsigned char> &quadrature_indices,
+                           const std::vector<Quadrature<dim>> &quadratures,
+                           InteractionPlan<dim, spacedim>     &plan)
+  {
+    setup_plan_cells(patch_map, quadrature_indices, quadratures, plan);
+
+    // Compute the positions in parallel. The FE is arbitrary - the actual
+    // position FE is in position_mapping.
+    const Triangulation<dim, spacedim> &tria = patch_map.get_triangulation();
+    const FE_Nothing<dim, spacedim>     fe_nothing(
+      tria.get_reference_cells().front());
+    parallel::apply_to_subranges(
+      std::size_t(0),
+      plan.n_cells(),
+      [&](const std::size_t begin, const std::size_t end) {
+        FEValuesCollection<dim, spacedim> all_position_fe_values;
+        for (std::size_t cell_n = begin; cell_n < end; ++cell_n)
+          {
+            const auto              &cell = plan.cells[cell_n];
+            FEValues<dim, spacedim> &position_fe_values =
+              get_fe_values(all_position_fe_values,
+                            quadrature_indices[cell->active_cell_index()],
+                            position_mapping,
+                            fe_nothing,
+                            quadratures,
+                            update_quadrature_points);
+            position_fe_values.reinit(cell);
+            copy_q_points(position_fe_values,
+                          plan.q_points.data() +
+                            spacedim * plan.cell_q_point_offsets[cell_n]);
+          }
+      },
+      cell_grainsize);
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  compute_interaction_plan(
+    const PatchMap<dim, spacedim>      &patch_map,
+    const DoFHandler<dim, spacedim>    &position_dof_handler,
+    const Vector<double>               &position,
     const std::vector<unsigned char>   &quadrature_indices,
-    const std::vector<Quadrature<dim>> &quadratures)
+    const std::vector<Quadrature<dim>> &quadratures,
+    InteractionPlan<dim, spacedim>     &plan)
+  {
+    setup_plan_cells(patch_map, quadrature_indices, quadratures, plan);
+
+    const FiniteElement<dim, spacedim> &position_fe =
+      position_dof_handler.get_fe();
+    AssertThrow(position_fe.n_components() == spacedim,
+                ExcMessage("The position should have spacedim components."));
+
+    // Use sum factorization with whichever quadrature rules support it and
+    // MappingFEField with the rest.
+    std::vector<std::unique_ptr<TensorProductEvaluator<dim, spacedim>>>
+      evaluators(quadratures.size());
+    for (unsigned int quad_n = 0; quad_n < quadratures.size(); ++quad_n)
+      if (TensorProductEvaluator<dim, spacedim>::is_supported(
+            position_fe, quadratures[quad_n]))
+        evaluators[quad_n] =
+          std::make_unique<TensorProductEvaluator<dim, spacedim>>(
+            position_fe, quadratures[quad_n]);
+    const MappingFEField<dim, spacedim, Vector<double>> position_mapping(
+      position_dof_handler, position);
+
+    parallel::apply_to_subranges(
+      std::size_t(0),
+      plan.n_cells(),
+      [&](const std::size_t begin, const std::size_t end) {
+        FEValuesCollection<dim, spacedim> all_position_fe_values;
+        std::vector<double>               cell_position(
+          position_fe.dofs_per_cell);
+        std::vector<double> scratch;
+        for (std::size_t cell_n = begin; cell_n < end; ++cell_n)
+          {
+            const auto cell =
+              to_dof_cell(plan.cells[cell_n], position_dof_handler);
+            const unsigned char quad_index =
+              quadrature_indices[cell->active_cell_index()];
+            double *const cell_q_points =
+              plan.q_points.data() +
+              spacedim * plan.cell_q_point_offsets[cell_n];
+            if (evaluators[quad_index])
+              {
+                cell->get_dof_values(position,
+                                     cell_position.begin(),
+                                     cell_position.end());
+                evaluators[quad_index]->evaluate(cell_position.data(),
+                                                 cell_q_points,
+                                                 scratch);
+              }
+            else
+              {
+                FEValues<dim, spacedim> &position_fe_values =
+                  get_fe_values(all_position_fe_values,
+                                quad_index,
+                                position_mapping,
+                                position_fe,
+                                quadratures,
+                                update_quadrature_points);
+                position_fe_values.reinit(cell);
+                copy_q_points(position_fe_values, cell_q_points);
+              }
+          }
+      },
+      cell_grainsize);
+  }
+
+
+
+  template <int dim, int spacedim>
+  bool
+  supports_shape_value_cache(const FiniteElement<dim, spacedim> &fe)
+  {
+    // Shape function values of elements like FE_Q do not depend on the
+    // mapping, but those of other elements (e.g., FE_RaviartThomas) do.
+    return fe.is_primitive() &&
+           fe.requires_update_flags(update_values) == update_values;
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  morton_order_interaction_plan(const PatchMap<dim, spacedim> &patch_map,
+                                InteractionPlan<dim, spacedim> &plan)
+  {
+    check_plan(plan, patch_map);
+
+    // tbox::Pointer is not thread-safe so get what we need from the patch
+    // geometries first
+    std::vector<std::array<double, spacedim>> patch_x_lowers(patch_map.size());
+    std::vector<std::array<double, spacedim>> patch_dxs(patch_map.size());
+    for (unsigned int patch_n = 0; patch_n < patch_map.size(); ++patch_n)
+      {
+        const tbox::Pointer<geom::CartesianPatchGeometry<spacedim>> geometry =
+          patch_map.get_patch(patch_n)->getPatchGeometry();
+        Assert(geometry, ExcMessage("Type mismatch"));
+        for (unsigned int d = 0; d < spacedim; ++d)
+          {
+            patch_x_lowers[patch_n][d] = geometry->getXLower()[d];
+            patch_dxs[patch_n][d]      = geometry->getDx()[d];
+          }
+      }
+
+    // Each patch has its own range of cells and quadrature points so we can
+    // sort in parallel.
+    for_each_patch(patch_map.size(), true, [&](const std::size_t patch_n) {
+      const std::size_t cell_begin = plan.patch_cell_offsets[patch_n];
+      const std::size_t n_cells = plan.patch_cell_offsets[patch_n + 1] -
+                                  cell_begin;
+      if (n_cells == 0)
+        return;
+      const std::size_t q_point_begin = plan.patch_q_point_offset(patch_n);
+
+      // Cells may lie partially outside the patch so shift the Eulerian cell
+      // indices to make them nonnegative.
+      std::vector<std::array<std::int64_t, spacedim>> cell_indices(n_cells);
+      std::array<std::int64_t, spacedim>              min_index;
+      std::fill(min_index.begin(),
+                min_index.end(),
+                std::numeric_limits<std::int64_t>::max());
+      for (std::size_t i = 0; i < n_cells; ++i)
+        {
+          const std::size_t cell_n   = cell_begin + i;
+          const std::size_t q_offset = plan.cell_q_point_offsets[cell_n];
+          const std::size_t n_q_points =
+            plan.cell_q_point_offsets[cell_n + 1] - q_offset;
+
+          std::array<double, spacedim> centroid{};
+          for (std::size_t qp_n = 0; qp_n < n_q_points; ++qp_n)
+            for (unsigned int d = 0; d < spacedim; ++d)
+              centroid[d] += plan.q_points[spacedim * (q_offset + qp_n) + d];
+          for (unsigned int d = 0; d < spacedim; ++d)
+            {
+              centroid[d] /= std::max<std::size_t>(n_q_points, 1);
+              cell_indices[i][d] = std::int64_t(
+                std::floor((centroid[d] - patch_x_lowers[patch_n][d]) /
+                           patch_dxs[patch_n][d]));
+              min_index[d] = std::min(min_index[d], cell_indices[i][d]);
+            }
+        }
+
+      std::vector<std::pair<std::uint64_t, std::size_t>> keys(n_cells);
+      for (std::size_t i = 0; i < n_cells; ++i)
+        {
+          std::array<std::uint64_t, spacedim> shifted_index;
+          for (unsigned int d = 0; d < spacedim; ++d)
+            shifted_index[d] = cell_indices[i][d] - min_index[d];
+          keys[i] = std::make_pair(morton_key<spacedim>(shifted_index), i);
+        }
+      // Ties are broken by the original order
+      std::sort(keys.begin(), keys.end());
+
+      std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+                               new_cells(n_cells);
+      std::vector<std::size_t> new_q_point_offsets(n_cells);
+      std::vector<double>      new_q_points(
+        spacedim * (plan.patch_q_point_offset(patch_n + 1) - q_point_begin));
+      std::size_t q_offset = q_point_begin;
+      for (std::size_t i = 0; i < n_cells; ++i)
+        {
+          const std::size_t old_cell_n = cell_begin + keys[i].second;
+          new_cells[i]                 = plan.cells[old_cell_n];
+          std::copy(plan.q_points.begin() +
+                      spacedim * plan.cell_q_point_offsets[old_cell_n],
+                    plan.q_points.begin() +
+                      spacedim * plan.cell_q_point_offsets[old_cell_n + 1],
+                    new_q_points.begin() +
+                      spacedim * (q_offset - q_point_begin));
+          q_offset += plan.cell_q_point_offsets[old_cell_n + 1] -
+                      plan.cell_q_point_offsets[old_cell_n];
+          new_q_point_offsets[i] = q_offset;
+        }
+      Assert(q_offset == plan.patch_q_point_offset(patch_n + 1),
+             ExcFDLInternalError());
+
+      // The last offset is the first offset of the next patch, which is
+      // unchanged, so don't write it (another thread may be reading it)
+      std::copy(new_cells.begin(),
+                new_cells.end(),
+                plan.cells.begin() + cell_begin);
+      std::copy(new_q_point_offsets.begin(),
+                new_q_point_offsets.end() - 1,
+                plan.cell_q_point_offsets.begin() + cell_begin + 1);
+      std::copy(new_q_points.begin(),
+                new_q_points.end(),
+                plan.q_points.begin() + spacedim * q_point_begin);
+    });
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  compute_shape_value_cache(
+    const DoFHandler<dim, spacedim>    &dof_handler,
+    const Mapping<dim, spacedim>       &mapping,
+    const std::vector<unsigned char>   &quadrature_indices,
+    const std::vector<Quadrature<dim>> &quadratures,
+    ShapeValueCache<dim, spacedim>     &shape_value_cache)
   {
     check_quadratures(quadrature_indices,
                       quadratures,
-                      patch_map.get_triangulation());
-
-    // We probably don't need more than 16 quadrature rules
-    boost::container::small_vector<std::unique_ptr<FEValues<dim, spacedim>>, 16>
-      all_position_fe_values;
-    // PatchMap only supports looping over DoFHandler iterators, so we need to
-    // make one and never use it explicitly
-    const Triangulation<dim, spacedim> &tria = patch_map.get_triangulation();
-    // No mixed meshes yet
-    Assert(tria.get_reference_cells().size() == 1, ExcNotImplemented());
-    const ReferenceCell reference_cell = tria.get_reference_cells().front();
-    FE_Nothing<dim, spacedim> fe_nothing(reference_cell);
-    DoFHandler<dim, spacedim> dof_handler(tria);
-    dof_handler.distribute_dofs(fe_nothing);
-    for (const Quadrature<dim> &quad : quadratures)
+                      dof_handler.get_triangulation());
+    const FiniteElement<dim, spacedim> &fe            = dof_handler.get_fe();
+    const unsigned int                  dofs_per_cell = fe.dofs_per_cell;
+    AssertThrow(supports_shape_value_cache(fe),
+                ExcMessage("ShapeValueCache requires a primitive element "
+                           "whose shape function values do not depend on the "
+                           "mapping."));
+
+    shape_value_cache.components.resize(dofs_per_cell);
+    for (unsigned int i = 0; i < dofs_per_cell; ++i)
+      shape_value_cache.components[i] = fe.system_to_component_index(i).first;
+
+    shape_value_cache.evaluators.clear();
+    shape_value_cache.evaluators.resize(quadratures.size());
+    for (unsigned int quad_n = 0; quad_n < quadratures.size(); ++quad_n)
+      if (TensorProductEvaluator<dim, spacedim>::is_supported(
+            fe, quadratures[quad_n]))
+        shape_value_cache.evaluators[quad_n] =
+          std::make_shared<const TensorProductEvaluator<dim, spacedim>>(
+            fe, quadratures[quad_n]);
+
+    shape_value_cache.shape_values.resize(quadratures.size());
+    for (unsigned int quad_n = 0; quad_n < quadratures.size(); ++quad_n)
       {
-        all_position_fe_values.emplace_back(
-          std::make_unique<FEValues<dim, spacedim>>(
-            position_mapping, fe_nothing, quad, update_quadrature_points));
+        const Quadrature<dim> &quadrature = quadratures[quad_n];
+        std::vector<double>   &shape_values =
+          shape_value_cache.shape_values[quad_n];
+        shape_values.resize(quadrature.size() * dofs_per_cell);
+        for (unsigned int qp_n = 0; qp_n < quadrature.size(); ++qp_n)
+          for (unsigned int i = 0; i < dofs_per_cell; ++i)
+            shape_values[qp_n * dofs_per_cell + i] =
+              fe.shape_value(i, quadrature.point(qp_n));
       }
 
-    for (unsigned int patch_n = 0; patch_n < patch_map.size(); ++patch_n)
+    // If all components use the same base element then we can also use the
+    // scalar kernels in cell_rhs_kernels.h:
+    shape_value_cache.n_base_dofs = 0;
+    shape_value_cache.base_shape_values.clear();
+    shape_value_cache.base_rhs_dofs.clear();
+    if (fe.n_base_elements() == 1 && fe.base_element(0).n_components() == 1)
       {
-        auto patch = patch_map.get_patch(patch_n);
-        tbox::Pointer<pdat::CellData<spacedim, Scalar>> qp_data =
-          patch->getPatchData(qp_data_idx);
-        Assert(qp_data, ExcMessage("Type mismatch"));
-        Assert(qp_data->getDepth() == 1, ExcMessage("depth should be 1"));
-        const hier::Box<spacedim> &patch_box = patch->getBox();
-        tbox::Pointer<geom::CartesianPatchGeometry<spacedim>> patch_geom =
-          patch->getPatchGeometry();
-        Assert(patch_geom, ExcMessage("Type mismatch"));
+        const FiniteElement<dim, spacedim> &base_fe = fe.base_element(0);
+        const unsigned int n_base_dofs              = base_fe.dofs_per_cell;
+        const unsigned int n_components             = fe.n_components();
+        shape_value_cache.n_base_dofs               = n_base_dofs;
 
-        auto       iter = patch_map.begin(patch_n, dof_handler);
-        const auto end  = patch_map.end(patch_n, dof_handler);
-        for (; iter != end; ++iter)
+        shape_value_cache.base_shape_values.resize(quadratures.size());
+        for (unsigned int quad_n = 0; quad_n < quadratures.size(); ++quad_n)
           {
-            const auto cell = *iter;
-            const auto quad_index =
-              quadrature_indices[cell->active_cell_index()];
+            const Quadrature<dim> &quadrature = quadratures[quad_n];
+            std::vector<double>   &base_shape_values =
+              shape_value_cache.base_shape_values[quad_n];
+            base_shape_values.resize(quadrature.size() * n_base_dofs);
+            for (unsigned int qp_n = 0; qp_n < quadrature.size(); ++qp_n)
+              for (unsigned int k = 0; k < n_base_dofs; ++k)
+                base_shape_values[qp_n * n_base_dofs + k] =
+                  base_fe.shape_value(k, quadrature.point(qp_n));
+          }
 
-            FEValues<dim, spacedim> &position_fe_values =
-              *all_position_fe_values[quad_index];
-            position_fe_values.reinit(cell);
-            for (const Point<spacedim> &q_point :
-                 position_fe_values.get_quadrature_points())
-              {
-                const hier::Index<spacedim> i =
-                  IBTK::IndexUtilities::getCellIndex(q_point,
-                                                     patch_geom,
-                                                     patch_box);
-                if (patch_box.contains(i))
-                  (*qp_data)(i) += Scalar(1);
-              }
+        shape_value_cache.base_rhs_dofs.resize(dofs_per_cell);
+        for (unsigned int i = 0; i < dofs_per_cell; ++i)
+          {
+            const auto pair = fe.system_to_component_index(i);
+            shape_value_cache
+              .base_rhs_dofs[pair.second * n_components + pair.first] = i;
           }
       }
+
+    const Triangulation<dim, spacedim> &tria = dof_handler.get_triangulation();
+    shape_value_cache.cell_JxW_offsets.resize(tria.n_active_cells() + 1);
+    shape_value_cache.cell_JxW_offsets[0] = 0;
+    for (const auto &cell : tria.active_cell_iterators())
+      shape_value_cache.cell_JxW_offsets[cell->active_cell_index() + 1] =
+        quadratures[quadrature_indices[cell->active_cell_index()]].size();
+    std::partial_sum(shape_value_cache.cell_JxW_offsets.begin(),
+                     shape_value_cache.cell_JxW_offsets.end(),
+                     shape_value_cache.cell_JxW_offsets.begin());
+
+    shape_value_cache.JxW_values.resize(
+      shape_value_cache.cell_JxW_offsets.back());
+    FEValuesCollection<dim, spacedim> all_fe_values;
+    for (const auto &cell : dof_handler.active_cell_iterators())
+      {
+        FEValues<dim, spacedim> &fe_values =
+          get_fe_values(all_fe_values,
+                        quadrature_indices[cell->active_cell_index()],
+                        mapping,
+                        fe,
+                        quadratures,
+                        update_JxW_values);
+        fe_values.reinit(cell);
+        const std::vector<double> &JxW_values = fe_values.get_JxW_values();
+        const std::size_t          offset =
+          shape_value_cache.cell_JxW_offsets[cell->active_cell_index()];
+        std::copy(JxW_values.begin(),
+                  JxW_values.end(),
+                  shape_value_cache.JxW_values.begin() + offset);
+      }
+  }
+
+
+
+  template <int dim, int spacedim, typename Scalar>
+  void
+  count_quadrature_points_internal(const int                qp_data_idx,
+                                   PatchMap<dim, spacedim> &patch_map,
+                                   const InteractionPlan<dim, spacedim> &plan)
+  {
+    check_plan(plan, patch_map);
+
+    // Each patch has its own data so we can count in parallel
+    for_each_patch(patch_map.size(), true, [&](const std::size_t patch_n) {
+      auto patch = patch_map.get_patch(patch_n);
+      tbox::Pointer<pdat::CellData<spacedim, Scalar>> qp_data =
+        patch->getPatchData(qp_data_idx);
+      Assert(qp_data, ExcMessage("Type mismatch"));
+      Assert(qp_data->getDepth() == 1, ExcMessage("depth should be 1"));
+      const hier::Box<spacedim> &patch_box = patch->getBox();
+      tbox::Pointer<geom::CartesianPatchGeometry<spacedim>> patch_geom =
+        patch->getPatchGeometry();
+      Assert(patch_geom, ExcMessage("Type mismatch"));
+
+      for (std::size_t q_point_n = plan.patch_q_point_offset(patch_n);
+           q_point_n < plan.patch_q_point_offset(patch_n + 1);
+           ++q_point_n)
+        {
+          const hier::Index<spacedim> i = IBTK::IndexUtilities::getCellIndex(
+            &plan.q_points[q_point_n * spacedim], patch_geom, patch_box);
+          if (patch_box.contains(i))
+            (*qp_data)(i) += Scalar(1);
+        }
+    });
   }
 
 
@@ -277,6 +778,20 @@ namespace fdl
                           const Mapping<dim, spacedim>     &position_mapping,
                           const std::vector<unsigned char> &quadrature_indices,
                           const std::vector<Quadrature<dim>> &quadratures)
+  {
+    InteractionPlan<dim, spacedim> plan;
+    compute_interaction_plan(
+      patch_map, position_mapping, quadrature_indices, quadratures, plan);
+    count_quadrature_points(qp_data_idx, patch_map, plan);
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  count_quadrature_points(const int                             qp_data_idx,
+                          PatchMap<dim, spacedim>              &patch_map,
+                          const InteractionPlan<dim, spacedim> &plan)
   {
     // SAMRAI doesn't offer a way to dispatch on data type so we have to do it
     // ourselves
@@ -297,26 +812,17 @@ namespace fdl
           patch->getPatchData(qp_data_idx);
 
         if (int_data)
-          count_quadrature_points_internal<dim, spacedim, int>(
-            qp_data_idx,
-            patch_map,
-            position_mapping,
-            quadrature_indices,
-            quadratures);
+          count_quadrature_points_internal<dim, spacedim, int>(qp_data_idx,
+                                                              patch_map,
+                                                              plan);
         else if (float_data)
-          count_quadrature_points_internal<dim, spacedim, float>(
-            qp_data_idx,
-            patch_map,
-            position_mapping,
-            quadrature_indices,
-            quadratures);
+          count_quadrature_points_internal<dim, spacedim, float>(qp_data_idx,
+                                                              patch_map,
+                                                              plan);
         else if (double_data)
-          count_quadrature_points_internal<dim, spacedim, double>(
-            qp_data_idx,
-            patch_map,
-            position_mapping,
-            quadrature_indices,
-            quadratures);
+          count_quadrature_points_internal<dim, spacedim, double>(qp_data_idx,
+                                                              patch_map,
+                                                              plan);
         else
           Assert(false, ExcNotImplemented());
       }
@@ -415,141 +921,171 @@ namespace fdl
 
 
 
-  template <int dim, int spacedim, typename patch_type>
+  /**
+   * Check that every part of a multi-part interaction operation is set up
+   * consistently: in particular, every PatchMap must store the same patches
+   * in the same order.
+   */
+  template <int dim, int spacedim>
   void
-  compute_projection_rhs_internal(
-    const std::string                  &kernel_name,
-    const int                           data_idx,
-    const PatchMap<dim, spacedim>      &patch_map,
-    const Mapping<dim, spacedim>       &position_mapping,
-    const std::vector<unsigned char>   &quadrature_indices,
-    const std::vector<Quadrature<dim>> &quadratures,
-    const DoFHandler<dim, spacedim>    &dof_handler,
-    const Mapping<dim, spacedim>       &mapping,
-    Vector<double>                     &rhs)
+  check_parts(const std::vector<PartInteractionData<dim, spacedim>> &parts)
   {
-    check_quadratures(quadrature_indices,
-                      quadratures,
-                      dof_handler.get_triangulation());
-    const FiniteElement<dim, spacedim> &fe            = dof_handler.get_fe();
-    const unsigned int                  dofs_per_cell = fe.dofs_per_cell;
-    // TODO - do we need to assume something about the block structure of the
-    // FE?
-
-    // We probably don't need more than 16 quadrature rules
-    //
-    // TODO - implement a move constructor for FEValues
-    // The FE for position is arbitrary - we just need quadrature points. The
-    // actual position FE is in position_mapping
-    boost::container::small_vector<std::unique_ptr<FEValues<dim, spacedim>>, 16>
-      all_position_fe_values;
-    boost::container::small_vector<std::unique_ptr<FEValues<dim, spacedim>>, 16>
-      all_rhs_fe_values;
-    for (const Quadrature<dim> &quad : quadratures)
+    for (const PartInteractionData<dim, spacedim> &part : parts)
       {
-        all_position_fe_values.emplace_back(
-          std::make_unique<FEValues<dim, spacedim>>(
-            position_mapping, fe, quad, update_quadrature_points));
-        all_rhs_fe_values.emplace_back(
-          std::make_unique<FEValues<dim, spacedim>>(
-            mapping, fe, quad, update_JxW_values | update_values));
+        (void)part;
+        Assert(part.patch_map && part.plan && part.quadrature_indices &&
+                 part.quadratures && part.dof_handler && part.mapping,
+               ExcMessage("Each part must be completely set up."));
+        check_quadratures(*part.quadrature_indices,
+                          *part.quadratures,
+                          part.dof_handler->get_triangulation());
+        check_plan(*part.plan, *part.patch_map);
+        Assert(!part.shape_value_cache ||
+                 part.shape_value_cache->components.size() ==
+                   part.dof_handler->get_fe().dofs_per_cell,
+               ExcMessage("The ShapeValueCache should use the same element."));
+        Assert(part.patch_map->size() == parts[0].patch_map->size(),
+               ExcMessage("All parts should use the same patches."));
+        Assert(part.native_kernel == get_native_ib_kernel(part.kernel_name),
+               ExcMessage("The native kernel should match the kernel name."));
+#ifdef DEBUG
+        for (std::size_t patch_n = 0; patch_n < part.patch_map->size();
+             ++patch_n)
+          Assert(part.patch_map->get_patch(patch_n).getPointer() ==
+                   parts[0].patch_map->get_patch(patch_n).getPointer(),
+                 ExcMessage("All parts should use the same patches."));
+#endif
       }
+  }
 
-    Vector<double>      cell_rhs(dofs_per_cell);
-    std::vector<double> rhs_values;
 
-    std::vector<types::global_dof_index> dof_indices(fe.dofs_per_cell);
-    for (unsigned int patch_n = 0; patch_n < patch_map.size(); ++patch_n)
-      {
-        auto                      patch      = patch_map.get_patch(patch_n);
-        tbox::Pointer<patch_type> patch_data = patch->getPatchData(data_idx);
-        check_depth<spacedim>(patch_data, fe.n_components());
 
-        auto       iter = patch_map.begin(patch_n, dof_handler);
-        const auto end  = patch_map.end(patch_n, dof_handler);
-        for (; iter != end; ++iter)
+  /**
+   * Compute the right-hand side of one part from the values interpolated at
+   * its quadrature points.
+   */
+  template <int dim, int spacedim>
+  void
+  compute_projection_rhs_from_values(
+    const PartInteractionData<dim, spacedim> &part,
+    const std::vector<double>                &rhs_values,
+    Vector<double>                           &rhs)
+  {
+    const InteractionPlan<dim, spacedim> &plan = *part.plan;
+    const std::vector<unsigned char>     &quadrature_indices =
+      *part.quadrature_indices;
+    const std::vector<Quadrature<dim>>   &quadratures = *part.quadratures;
+    const DoFHandler<dim, spacedim>      &dof_handler = *part.dof_handler;
+    const Mapping<dim, spacedim>         &mapping     = *part.mapping;
+    const ShapeValueCache<dim, spacedim> *shape_value_cache =
+      part.shape_value_cache;
+    const FiniteElement<dim, spacedim> &fe            = dof_handler.get_fe();
+    const unsigned int                  dofs_per_cell = fe.dofs_per_cell;
+    const unsigned int                  n_components  = fe.n_components();
+    // TODO - do we need to assume something about the block structure of the
+    // FE?
+
+    // Use a specialized kernel if we can:
+    const CellRHSKernel cell_rhs_kernel =
+      shape_value_cache && shape_value_cache->n_base_dofs != 0 ?
+        get_cell_rhs_kernel(shape_value_cache->n_base_dofs, n_components) :
+        nullptr;
+
+    // Compute the cell right-hand sides in parallel:
+    std::vector<double> all_cell_rhs(dofs_per_cell * plan.n_cells());
+    parallel::apply_to_subranges(
+      std::size_t(0),
+      plan.n_cells(),
+      [&](const std::size_t begin, const std::size_t end) {
+        FEValuesCollection<dim, spacedim> all_rhs_fe_values;
+        std::vector<double>               cell_shape_values;
+        std::vector<double>               cell_base_rhs(dofs_per_cell);
+        for (std::size_t cell_n = begin; cell_n < end; ++cell_n)
           {
-            const auto cell = *iter;
-            const auto quad_index =
+            const auto cell = to_dof_cell(plan.cells[cell_n], dof_handler);
+            const unsigned char quad_index =
               quadrature_indices[cell->active_cell_index()];
+            const std::size_t q_point_offset =
+              plan.cell_q_point_offsets[cell_n];
+            const unsigned int n_q_points =
+              plan.cell_q_point_offsets[cell_n + 1] - q_point_offset;
+            double *const cell_rhs = &all_cell_rhs[cell_n * dofs_per_cell];
 
-            // Reinitialize:
-            FEValues<dim, spacedim> &rhs_fe_values =
-              *all_rhs_fe_values[quad_index];
-            FEValues<dim, spacedim> &position_fe_values =
-              *all_position_fe_values[quad_index];
-            rhs_fe_values.reinit(cell);
-            position_fe_values.reinit(cell);
-            rhs_values.resize(
-              position_fe_values.get_quadrature_points().size());
-            Assert(rhs_fe_values.get_quadrature() ==
-                     position_fe_values.get_quadrature(),
-                   ExcFDLInternalError());
+            if (cell_rhs_kernel)
+              {
+                cell_rhs_kernel(
+                  shape_value_cache->n_base_dofs,
+                  n_components,
+                  n_q_points,
+                  shape_value_cache->base_shape_values[quad_index].data(),
+                  rhs_values.data() + n_components * q_point_offset,
+                  shape_value_cache->get_JxW_values(cell->active_cell_index()),
+                  cell_base_rhs.data());
+                for (unsigned int j = 0; j < dofs_per_cell; ++j)
+                  cell_rhs[shape_value_cache->base_rhs_dofs[j]] =
+                    cell_base_rhs[j];
+                continue;
+              }
 
-            cell_rhs = 0.0;
-            cell->get_dof_indices(dof_indices);
-            const std::vector<Point<spacedim>> &q_points =
-              position_fe_values.get_quadrature_points();
-            const unsigned int n_q_points = q_points.size();
-            rhs_values.resize(fe.n_components() * n_q_points);
-
-
-            // Interpolate at quadrature points:
-#if 1
-            // Interpolate values from the patch. This LEInteractor call could
-            // be improved - we don't need to look up certain things on each
-            // element
-            static_assert(sizeof(Point<spacedim>) == sizeof(double) * spacedim,
-                          "FORTRAN routines assume we are packed");
-            const auto position_data =
-              reinterpret_cast<const double *>(q_points.data());
-
-            std::fill(rhs_values.begin(), rhs_values.end(), 0.0);
-            IBTK::LEInteractor::interpolate(rhs_values.data(),
-                                            rhs_values.size(),
-                                            fe.n_components(),
-                                            position_data,
-                                            q_points.size() * spacedim,
-                                            spacedim,
-                                            patch_data,
-                                            patch,
-                                            patch->getBox(),
-                                            kernel_name);
-#else
-            std::fill(rhs_values.begin(), rhs_values.end(), 1.0);
-#endif
+            // The value of shape function i at quadrature point q is
+            // shape_values[q * dofs_per_cell + i].
+            const double *shape_values = nullptr;
+            const double *JxW_values   = nullptr;
+            if (shape_value_cache)
+              {
+                shape_values = shape_value_cache->get_shape_values(quad_index);
+                JxW_values   = shape_value_cache->get_JxW_values(
+                  cell->active_cell_index());
+              }
+            else
+              {
+                FEValues<dim, spacedim> &rhs_fe_values =
+                  get_fe_values(all_rhs_fe_values,
+                                quad_index,
+                                mapping,
+                                fe,
+                                quadratures,
+                                update_JxW_values | update_values);
+                rhs_fe_values.reinit(cell);
+                Assert(rhs_fe_values.n_quadrature_points == n_q_points,
+                       ExcFDLInternalError());
+                cell_shape_values.resize(n_q_points * dofs_per_cell);
+                for (unsigned int qp_n = 0; qp_n < n_q_points; ++qp_n)
+                  for (unsigned int i = 0; i < dofs_per_cell; ++i)
+                    cell_shape_values[qp_n * dofs_per_cell + i] =
+                      rhs_fe_values.shape_value(i, qp_n);
+                shape_values = cell_shape_values.data();
+                JxW_values   = rhs_fe_values.get_JxW_values().data();
+              }
+            const double *const cell_rhs_values =
+              rhs_values.data() + n_components * q_point_offset;
 
             for (unsigned int qp_n = 0; qp_n < n_q_points; ++qp_n)
               {
-                if (fe.n_components() == 1)
+                const double *const qp_shape_values =
+                  shape_values + qp_n * dofs_per_cell;
+                const double JxW = JxW_values[qp_n];
+                if (n_components == 1)
                   {
-                    AssertIndexRange(qp_n, rhs_values.size());
                     for (unsigned int i = 0; i < dofs_per_cell; ++i)
                       {
-                        cell_rhs[i] += rhs_fe_values.shape_value(i, qp_n) *
-                                       rhs_values[qp_n] *
-                                       rhs_fe_values.JxW(qp_n);
+                        cell_rhs[i] +=
+                          qp_shape_values[i] * cell_rhs_values[qp_n] * JxW;
                       }
                   }
-                else if (fe.n_components() == spacedim)
+                else if (n_components == spacedim)
                   {
                     Tensor<1, spacedim> qp;
                     for (unsigned int d = 0; d < spacedim; ++d)
-                      {
-                        AssertIndexRange(qp_n * spacedim + d,
-                                         rhs_values.size());
-                        qp[d] = rhs_values[qp_n * spacedim + d];
-                      }
+                      qp[d] = cell_rhs_values[qp_n * spacedim + d];
 
                     // TODO - this only works with primitive elements
-                    // TODO - perhaps its worth unrolling this loop?
-                    // dofs_per_cell is probably 12, 30, or 45.
                     for (unsigned int i = 0; i < dofs_per_cell; ++i)
                       {
                         const unsigned int component =
                           fe.system_to_component_index(i).first;
-                        cell_rhs[i] += rhs_fe_values.shape_value(i, qp_n) *
-                                       qp[component] * rhs_fe_values.JxW(qp_n);
+                        cell_rhs[i] +=
+                          qp_shape_values[i] * qp[component] * JxW;
                       }
                   }
                 else
@@ -557,10 +1093,94 @@ namespace fdl
                     Assert(false, ExcNotImplemented());
                   }
               }
-
-            rhs.add(dof_indices, cell_rhs);
           }
+      },
+      cell_grainsize);
+
+    // Sum into the global vector in a fixed order so that the result does not
+    // depend on the number of threads:
+    std::vector<types::global_dof_index> dof_indices(dofs_per_cell);
+    for (std::size_t cell_n = 0; cell_n < plan.n_cells(); ++cell_n)
+      {
+        to_dof_cell(plan.cells[cell_n], dof_handler)
+          ->get_dof_indices(dof_indices);
+        rhs.add(dofs_per_cell,
+                dof_indices.data(),
+                &all_cell_rhs[cell_n * dofs_per_cell]);
+      }
+  }
+
+
+
+  template <int dim, int spacedim, typename patch_type>
+  void
+  compute_projection_rhs_internal(
+    const int                                              data_idx,
+    const std::vector<PartInteractionData<dim, spacedim>> &parts,
+    const std::vector<Vector<double> *>                   &rhs)
+  {
+    check_parts(parts);
+    AssertDimension(parts.size(), rhs.size());
+
+    // All quadrature points and interpolated values of a part are stored
+    // contiguously (ordered by patch) so that we only interpolate once per
+    // patch.
+    std::vector<std::vector<double>> rhs_values(parts.size());
+    bool                             use_threads = true;
+    for (unsigned int part_n = 0; part_n < parts.size(); ++part_n)
+      {
+        rhs_values[part_n].resize(
+          parts[part_n].dof_handler->get_fe().n_components() *
+          parts[part_n].plan->n_q_points());
+        use_threads = use_threads && has_native_ib_kernel<spacedim, patch_type>(
+                                       parts[part_n].native_kernel);
+      }
+
+    // Interpolate at quadrature points. Every part is processed on a patch
+    // before moving on to the next patch so that the patch data is only
+    // loaded into cache once. LEInteractor is not thread-safe so only use
+    // threads with our own kernels.
+    const PatchMap<dim, spacedim> &patch_map = *parts[0].patch_map;
+    std::vector<tbox::Pointer<hier::Patch<spacedim>>> patches(patch_map.size());
+    std::vector<tbox::Pointer<patch_type>> patch_data(patch_map.size());
+    for (unsigned int patch_n = 0; patch_n < patch_map.size(); ++patch_n)
+      {
+        patches[patch_n]    = patch_map.get_patch(patch_n);
+        patch_data[patch_n] = patches[patch_n]->getPatchData(data_idx);
+        for (const PartInteractionData<dim, spacedim> &part : parts)
+          check_depth<spacedim>(patch_data[patch_n],
+                                part.dof_handler->get_fe().n_components());
       }
+    for_each_patch(
+      patch_map.size(), use_threads, [&](const std::size_t patch_n) {
+        for (unsigned int part_n = 0; part_n < parts.size(); ++part_n)
+          {
+            const InteractionPlan<dim, spacedim> &plan = *parts[part_n].plan;
+            const unsigned int                    n_components =
+              parts[part_n].dof_handler->get_fe().n_components();
+            const std::size_t begin = plan.patch_q_point_offset(patch_n);
+            const std::size_t end   = plan.patch_q_point_offset(patch_n + 1);
+            if (begin == end)
+              continue;
+
+            interpolate_from_patch(rhs_values[part_n].data() +
+                                     n_components * begin,
+                                   n_components * (end - begin),
+                                   n_components,
+                                   plan.q_points.data() + spacedim * begin,
+                                   spacedim * (end - begin),
+                                   patch_data[patch_n],
+                                   patches[patch_n],
+                                   patches[patch_n]->getBox(),
+                                   parts[part_n].kernel_name,
+                                   parts[part_n].native_kernel);
+          }
+      });
+
+    for (unsigned int part_n = 0; part_n < parts.size(); ++part_n)
+      compute_projection_rhs_from_values(parts[part_n],
+                                         rhs_values[part_n],
+                                         *rhs[part_n]);
   }
 
 
@@ -577,13 +1197,64 @@ namespace fdl
                          const Mapping<dim, spacedim>       &mapping,
                          Vector<double>                     &rhs)
   {
-#define ARGUMENTS                                                         \
-  kernel_name, data_idx, patch_map, position_mapping, quadrature_indices, \
-    quadratures, dof_handler, mapping, rhs
-    if (patch_map.size() != 0)
+    InteractionPlan<dim, spacedim> plan;
+    compute_interaction_plan(
+      patch_map, position_mapping, quadrature_indices, quadratures, plan);
+    compute_projection_rhs(kernel_name,
+                           data_idx,
+                           patch_map,
+                           plan,
+                           quadrature_indices,
+                           quadratures,
+                           dof_handler,
+                           mapping,
+                           rhs);
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  compute_projection_rhs(
+    const std::string                    &kernel_name,
+    const int                             data_idx,
+    const PatchMap<dim, spacedim>        &patch_map,
+    const InteractionPlan<dim, spacedim> &plan,
+    const std::vector<unsigned char>     &quadrature_indices,
+    const std::vector<Quadrature<dim>>   &quadratures,
+    const DoFHandler<dim, spacedim>      &dof_handler,
+    const Mapping<dim, spacedim>         &mapping,
+    Vector<double>                       &rhs,
+    const ShapeValueCache<dim, spacedim> *shape_value_cache)
+  {
+    std::vector<PartInteractionData<dim, spacedim>> parts(1);
+    parts[0].kernel_name        = kernel_name;
+    parts[0].native_kernel      = get_native_ib_kernel(kernel_name);
+    parts[0].patch_map          = &patch_map;
+    parts[0].plan               = &plan;
+    parts[0].quadrature_indices = &quadrature_indices;
+    parts[0].quadratures        = &quadratures;
+    parts[0].dof_handler        = &dof_handler;
+    parts[0].mapping            = &mapping;
+    parts[0].shape_value_cache  = shape_value_cache;
+    compute_projection_rhs(data_idx, parts, {&rhs});
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  compute_projection_rhs(
+    const int                                              data_idx,
+    const std::vector<PartInteractionData<dim, spacedim>> &parts,
+    const std::vector<Vector<double> *>                   &rhs)
+  {
+#define ARGUMENTS data_idx, parts, rhs
+    if (parts.size() != 0 && parts[0].patch_map->size() != 0)
       {
-        auto patch_data = patch_map.get_patch(0)->getPatchData(data_idx);
-        auto pair       = extract_types(patch_data);
+        auto patch_data =
+          parts[0].patch_map->get_patch(0)->getPatchData(data_idx);
+        auto pair = extract_types(patch_data);
 
         AssertThrow(pair.second == SAMRAIFieldType::Double,
                     ExcNotImplemented());
@@ -651,8 +1322,14 @@ namespace fdl
               interpolated_values.end(),
               std::numeric_limits<double>::lowest());
 
-    for (std::size_t patch_n = 0; patch_n < patch_map.size(); ++patch_n)
-      {
+    // Each patch only sets values at nodes inside its box so we can
+    // interpolate on multiple patches in parallel. LEInteractor is not
+    // thread-safe so only use threads with our own kernels.
+    const NativeIBKernel native_kernel = get_native_ib_kernel(kernel_name);
+    for_each_patch(
+      patch_map.size(),
+      has_native_ib_kernel<spacedim, patch_type>(native_kernel),
+      [&](const std::size_t patch_n) {
         std::pair<const IndexSet &, tbox::Pointer<hier::Patch<spacedim>>> p =
           patch_map[patch_n];
         const IndexSet                       &dofs  = p.first;
@@ -678,18 +1355,18 @@ namespace fdl
             Assert(values_view.size() % n_components == 0,
                    ExcFDLInternalError());
 
-            IBTK::LEInteractor::interpolate(values_view.data(),
-                                            values_view.size(),
-                                            n_components,
-                                            position_view.data(),
-                                            position_view.size(),
-                                            spacedim,
-                                            patch_data,
-                                            patch,
-                                            patch->getBox(),
-                                            kernel_name);
+            interpolate_from_patch(values_view.data(),
+                                   values_view.size(),
+                                   n_components,
+                                   position_view.data(),
+                                   position_view.size(),
+                                   patch_data,
+                                   patch,
+                                   patch->getBox(),
+                                   kernel_name,
+                                   native_kernel);
           }
-      }
+      });
   }
 
   template <int dim, int spacedim>
@@ -777,113 +1454,192 @@ namespace fdl
                                                              values);
   }
 
-  template <int dim, int spacedim, typename value_type, typename patch_type>
+  /**
+   * Compute the values (multiplied by JxW) of one part's finite element field
+   * at all of its quadrature points.
+   */
+  template <int dim, int spacedim, typename value_type>
   void
-  compute_spread_internal(const std::string                &kernel_name,
-                          const int                         data_idx,
-                          PatchMap<dim, spacedim>          &patch_map,
-                          const Mapping<dim, spacedim>     &position_mapping,
-                          const std::vector<unsigned char> &quadrature_indices,
-                          const std::vector<Quadrature<dim>> &quadratures,
-                          const DoFHandler<dim, spacedim>    &dof_handler,
-                          const Mapping<dim, spacedim>       &mapping,
-                          const Vector<double>               &solution)
+  compute_spread_values(const PartInteractionData<dim, spacedim> &part,
+                        const Vector<double>                     &solution,
+                        std::vector<double>                      &values)
   {
-    check_quadratures(quadrature_indices,
-                      quadratures,
-                      dof_handler.get_triangulation());
-    const FiniteElement<dim, spacedim> &fe = dof_handler.get_fe();
-
-    // We probably don't need more than 16 quadrature rules
-    boost::container::small_vector<std::unique_ptr<FEValues<dim, spacedim>>, 16>
-      all_position_fe_values;
-    boost::container::small_vector<std::unique_ptr<FEValues<dim, spacedim>>, 16>
-      all_solution_fe_values;
-    for (const Quadrature<dim> &quad : quadratures)
-      {
-        all_position_fe_values.emplace_back(
-          std::make_unique<FEValues<dim, spacedim>>(
-            position_mapping, fe, quad, update_quadrature_points));
-        all_solution_fe_values.emplace_back(
-          std::make_unique<FEValues<dim, spacedim>>(
-            mapping, fe, quad, update_JxW_values | update_values));
-      }
-
-    std::vector<value_type> cell_solution_values;
-    std::vector<double>     cell_solution(fe.dofs_per_cell);
-
-    for (unsigned int patch_n = 0; patch_n < patch_map.size(); ++patch_n)
-      {
-        auto                      patch      = patch_map.get_patch(patch_n);
-        tbox::Pointer<patch_type> patch_data = patch->getPatchData(data_idx);
-        Assert(patch_data, ExcMessage("Type mismatch"));
-        check_depth<spacedim>(patch_data, fe.n_components());
-
-        auto       iter = patch_map.begin(patch_n, dof_handler);
-        const auto end  = patch_map.end(patch_n, dof_handler);
-        for (; iter != end; ++iter)
+    const InteractionPlan<dim, spacedim> &plan = *part.plan;
+    const std::vector<unsigned char>     &quadrature_indices =
+      *part.quadrature_indices;
+    const std::vector<Quadrature<dim>>   &quadratures = *part.quadratures;
+    const DoFHandler<dim, spacedim>      &dof_handler = *part.dof_handler;
+    const Mapping<dim, spacedim>         &mapping     = *part.mapping;
+    const ShapeValueCache<dim, spacedim> *shape_value_cache =
+      part.shape_value_cache;
+    const FiniteElement<dim, spacedim> &fe            = dof_handler.get_fe();
+    const unsigned int                  dofs_per_cell = fe.dofs_per_cell;
+    const unsigned int                  n_components  = fe.n_components();
+
+    // the number of components is determined at run time so use a normal
+    // assertion
+    AssertThrow(sizeof(value_type) == sizeof(double) * n_components,
+                ExcMessage("FORTRAN routines assume we are packed"));
+
+    // As in compute_projection_rhs(), all values are stored contiguously
+    // (ordered by patch) so that we only spread once per patch. Each cell
+    // writes to its own part of the array so we can use threads.
+    values.resize(n_components * plan.n_q_points());
+    std::fill(values.begin(), values.end(), 0.0);
+    parallel::apply_to_subranges(
+      std::size_t(0),
+      plan.n_cells(),
+      [&](const std::size_t begin, const std::size_t end) {
+        FEValuesCollection<dim, spacedim> all_solution_fe_values;
+        std::vector<value_type>           cell_solution_values;
+        std::vector<double>               cell_solution(dofs_per_cell);
+        std::vector<double>               evaluation_scratch;
+        for (std::size_t cell_n = begin; cell_n < end; ++cell_n)
           {
-            const auto cell = *iter;
-            const auto quad_index =
+            const auto cell = to_dof_cell(plan.cells[cell_n], dof_handler);
+            const unsigned char quad_index =
               quadrature_indices[cell->active_cell_index()];
-
-            // Reinitialize:
-            FEValues<dim, spacedim> &solution_fe_values =
-              *all_solution_fe_values[quad_index];
-            FEValues<dim, spacedim> &position_fe_values =
-              *all_position_fe_values[quad_index];
-            solution_fe_values.reinit(cell);
-            position_fe_values.reinit(cell);
-            Assert(solution_fe_values.get_quadrature() ==
-                     position_fe_values.get_quadrature(),
-                   ExcFDLInternalError());
-
-            const std::vector<Point<spacedim>> &q_points =
-              position_fe_values.get_quadrature_points();
-            const unsigned int n_q_points = q_points.size();
-            cell_solution_values.resize(n_q_points);
+            const unsigned int n_q_points =
+              plan.cell_q_point_offsets[cell_n + 1] -
+              plan.cell_q_point_offsets[cell_n];
+            double *const cell_values =
+              values.data() + n_components * plan.cell_q_point_offsets[cell_n];
 
             // get forces:
-            std::fill(cell_solution_values.begin(),
-                      cell_solution_values.end(),
-                      value_type());
             cell->get_dof_values(solution,
                                  cell_solution.begin(),
                                  cell_solution.end());
-            compute_values_generic(solution_fe_values,
-                                   cell_solution,
-                                   cell_solution_values);
-            for (unsigned int qp = 0; qp < n_q_points; ++qp)
-              cell_solution_values[qp] *= solution_fe_values.JxW(qp);
-
+            if (shape_value_cache)
+              {
+                const double *const shape_values =
+                  shape_value_cache->get_shape_values(quad_index);
+                const double *const JxW_values =
+                  shape_value_cache->get_JxW_values(cell->active_cell_index());
+                const std::vector<unsigned int> &components =
+                  shape_value_cache->components;
+                const auto &evaluator =
+                  shape_value_cache->evaluators[quad_index];
+                if (evaluator)
+                  evaluator->evaluate(cell_solution.data(),
+                                      cell_values,
+                                      evaluation_scratch);
+                else
+                  for (unsigned int qp = 0; qp < n_q_points; ++qp)
+                    {
+                      const double *const qp_shape_values =
+                        shape_values + qp * dofs_per_cell;
+                      double *const qp_values =
+                        cell_values + qp * n_components;
+                      for (unsigned int i = 0; i < dofs_per_cell; ++i)
+                        qp_values[components[i]] +=
+                          qp_shape_values[i] * cell_solution[i];
+                    }
+                for (unsigned int qp = 0; qp < n_q_points; ++qp)
+                  for (unsigned int c = 0; c < n_components; ++c)
+                    cell_values[qp * n_components + c] *= JxW_values[qp];
+              }
+            else
+              {
+                FEValues<dim, spacedim> &solution_fe_values =
+                  get_fe_values(all_solution_fe_values,
+                                quad_index,
+                                mapping,
+                                fe,
+                                quadratures,
+                                update_JxW_values | update_values);
+                solution_fe_values.reinit(cell);
+                Assert(solution_fe_values.n_quadrature_points == n_q_points,
+                       ExcFDLInternalError());
+                cell_solution_values.resize(n_q_points);
+                std::fill(cell_solution_values.begin(),
+                          cell_solution_values.end(),
+                          value_type());
+                compute_values_generic(solution_fe_values,
+                                       cell_solution,
+                                       cell_solution_values);
+                for (unsigned int qp = 0; qp < n_q_points; ++qp)
+                  {
+                    const value_type value =
+                      cell_solution_values[qp] * solution_fe_values.JxW(qp);
+                    const double *const value_data =
+                      reinterpret_cast<const double *>(&value);
+                    std::copy(value_data,
+                              value_data + n_components,
+                              cell_values + qp * n_components);
+                  }
+              }
             // TODO reimplement zeroExteriorValues here
-
-            // spread at quadrature points:
-            static_assert(sizeof(Point<spacedim>) == sizeof(double) * spacedim,
-                          "FORTRAN routines assume we are packed");
-            const auto position_data =
-              reinterpret_cast<const double *>(q_points.data());
-            // the number of components is determined at run time so use a
-            // normal assertion
-            AssertThrow(sizeof(value_type) ==
-                          sizeof(double) * fe.n_components(),
-                        ExcMessage("FORTRAN routines assume we are packed"));
-            const auto solution_data =
-              reinterpret_cast<const double *>(cell_solution_values.data());
-
-            IBTK::LEInteractor::spread(patch_data,
-                                       solution_data,
-                                       cell_solution_values.size() *
-                                         fe.n_components(),
-                                       fe.n_components(),
-                                       position_data,
-                                       n_q_points * spacedim,
-                                       spacedim,
-                                       patch,
-                                       patch->getBox(),
-                                       kernel_name);
           }
+      },
+      cell_grainsize);
+  }
+
+
+
+  template <int dim, int spacedim, typename value_type, typename patch_type>
+  void
+  compute_spread_internal(
+    const int                                              data_idx,
+    const std::vector<PartInteractionData<dim, spacedim>> &parts,
+    const std::vector<const Vector<double> *>             &solutions)
+  {
+    check_parts(parts);
+    AssertDimension(parts.size(), solutions.size());
+
+    std::vector<std::vector<double>> solution_values(parts.size());
+    for (unsigned int part_n = 0; part_n < parts.size(); ++part_n)
+      compute_spread_values<dim, spacedim, value_type>(parts[part_n],
+                                                       *solutions[part_n],
+                                                       solution_values[part_n]);
+
+    // Spread every part on a patch before moving on to the next patch so that
+    // the patch data is only loaded into cache once. Each patch has its own
+    // patch data so patches can be processed in parallel - but LEInteractor
+    // is not thread-safe so only use threads with our own kernels.
+    bool use_threads = true;
+    for (const PartInteractionData<dim, spacedim> &part : parts)
+      use_threads =
+        use_threads &&
+        has_native_ib_kernel<spacedim, patch_type>(part.native_kernel);
+
+    // Copying tbox::Pointer objects is not thread-safe so set them up first:
+    const PatchMap<dim, spacedim> &patch_map = *parts[0].patch_map;
+    std::vector<tbox::Pointer<hier::Patch<spacedim>>> patches(patch_map.size());
+    std::vector<tbox::Pointer<patch_type>> patch_data(patch_map.size());
+    for (unsigned int patch_n = 0; patch_n < patch_map.size(); ++patch_n)
+      {
+        patches[patch_n]    = patch_map.get_patch(patch_n);
+        patch_data[patch_n] = patches[patch_n]->getPatchData(data_idx);
+        Assert(patch_data[patch_n], ExcMessage("Type mismatch"));
+        for (const PartInteractionData<dim, spacedim> &part : parts)
+          check_depth<spacedim>(patch_data[patch_n],
+                                part.dof_handler->get_fe().n_components());
       }
+    for_each_patch(
+      patch_map.size(), use_threads, [&](const std::size_t patch_n) {
+        for (unsigned int part_n = 0; part_n < parts.size(); ++part_n)
+          {
+            const InteractionPlan<dim, spacedim> &plan = *parts[part_n].plan;
+            const unsigned int                    n_components =
+              parts[part_n].dof_handler->get_fe().n_components();
+            const std::size_t begin = plan.patch_q_point_offset(patch_n);
+            const std::size_t end   = plan.patch_q_point_offset(patch_n + 1);
+            if (begin == end)
+              continue;
+
+            spread_to_patch(patch_data[patch_n],
+                            solution_values[part_n].data() +
+                              n_components * begin,
+                            n_components * (end - begin),
+                            n_components,
+                            plan.q_points.data() + spacedim * begin,
+                            spacedim * (end - begin),
+                            patches[patch_n],
+                            patches[patch_n]->getBox(),
+                            parts[part_n].kernel_name,
+                            parts[part_n].native_kernel);
+          }
+      });
   }
 
 
@@ -900,13 +1656,64 @@ namespace fdl
                  const Mapping<dim, spacedim>       &mapping,
                  const Vector<double>               &solution)
   {
-#define ARGUMENTS                                                         \
-  kernel_name, data_idx, patch_map, position_mapping, quadrature_indices, \
-    quadratures, dof_handler, mapping, solution
-    if (patch_map.size() != 0)
+    InteractionPlan<dim, spacedim> plan;
+    compute_interaction_plan(
+      patch_map, position_mapping, quadrature_indices, quadratures, plan);
+    compute_spread(kernel_name,
+                   data_idx,
+                   patch_map,
+                   plan,
+                   quadrature_indices,
+                   quadratures,
+                   dof_handler,
+                   mapping,
+                   solution);
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  compute_spread(
+    const std::string                    &kernel_name,
+    const int                             data_idx,
+    PatchMap<dim, spacedim>              &patch_map,
+    const InteractionPlan<dim, spacedim> &plan,
+    const std::vector<unsigned char>     &quadrature_indices,
+    const std::vector<Quadrature<dim>>   &quadratures,
+    const DoFHandler<dim, spacedim>      &dof_handler,
+    const Mapping<dim, spacedim>         &mapping,
+    const Vector<double>                 &solution,
+    const ShapeValueCache<dim, spacedim> *shape_value_cache)
+  {
+    std::vector<PartInteractionData<dim, spacedim>> parts(1);
+    parts[0].kernel_name        = kernel_name;
+    parts[0].native_kernel      = get_native_ib_kernel(kernel_name);
+    parts[0].patch_map          = &patch_map;
+    parts[0].plan               = &plan;
+    parts[0].quadrature_indices = &quadrature_indices;
+    parts[0].quadratures        = &quadratures;
+    parts[0].dof_handler        = &dof_handler;
+    parts[0].mapping            = &mapping;
+    parts[0].shape_value_cache  = shape_value_cache;
+    compute_spread(data_idx, parts, {&solution});
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  compute_spread(
+    const int                                              data_idx,
+    const std::vector<PartInteractionData<dim, spacedim>> &parts,
+    const std::vector<const Vector<double> *>             &solutions)
+  {
+#define ARGUMENTS data_idx, parts, solutions
+    if (parts.size() != 0 && parts[0].patch_map->size() != 0)
       {
-        auto patch_data = patch_map.get_patch(0)->getPatchData(data_idx);
-        auto pair       = extract_types(patch_data);
+        auto patch_data =
+          parts[0].patch_map->get_patch(0)->getPatchData(data_idx);
+        auto pair = extract_types(patch_data);
 
         AssertThrow(pair.second == SAMRAIFieldType::Double,
                     ExcNotImplemented());
@@ -1010,6 +1817,7 @@ namespace fdl
     const auto n_components =
       spread_values.size() / (position.size() / spacedim);
 
+    const NativeIBKernel native_kernel = get_native_ib_kernel(kernel_name);
     for (std::size_t patch_n = 0; patch_n < patch_map.size(); ++patch_n)
       {
         std::pair<const IndexSet &, tbox::Pointer<hier::Patch<spacedim>>> p =
@@ -1035,16 +1843,16 @@ namespace fdl
             Assert(values_view.size() % n_components == 0,
                    ExcFDLInternalError());
 
-            IBTK::LEInteractor::spread(patch_data,
-                                       values_view.data(),
-                                       values_view.size(),
-                                       n_components,
-                                       position_view.data(),
-                                       position_view.size(),
-                                       spacedim,
-                                       patch,
-                                       patch->getBox(),
-                                       kernel_name);
+            spread_to_patch(patch_data,
+                            values_view.data(),
+                            values_view.size(),
+                            n_components,
+                            position_view.data(),
+                            position_view.size(),
+                            patch,
+                            patch->getBox(),
+                            kernel_name,
+                            native_kernel);
           }
       }
   }
@@ -1114,6 +1922,69 @@ namespace fdl
             const int                                             tag_index,
             SAMRAI::tbox::Pointer<SAMRAI::hier::PatchLevel<NDIM>> patch_level);
 
+  template void
+  compute_interaction_plan(
+    const PatchMap<NDIM - 1, NDIM>          &patch_map,
+    const Mapping<NDIM - 1, NDIM>           &position_mapping,
+    const std::vector<unsigned char>        &quadrature_indices,
+    const std::vector<Quadrature<NDIM - 1>> &quadratures,
+    InteractionPlan<NDIM - 1, NDIM>         &plan);
+
+  template void
+  compute_interaction_plan(const PatchMap<NDIM, NDIM>       &patch_map,
+                           const Mapping<NDIM, NDIM>        &position_mapping,
+                           const std::vector<unsigned char> &quadrature_indices,
+                           const std::vector<Quadrature<NDIM>> &quadratures,
+                           InteractionPlan<NDIM, NDIM>         &plan);
+
+  template void
+  compute_interaction_plan(
+    const PatchMap<NDIM - 1, NDIM>          &patch_map,
+    const DoFHandler<NDIM - 1, NDIM>        &position_dof_handler,
+    const Vector<double>                    &position,
+    const std::vector<unsigned char>        &quadrature_indices,
+    const std::vector<Quadrature<NDIM - 1>> &quadratures,
+    InteractionPlan<NDIM - 1, NDIM>         &plan);
+
+  template void
+  compute_interaction_plan(
+    const PatchMap<NDIM, NDIM>          &patch_map,
+    const DoFHandler<NDIM, NDIM>        &position_dof_handler,
+    const Vector<double>                &position,
+    const std::vector<unsigned char>    &quadrature_indices,
+    const std::vector<Quadrature<NDIM>> &quadratures,
+    InteractionPlan<NDIM, NDIM>         &plan);
+
+  template void
+  morton_order_interaction_plan(const PatchMap<NDIM - 1, NDIM> &patch_map,
+                                InteractionPlan<NDIM - 1, NDIM> &plan);
+
+  template void
+  morton_order_interaction_plan(const PatchMap<NDIM, NDIM> &patch_map,
+                                InteractionPlan<NDIM, NDIM> &plan);
+
+  template bool
+  supports_shape_value_cache(const FiniteElement<NDIM - 1, NDIM> &fe);
+
+  template bool
+  supports_shape_value_cache(const FiniteElement<NDIM, NDIM> &fe);
+
+  template void
+  compute_shape_value_cache(
+    const DoFHandler<NDIM - 1, NDIM>        &dof_handler,
+    const Mapping<NDIM - 1, NDIM>           &mapping,
+    const std::vector<unsigned char>        &quadrature_indices,
+    const std::vector<Quadrature<NDIM - 1>> &quadratures,
+    ShapeValueCache<NDIM - 1, NDIM>         &shape_value_cache);
+
+  template void
+  compute_shape_value_cache(
+    const DoFHandler<NDIM, NDIM>        &dof_handler,
+    const Mapping<NDIM, NDIM>           &mapping,
+    const std::vector<unsigned char>    &quadrature_indices,
+    const std::vector<Quadrature<NDIM>> &quadratures,
+    ShapeValueCache<NDIM, NDIM>         &shape_value_cache);
+
   template void
   count_quadrature_points(const int                         qp_data_idx,
                           PatchMap<NDIM - 1, NDIM>         &patch_map,
@@ -1128,6 +1999,16 @@ namespace fdl
                           const std::vector<unsigned char> &quadrature_indices,
                           const std::vector<Quadrature<NDIM>> &quadratures);
 
+  template void
+  count_quadrature_points(const int                              qp_data_idx,
+                          PatchMap<NDIM - 1, NDIM>              &patch_map,
+                          const InteractionPlan<NDIM - 1, NDIM> &plan);
+
+  template void
+  count_quadrature_points(const int                          qp_data_idx,
+                          PatchMap<NDIM, NDIM>              &patch_map,
+                          const InteractionPlan<NDIM, NDIM> &plan);
+
   template void
   count_nodes(const int                      node_count_data_idx,
               NodalPatchMap<NDIM - 1, NDIM> &nodal_patch_map,
@@ -1160,6 +2041,44 @@ namespace fdl
                          const Mapping<NDIM>                 &mapping,
                          Vector<double>                      &rhs);
 
+  template void
+  compute_projection_rhs(
+    const std::string                       &kernel_name,
+    const int                                data_idx,
+    const PatchMap<NDIM - 1, NDIM>          &patch_map,
+    const InteractionPlan<NDIM - 1, NDIM>   &plan,
+    const std::vector<unsigned char>        &quadrature_indices,
+    const std::vector<Quadrature<NDIM - 1>> &quadratures,
+    const DoFHandler<NDIM - 1, NDIM>        &dof_handler,
+    const Mapping<NDIM - 1, NDIM>           &mapping,
+    Vector<double>                          &rhs,
+    const ShapeValueCache<NDIM - 1, NDIM>   *shape_value_cache);
+
+  template void
+  compute_projection_rhs(
+    const std::string                   &kernel_name,
+    const int                            data_idx,
+    const PatchMap<NDIM>                &patch_map,
+    const InteractionPlan<NDIM>         &plan,
+    const std::vector<unsigned char>    &quadrature_indices,
+    const std::vector<Quadrature<NDIM>> &quadratures,
+    const DoFHandler<NDIM>              &dof_handler,
+    const Mapping<NDIM>                 &mapping,
+    Vector<double>                      &rhs,
+    const ShapeValueCache<NDIM>         *shape_value_cache);
+
+  template void
+  compute_projection_rhs(
+    const int                                            data_idx,
+    const std::vector<PartInteractionData<NDIM - 1, NDIM>> &parts,
+    const std::vector<Vector<double> *>                  &rhs);
+
+  template void
+  compute_projection_rhs(
+    const int                                        data_idx,
+    const std::vector<PartInteractionData<NDIM, NDIM>> &parts,
+    const std::vector<Vector<double> *>              &rhs);
+
   template void
   compute_nodal_interpolation(const std::string                   &kernel_name,
                               const int                            data_idx,
@@ -1197,6 +2116,42 @@ namespace fdl
                  const Mapping<NDIM, NDIM>           &mapping,
                  const Vector<double>                &solution);
 
+  template void
+  compute_spread(const std::string                       &kernel_name,
+                 const int                                data_idx,
+                 PatchMap<NDIM - 1, NDIM>                &patch_map,
+                 const InteractionPlan<NDIM - 1, NDIM>   &plan,
+                 const std::vector<unsigned char>        &quadrature_indices,
+                 const std::vector<Quadrature<NDIM - 1>> &quadratures,
+                 const DoFHandler<NDIM - 1, NDIM>        &dof_handler,
+                 const Mapping<NDIM - 1, NDIM>           &mapping,
+                 const Vector<double>                    &solution,
+                 const ShapeValueCache<NDIM - 1, NDIM>   *shape_value_cache);
+
+  template void
+  compute_spread(const std::string                   &kernel_name,
+                 const int                            data_idx,
+                 PatchMap<NDIM, NDIM>                &patch_map,
+                 const InteractionPlan<NDIM, NDIM>   &plan,
+                 const std::vector<unsigned char>    &quadrature_indices,
+                 const std::vector<Quadrature<NDIM>> &quadratures,
+                 const DoFHandler<NDIM, NDIM>        &dof_handler,
+                 const Mapping<NDIM, NDIM>           &mapping,
+                 const Vector<double>                &solution,
+                 const ShapeValueCache<NDIM, NDIM>   *shape_value_cache);
+
+  template void
+  compute_spread(
+    const int                                            data_idx,
+    const std::vector<PartInteractionData<NDIM - 1, NDIM>> &parts,
+    const std::vector<const Vector<double> *>            &solutions);
+
+  template void
+  compute_spread(
+    const int                                        data_idx,
+    const std::vector<PartInteractionData<NDIM, NDIM>> &parts,
+    const std::vector<const Vector<double> *>        &solutions);
+
   template void
   compute_nodal_spread(const std::string             &kernel_name,
                        const int                      data_idx,
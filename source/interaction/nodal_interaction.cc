@@ -81,14 +81,29 @@ namespace fdl
       this->return_scatter(position_dof_handler, std::move(scatter));
     }
 
-    // TODO - same as InteractionBase - add extra_ghost_cell_fraction as an
-    // input argument
     nodal_patch_map.reinit(extract_patches(
                              patch_hierarchy->getPatchLevel(level_number)),
-                           1.0,
+                           this->extra_ghost_cell_fraction,
                            overlap_position);
   }
 
+  template <int dim, int spacedim>
+  bool
+  NodalInteraction<dim, spacedim>::reinit_patches(
+    tbox::Pointer<hier::BasePatchHierarchy<spacedim>> p_hierarchy,
+    const int                                         l_number,
+    const double                                      max_displacement)
+  {
+    if (!InteractionBase<dim, spacedim>::reinit_patches(p_hierarchy,
+                                                        l_number,
+                                                        max_displacement))
+      return false;
+
+    nodal_patch_map.reinit_patches(
+      extract_patches(p_hierarchy->getPatchLevel(l_number)));
+    return true;
+  }
+
   template <int dim, int spacedim>
   void
   NodalInteraction<dim, spacedim>::add_dof_handler(
@@ -100,11 +115,11 @@ namespace fdl
                 ExcMessage("The DoFHandler must use the underlying native "
                            "triangulation."));
     const auto ptr = &native_dof_handler;
-    if (std::find(this->native_dof_handlers.begin(),
-                  this->native_dof_handlers.end(),
-                  ptr) == this->native_dof_handlers.end())
+    if (!this->dof_handler_is_current(native_dof_handler))
       {
         this->native_dof_handlers.emplace_back(ptr);
+        this->native_locally_owned_dofs.emplace_back(
+          native_dof_handler.locally_owned_dofs());
         this->overlap_dof_handlers.emplace_back(
           std::make_unique<DoFHandler<dim, spacedim>>(this->overlap_tria));
         auto &overlap_dof_handler = *this->overlap_dof_handlers.back();
@@ -202,11 +217,7 @@ namespace fdl
            ExcMessage("Transaction state should be Intermediate"));
 
     // Finish communication:
-    trans.position_scatter.global_to_overlap_finish(*trans.native_position,
-                                                    trans.overlap_position);
-
-    trans.solution_scatter.global_to_overlap_finish(*trans.native_solution,
-                                                    trans.overlap_solution);
+    this->finish_spread_scatters(trans);
 
     // Actually do the spreading:
     compute_nodal_spread(trans.kernel_name,
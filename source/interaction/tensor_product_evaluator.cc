@@ -0,0 +1,160 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/interaction/tensor_product_evaluator.h>
+
+#include <deal.II/base/polynomial.h>
+#include <deal.II/base/utilities.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_tools.h>
+
+#include <algorithm>
+
+namespace fdl
+{
+  using namespace dealii;
+
+  template <int dim, int spacedim>
+  bool
+  TensorProductEvaluator<dim, spacedim>::is_supported(
+    const FiniteElement<dim, spacedim> &fe,
+    const Quadrature<dim>              &quadrature)
+  {
+    if (!quadrature.is_tensor_product())
+      return false;
+
+    // FiniteElement::base_element(0) is the element itself for non-FESystem
+    // elements
+    for (unsigned int b = 0; b < fe.n_base_elements(); ++b)
+      {
+        const auto *fe_q =
+          dynamic_cast<const FE_Q<dim, spacedim> *>(&fe.base_element(b));
+        if (fe_q == nullptr || fe_q->degree != fe.base_element(0).degree)
+          return false;
+      }
+
+    return true;
+  }
+
+
+
+  template <int dim, int spacedim>
+  TensorProductEvaluator<dim, spacedim>::TensorProductEvaluator(
+    const FiniteElement<dim, spacedim> &fe,
+    const Quadrature<dim>              &quadrature)
+    : n_vector_components(fe.n_components())
+    , n_dofs_1d(fe.base_element(0).degree + 1)
+  {
+    AssertThrow(is_supported(fe, quadrature),
+                ExcMessage("This class requires an FE_Q-based element and a "
+                           "tensor-product quadrature rule."));
+    const FiniteElement<dim, spacedim> &fe_q = fe.base_element(0);
+    const std::vector<unsigned int>     hierarchic_to_lexicographic =
+      FETools::hierarchic_to_lexicographic_numbering<dim>(fe_q.degree);
+
+    // The first n_dofs_1d lexicographic support points lie on the x-axis, so
+    // we can recover the 1D support points from them. This works with FE_Q
+    // objects created with any set of support points.
+    std::vector<Point<1>> support_points_1d(n_dofs_1d);
+    for (unsigned int h = 0; h < fe_q.dofs_per_cell; ++h)
+      if (hierarchic_to_lexicographic[h] < n_dofs_1d)
+        support_points_1d[hierarchic_to_lexicographic[h]][0] =
+          fe_q.get_unit_support_points()[h][0];
+    const std::vector<Polynomials::Polynomial<double>> basis_1d =
+      Polynomials::generate_complete_Lagrange_basis(support_points_1d);
+
+    const auto &quadratures_1d = quadrature.get_tensor_basis();
+    for (unsigned int d = 0; d < dim; ++d)
+      {
+        const Quadrature<1> &quadrature_1d = quadratures_1d[d];
+        n_q_points_1d[d]                   = quadrature_1d.size();
+        shape_values_1d[d].resize(n_q_points_1d[d] * n_dofs_1d);
+        for (unsigned int q = 0; q < n_q_points_1d[d]; ++q)
+          for (unsigned int i = 0; i < n_dofs_1d; ++i)
+            shape_values_1d[d][q * n_dofs_1d + i] =
+              basis_1d[i].value(quadrature_1d.point(q)[0]);
+      }
+
+    const unsigned int n_dofs_per_component = fe_q.dofs_per_cell;
+    lexicographic_dofs.resize(fe.dofs_per_cell);
+    for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+      {
+        const auto pair = fe.system_to_component_index(i);
+        lexicographic_dofs[pair.first * n_dofs_per_component +
+                           hierarchic_to_lexicographic[pair.second]] = i;
+      }
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  TensorProductEvaluator<dim, spacedim>::evaluate(
+    const double        *dof_values,
+    double              *values,
+    std::vector<double> &scratch) const
+  {
+    const unsigned int n_dofs = Utilities::fixed_power<dim>(n_dofs_1d);
+
+    // Size of the largest intermediate result:
+    unsigned int buffer_size = 1;
+    for (unsigned int d = 0; d < dim; ++d)
+      buffer_size *= std::max(n_dofs_1d, n_q_points_1d[d]);
+    scratch.resize(2 * buffer_size);
+
+    for (unsigned int c = 0; c < n_vector_components; ++c)
+      {
+        double *in  = scratch.data();
+        double *out = scratch.data() + buffer_size;
+        for (unsigned int l = 0; l < n_dofs; ++l)
+          in[l] = dof_values[lexicographic_dofs[c * n_dofs + l]];
+
+        // Apply the 1D shape function values in each coordinate direction.
+        // Both lexicographic DoFs and tensor-product quadrature points are
+        // ordered with the first coordinate varying fastest.
+        std::array<unsigned int, dim> extents;
+        std::fill(extents.begin(), extents.end(), n_dofs_1d);
+        for (unsigned int d = 0; d < dim; ++d)
+          {
+            unsigned int stride = 1;
+            for (unsigned int e = 0; e < d; ++e)
+              stride *= extents[e];
+            unsigned int n_outer = 1;
+            for (unsigned int e = d + 1; e < dim; ++e)
+              n_outer *= extents[e];
+
+            const unsigned int  n_q          = n_q_points_1d[d];
+            const double *const shape_values = shape_values_1d[d].data();
+            for (unsigned int o = 0; o < n_outer; ++o)
+              for (unsigned int q = 0; q < n_q; ++q)
+                {
+                  const double *const q_shape_values =
+                    shape_values + q * n_dofs_1d;
+                  double *const q_out = out + (o * n_q + q) * stride;
+                  for (unsigned int s = 0; s < stride; ++s)
+                    q_out[s] = 0.0;
+                  for (unsigned int i = 0; i < n_dofs_1d; ++i)
+                    {
+                      const double *const i_in =
+                        in + (o * n_dofs_1d + i) * stride;
+                      for (unsigned int s = 0; s < stride; ++s)
+                        q_out[s] += q_shape_values[i] * i_in[s];
+                    }
+                }
+
+            extents[d] = n_q;
+            std::swap(in, out);
+          }
+
+        const unsigned int n_q = n_q_points();
+        for (unsigned int q = 0; q < n_q; ++q)
+          values[q * n_vector_components + c] = in[q];
+      }
+  }
+
+
+
+  // instantiations
+  template class TensorProductEvaluator<NDIM - 1, NDIM>;
+  template class TensorProductEvaluator<NDIM, NDIM>;
+} // namespace fdl
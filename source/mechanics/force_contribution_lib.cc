@@ -117,6 +117,34 @@ namespace fdl
     current_position = nullptr;
   }
 
+  template <int dim, int spacedim, typename Number>
+  std::vector<Tensor<1, spacedim>>
+  SpringForceBase<dim, spacedim, Number>::compute_spring_force_values(
+    const FEValuesBase<dim, spacedim> &fe_values) const
+  {
+    // This function may be called by several threads at once so all
+    // temporary arrays are local variables
+    const auto cell = fe_values.get_cell();
+    const auto dof_cell =
+      typename DoFHandler<dim, spacedim>::active_cell_iterator(
+        &dof_handler->get_triangulation(),
+        cell->level(),
+        cell->index(),
+        &*dof_handler);
+
+    std::vector<types::global_dof_index> cell_dofs(fe_values.dofs_per_cell);
+    dof_cell->get_dof_indices(cell_dofs);
+    std::vector<double> dof_values(fe_values.dofs_per_cell);
+    for (unsigned int i = 0; i < cell_dofs.size(); ++i)
+      dof_values[i] = spring_constant * (reference_position[cell_dofs[i]] -
+                                         (*current_position)[cell_dofs[i]]);
+
+    std::vector<Tensor<1, spacedim>> qp_values(fe_values.n_quadrature_points);
+    fe_values[FEValuesExtractors::Vector(0)]
+      .get_function_values_from_local_dof_values(dof_values, qp_values);
+    return qp_values;
+  }
+
   //
   // SpringForce
   //
@@ -197,31 +225,9 @@ namespace fdl
       }
     else
       {
-        const FEValuesBase<dim, spacedim> &fe_values = m_values.get_fe_values();
-
-        const auto dof_cell =
-          typename DoFHandler<dim, spacedim>::active_cell_iterator(
-            &this->dof_handler->get_triangulation(),
-            cell->level(),
-            cell->index(),
-            &*this->dof_handler);
-
-        this->scratch_cell_dofs.resize(fe_values.dofs_per_cell);
-        dof_cell->get_dof_indices(this->scratch_cell_dofs);
-        this->scratch_dof_values.resize(fe_values.dofs_per_cell);
-        this->scratch_qp_values.resize(fe_values.n_quadrature_points);
-
-        auto &extractor = fe_values[FEValuesExtractors::Vector(0)];
-        for (unsigned int i = 0; i < this->scratch_cell_dofs.size(); ++i)
-          this->scratch_dof_values[i] =
-            this->spring_constant *
-            (this->reference_position[this->scratch_cell_dofs[i]] -
-             (*this->current_position)[this->scratch_cell_dofs[i]]);
-        extractor.get_function_values_from_local_dof_values(
-          this->scratch_dof_values, this->scratch_qp_values);
-        std::copy(this->scratch_qp_values.begin(),
-                  this->scratch_qp_values.end(),
-                  forces.begin());
+        const std::vector<Tensor<1, spacedim>> qp_values =
+          this->compute_spring_force_values(m_values.get_fe_values());
+        std::copy(qp_values.begin(), qp_values.end(), forces.begin());
       }
   }
 
@@ -298,6 +304,13 @@ namespace fdl
     return true;
   }
 
+  template <int dim, int spacedim, typename Number>
+  std::vector<types::boundary_id>
+  BoundarySpringForce<dim, spacedim, Number>::get_boundary_ids() const
+  {
+    return boundary_ids;
+  }
+
   template <int dim, int spacedim, typename Number>
   void
   BoundarySpringForce<dim, spacedim, Number>::compute_boundary_force(
@@ -318,31 +331,9 @@ namespace fdl
       }
     else
       {
-        const FEValuesBase<dim, spacedim> &fe_values = m_values.get_fe_values();
-        const auto                         cell      = fe_values.get_cell();
-        const auto                         dof_cell =
-          typename DoFHandler<dim, spacedim>::active_cell_iterator(
-            &this->dof_handler->get_triangulation(),
-            cell->level(),
-            cell->index(),
-            &*this->dof_handler);
-
-        this->scratch_cell_dofs.resize(fe_values.dofs_per_cell);
-        dof_cell->get_dof_indices(this->scratch_cell_dofs);
-        this->scratch_dof_values.resize(fe_values.dofs_per_cell);
-        this->scratch_qp_values.resize(fe_values.n_quadrature_points);
-
-        auto &extractor = fe_values[FEValuesExtractors::Vector(0)];
-        for (unsigned int i = 0; i < this->scratch_cell_dofs.size(); ++i)
-          this->scratch_dof_values[i] =
-            this->spring_constant *
-            (this->reference_position[this->scratch_cell_dofs[i]] -
-             (*this->current_position)[this->scratch_cell_dofs[i]]);
-        extractor.get_function_values_from_local_dof_values(
-          this->scratch_dof_values, this->scratch_qp_values);
-        std::copy(this->scratch_qp_values.begin(),
-                  this->scratch_qp_values.end(),
-                  forces.begin());
+        const std::vector<Tensor<1, spacedim>> qp_values =
+          this->compute_spring_force_values(m_values.get_fe_values());
+        std::copy(qp_values.begin(), qp_values.end(), forces.begin());
       }
   }
 
@@ -473,6 +464,13 @@ namespace fdl
     return true;
   }
 
+  template <int dim, int spacedim, typename Number>
+  std::vector<types::boundary_id>
+  OrthogonalSpringDashpotForce<dim, spacedim, Number>::get_boundary_ids() const
+  {
+    return boundary_ids;
+  }
+
   template <int dim, int spacedim, typename Number>
   void
   OrthogonalSpringDashpotForce<dim, spacedim, Number>::compute_boundary_force(
@@ -493,41 +491,16 @@ namespace fdl
       }
     else
       {
-        const FEValuesBase<dim, spacedim> &fe_values = m_values.get_fe_values();
-        const auto                         cell      = fe_values.get_cell();
-        const auto                         dof_cell =
-          typename DoFHandler<dim, spacedim>::active_cell_iterator(
-            &this->dof_handler->get_triangulation(),
-            cell->level(),
-            cell->index(),
-            &*this->dof_handler);
-
-        this->scratch_cell_dofs.resize(fe_values.dofs_per_cell);
-        dof_cell->get_dof_indices(this->scratch_cell_dofs);
-        this->scratch_dof_values.resize(fe_values.dofs_per_cell);
-        this->scratch_qp_values.resize(fe_values.n_quadrature_points);
-
-        auto &extractor = fe_values[FEValuesExtractors::Vector(0)];
-
-        for (unsigned int i = 0; i < this->scratch_cell_dofs.size(); ++i)
-          this->scratch_dof_values[i] =
-            this->spring_constant *
-            (this->reference_position[this->scratch_cell_dofs[i]] -
-             (*this->current_position)[this->scratch_cell_dofs[i]]);
-
-        extractor.get_function_values_from_local_dof_values(
-          this->scratch_dof_values, this->scratch_qp_values);
-
-        for (unsigned int i = 0; i < this->scratch_qp_values.size(); ++i)
-          this->scratch_qp_values[i] =
+        std::vector<Tensor<1, spacedim>> qp_values =
+          this->compute_spring_force_values(m_values.get_fe_values());
+        for (unsigned int i = 0; i < qp_values.size(); ++i)
+          qp_values[i] =
             m_values.get_deformed_normal_vectors()[i] *
-            (this->scratch_qp_values[i] -
+            (qp_values[i] -
              this->damping_constant * m_values.get_velocity_values()[i]) *
             m_values.get_deformed_normal_vectors()[i];
 
-        std::copy(this->scratch_qp_values.begin(),
-                  this->scratch_qp_values.end(),
-                  forces.begin());
+        std::copy(qp_values.begin(), qp_values.end(), forces.begin());
       }
   }
 
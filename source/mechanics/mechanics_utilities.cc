@@ -1,22 +1,361 @@
 #include <fiddle/mechanics/mechanics_utilities.h>
 #include <fiddle/mechanics/mechanics_values.h>
 
+#include <deal.II/base/aligned_vector.h>
 #include <deal.II/base/array_view.h>
 #include <deal.II/base/tensor.h>
+#include <deal.II/base/vectorization.h>
+#include <deal.II/base/work_stream.h>
 
 #include <deal.II/fe/fe_update_flags.h>
 #include <deal.II/fe/fe_values.h>
 
+#include <deal.II/grid/filtered_iterator.h>
+#include <deal.II/grid/reference_cell.h>
+
 #include <deal.II/lac/la_parallel_vector.h>
 #include <deal.II/lac/vector.h>
 
+#include <deal.II/matrix_free/evaluation_flags.h>
+#include <deal.II/matrix_free/fe_evaluation.h>
+
 #include <algorithm>
+#include <map>
+#include <numeric>
 #include <vector>
 
 namespace fdl
 {
   using namespace dealii;
 
+  namespace internal
+  {
+    /**
+     * Per-thread scratch data for the WorkStream loops in
+     * compute_load_vector() and compute_boundary_force_load_vector(). FEValues
+     * objects cannot be copied so the copy constructor sets up new ones with
+     * the same parameters.
+     */
+    template <int dim, int spacedim, typename FEValuesType, int q_dim>
+    struct LoadVectorScratchData
+    {
+      LoadVectorScratchData(
+        const Mapping<dim, spacedim>                     &mapping,
+        const FiniteElement<dim, spacedim>               &fe,
+        const Quadrature<q_dim>                          &quadrature,
+        const UpdateFlags                                 update_flags,
+        const LinearAlgebra::distributed::Vector<double> &position,
+        const LinearAlgebra::distributed::Vector<double> &velocity,
+        const MechanicsUpdateFlags                        me_flags)
+        : quadrature(quadrature)
+        , position(&position)
+        , velocity(&velocity)
+        , fe_values(mapping, fe, quadrature, update_flags)
+        , me_values(fe_values, position, velocity, me_flags)
+        // Normal vectors are not available in batches, but only boundary
+        // forces (which are never batched) need them.
+        , batch_scratch(static_cast<MechanicsUpdateFlags>(
+            static_cast<unsigned int>(me_flags) &
+            ~static_cast<unsigned int>(
+              MechanicsUpdateFlags::update_deformed_normal_vectors)))
+        , one_stress(quadrature.size())
+        , accumulated_stresses(quadrature.size())
+        , one_force(quadrature.size())
+        , accumulated_forces(quadrature.size())
+      {}
+
+      LoadVectorScratchData(const LoadVectorScratchData &other)
+        : LoadVectorScratchData(other.fe_values.get_mapping(),
+                                other.fe_values.get_fe(),
+                                other.quadrature,
+                                other.fe_values.get_update_flags(),
+                                *other.position,
+                                *other.velocity,
+                                other.me_values.get_update_flags())
+      {}
+
+      Quadrature<q_dim> quadrature;
+
+      const LinearAlgebra::distributed::Vector<double> *position;
+
+      const LinearAlgebra::distributed::Vector<double> *velocity;
+
+      FEValuesType fe_values;
+
+      MechanicsValues<dim,
+                      spacedim,
+                      LinearAlgebra::distributed::Vector<double>>
+        me_values;
+
+      typename ForceContribution<dim, spacedim>::BatchScratch batch_scratch;
+
+      std::vector<Tensor<2, spacedim, double>> one_stress;
+
+      std::vector<Tensor<2, spacedim, double>> accumulated_stresses;
+
+      std::vector<Tensor<1, spacedim, double>> one_force;
+
+      std::vector<Tensor<1, spacedim, double>> accumulated_forces;
+    };
+
+    /**
+     * Per-cell output of the WorkStream loops: the right-hand side vector is
+     * only modified by the (sequential) copier.
+     */
+    struct LoadVectorCopyData
+    {
+      std::vector<types::global_dof_index> cell_dofs;
+
+      std::vector<double> cell_rhs;
+    };
+
+
+
+    /**
+     * Per-thread scratch data for the WorkStream loop over cell batches in
+     * compute_batched_load_vector(). FEEvaluation objects are tied to a
+     * MatrixFree object so, like LoadVectorScratchData, the copy constructor
+     * sets up new ones.
+     */
+    template <int dim>
+    struct BatchedLoadVectorScratchData
+    {
+      using VectorizedArrayType = VectorizedArray<double>;
+
+      BatchedLoadVectorScratchData(const MatrixFree<dim, double> &matrix_free,
+                                   const unsigned int             quad_index,
+                                   const MechanicsUpdateFlags     me_flags)
+        : quad_index(quad_index)
+        , position_eval(matrix_free, 0, quad_index)
+        , velocity_eval(matrix_free, 0, quad_index)
+        , me_values(me_flags)
+        , cells(VectorizedArrayType::size())
+        , accumulated_stresses(position_eval.n_q_points)
+        , accumulated_forces(position_eval.n_q_points)
+      {
+        if (me_flags & update_FF)
+          FF.resize(position_eval.n_q_points);
+        if (me_flags & update_position_values)
+          positions.resize(position_eval.n_q_points);
+        if (me_flags & update_velocity_values)
+          velocities.resize(position_eval.n_q_points);
+      }
+
+      BatchedLoadVectorScratchData(const BatchedLoadVectorScratchData &other)
+        : BatchedLoadVectorScratchData(other.position_eval.get_matrix_free(),
+                                       other.quad_index,
+                                       other.me_values.get_update_flags())
+      {}
+
+      unsigned int quad_index;
+
+      // Use the degree of the finite element at run time so that we do not
+      // need to instantiate this for each degree:
+      FEEvaluation<dim, -1, 0, dim, double> position_eval;
+
+      FEEvaluation<dim, -1, 0, dim, double> velocity_eval;
+
+      BatchedMechanicsValues<dim, dim, double> me_values;
+
+      std::vector<typename Triangulation<dim>::active_cell_iterator> cells;
+
+      std::vector<Tensor<2, dim, VectorizedArrayType>> FF;
+
+      std::vector<Tensor<1, dim, VectorizedArrayType>> positions;
+
+      std::vector<Tensor<1, dim, VectorizedArrayType>> velocities;
+
+      std::vector<Tensor<2, dim, VectorizedArrayType>> accumulated_stresses;
+
+      std::vector<Tensor<1, dim, VectorizedArrayType>> accumulated_forces;
+    };
+
+    /**
+     * Per-batch output of the WorkStream loop in
+     * compute_batched_load_vector(): the integrated (but not yet scattered)
+     * values of each DoF on each lane.
+     */
+    struct BatchedLoadVectorCopyData
+    {
+      unsigned int batch_n;
+
+      AlignedVector<VectorizedArray<double>> dof_values;
+    };
+
+    // MatrixFree doesn't work with codim != 0 so we need two versions of this
+    // function. All forces must use the quadrature rule with index
+    // quad_index in matrix_free.
+    template <int dim>
+    void
+    compute_batched_load_vector(
+      const MatrixFree<dim, double>                    &matrix_free,
+      const unsigned int                                quad_index,
+      const std::vector<ForceContribution<dim, dim> *> &force_contributions,
+      const double                                      time,
+      const LinearAlgebra::distributed::Vector<double> &current_position,
+      const LinearAlgebra::distributed::Vector<double> &current_velocity,
+      LinearAlgebra::distributed::Vector<double>       &force_rhs)
+    {
+      using VectorizedArrayType = VectorizedArray<double>;
+      if (force_contributions.size() == 0)
+        return;
+
+      const bool have_stress =
+        std::any_of(force_contributions.begin(),
+                    force_contributions.end(),
+                    [](const ForceContribution<dim, dim> *fc) {
+                      return fc->is_stress();
+                    });
+      const bool have_force =
+        std::any_of(force_contributions.begin(),
+                    force_contributions.end(),
+                    [](const ForceContribution<dim, dim> *fc) {
+                      return fc->is_volume_force();
+                    });
+      MechanicsUpdateFlags me_flags = MechanicsUpdateFlags::update_nothing;
+      for (const ForceContribution<dim, dim> *fc : force_contributions)
+        me_flags |= fc->get_mechanics_update_flags();
+      // get the flags with their dependencies resolved
+      me_flags = BatchedMechanicsValues<dim, dim, double>(me_flags)
+                   .get_update_flags();
+
+      EvaluationFlags::EvaluationFlags evaluation_flags =
+        EvaluationFlags::nothing;
+      if (me_flags & update_FF)
+        evaluation_flags |= EvaluationFlags::gradients;
+      if (me_flags & update_position_values)
+        evaluation_flags |= EvaluationFlags::values;
+      EvaluationFlags::EvaluationFlags integration_flags =
+        EvaluationFlags::nothing;
+      if (have_stress)
+        integration_flags |= EvaluationFlags::gradients;
+      if (have_force)
+        integration_flags |= EvaluationFlags::values;
+
+      const unsigned int dofs_per_cell = matrix_free.get_dofs_per_cell();
+
+      using batch_iterator = std::vector<unsigned int>::const_iterator;
+      using ScratchData    = BatchedLoadVectorScratchData<dim>;
+      const auto worker = [&](const batch_iterator      &batch_it,
+                              ScratchData               &scratch,
+                              BatchedLoadVectorCopyData &copy_data) {
+        const unsigned int batch_n       = *batch_it;
+        auto              &position_eval = scratch.position_eval;
+        auto              &velocity_eval = scratch.velocity_eval;
+        const unsigned int n_q_points    = position_eval.n_q_points;
+        const unsigned int n_filled_lanes =
+          matrix_free.n_active_entries_per_cell_batch(batch_n);
+        for (unsigned int lane = 0; lane < n_filled_lanes; ++lane)
+          {
+            const auto cell = matrix_free.get_cell_iterator(batch_n, lane);
+            scratch.cells[lane] =
+              typename Triangulation<dim>::active_cell_iterator(
+                &cell->get_triangulation(), cell->level(), cell->index());
+          }
+
+        position_eval.reinit(batch_n);
+        if (evaluation_flags != EvaluationFlags::nothing)
+          position_eval.gather_evaluate(current_position, evaluation_flags);
+        if (me_flags & update_velocity_values)
+          {
+            velocity_eval.reinit(batch_n);
+            velocity_eval.gather_evaluate(current_velocity,
+                                          EvaluationFlags::values);
+          }
+        for (unsigned int qp_n = 0; qp_n < n_q_points; ++qp_n)
+          {
+            if (me_flags & update_FF)
+              scratch.FF[qp_n] = position_eval.get_gradient(qp_n);
+            if (me_flags & update_position_values)
+              scratch.positions[qp_n] = position_eval.get_value(qp_n);
+            if (me_flags & update_velocity_values)
+              scratch.velocities[qp_n] = velocity_eval.get_value(qp_n);
+          }
+        scratch.me_values.reinit(make_array_view(scratch.cells,
+                                                 0,
+                                                 n_filled_lanes),
+                                 make_array_view(scratch.FF),
+                                 make_array_view(scratch.positions),
+                                 make_array_view(scratch.velocities));
+
+        // The batched functions add their contributions directly, so we
+        // do not need any temporary arrays here
+        std::fill(scratch.accumulated_stresses.begin(),
+                  scratch.accumulated_stresses.end(),
+                  Tensor<2, dim, VectorizedArrayType>());
+        std::fill(scratch.accumulated_forces.begin(),
+                  scratch.accumulated_forces.end(),
+                  Tensor<1, dim, VectorizedArrayType>());
+        auto stress_view = make_array_view(scratch.accumulated_stresses);
+        auto force_view  = make_array_view(scratch.accumulated_forces);
+        for (const ForceContribution<dim, dim> *fc : force_contributions)
+          {
+            if (fc->is_stress())
+              fc->compute_stress_batch(time, scratch.me_values, stress_view);
+            else
+              fc->compute_volume_force_batch(time,
+                                             scratch.me_values,
+                                             force_view);
+          }
+
+        // -PP : grad phi dx + F . phi dx
+        for (unsigned int qp_n = 0; qp_n < n_q_points; ++qp_n)
+          {
+            if (have_stress)
+              position_eval.submit_gradient(
+                -scratch.accumulated_stresses[qp_n], qp_n);
+            if (have_force)
+              position_eval.submit_value(scratch.accumulated_forces[qp_n],
+                                         qp_n);
+          }
+        position_eval.integrate(integration_flags);
+
+        copy_data.batch_n = batch_n;
+        copy_data.dof_values.resize(dofs_per_cell);
+        std::copy(position_eval.begin_dof_values(),
+                  position_eval.begin_dof_values() + dofs_per_cell,
+                  copy_data.dof_values.begin());
+      };
+
+      // Only the (sequential) copier modifies the right-hand side vector
+      FEEvaluation<dim, -1, 0, dim, double> scatter_eval(matrix_free,
+                                                         0,
+                                                         quad_index);
+      const auto copier = [&](const BatchedLoadVectorCopyData &copy_data) {
+        scatter_eval.reinit(copy_data.batch_n);
+        std::copy(copy_data.dof_values.begin(),
+                  copy_data.dof_values.end(),
+                  scatter_eval.begin_dof_values());
+        scatter_eval.distribute_local_to_global(force_rhs);
+      };
+
+      std::vector<unsigned int> batches(matrix_free.n_cell_batches());
+      std::iota(batches.begin(), batches.end(), 0u);
+      WorkStream::run(batches.cbegin(),
+                      batches.cend(),
+                      worker,
+                      copier,
+                      ScratchData(matrix_free, quad_index, me_flags),
+                      BatchedLoadVectorCopyData());
+    }
+
+    template <int dim>
+    void
+    compute_batched_load_vector(
+      const MatrixFree<dim - 1, double> &,
+      const unsigned int,
+      const std::vector<ForceContribution<dim - 1, dim> *> &force_contributions,
+      const double,
+      const LinearAlgebra::distributed::Vector<double> &,
+      const LinearAlgebra::distributed::Vector<double> &,
+      LinearAlgebra::distributed::Vector<double> &)
+    {
+      // We shouldn't get here
+      (void)force_contributions;
+      Assert(force_contributions.size() == 0, ExcFDLInternalError());
+    }
+  } // namespace internal
+
   template <int dim, int spacedim>
   void
   compute_volumetric_pk1_load_vector(
@@ -79,6 +418,34 @@ namespace fdl
 
 
 
+  template <int dim, int spacedim>
+  std::vector<BoundaryFace<dim, spacedim>>
+  make_boundary_faces(const DoFHandler<dim, spacedim> &dof_handler)
+  {
+    std::vector<BoundaryFace<dim, spacedim>> boundary_faces;
+    for (const auto &cell : dof_handler.active_cell_iterators())
+      if (cell->is_locally_owned() && cell->at_boundary())
+        for (const auto &face_n : cell->face_indices())
+          // only apply forces on physical boundaries
+          if (!cell->has_periodic_neighbor(face_n) &&
+              cell->face(face_n)->at_boundary())
+            boundary_faces.push_back(
+              BoundaryFace<dim, spacedim>{cell,
+                                          face_n,
+                                          cell->face(face_n)->boundary_id()});
+
+    // Keep the cell order within each boundary id
+    std::stable_sort(boundary_faces.begin(),
+                     boundary_faces.end(),
+                     [](const BoundaryFace<dim, spacedim> &a,
+                        const BoundaryFace<dim, spacedim> &b) {
+                       return a.boundary_id < b.boundary_id;
+                     });
+    return boundary_faces;
+  }
+
+
+
   template <int dim, int spacedim>
   void
   compute_boundary_force_load_vector(
@@ -90,6 +457,35 @@ namespace fdl
     const LinearAlgebra::distributed::Vector<double> &current_position,
     const LinearAlgebra::distributed::Vector<double> &current_velocity,
     LinearAlgebra::distributed::Vector<double>       &force_rhs)
+  {
+    // Avoid looping over the cells when there is nothing to do
+    if (boundary_force_contributions.size() == 0)
+      return;
+
+    compute_boundary_force_load_vector(dof_handler,
+                                       mapping,
+                                       make_boundary_faces(dof_handler),
+                                       boundary_force_contributions,
+                                       time,
+                                       current_position,
+                                       current_velocity,
+                                       force_rhs);
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  compute_boundary_force_load_vector(
+    const DoFHandler<dim, spacedim>                &dof_handler,
+    const Mapping<dim, spacedim>                   &mapping,
+    const std::vector<BoundaryFace<dim, spacedim>> &boundary_faces,
+    const std::vector<ForceContribution<dim, spacedim> *>
+                &boundary_force_contributions,
+    const double time,
+    const LinearAlgebra::distributed::Vector<double> &current_position,
+    const LinearAlgebra::distributed::Vector<double> &current_velocity,
+    LinearAlgebra::distributed::Vector<double>       &force_rhs)
   {
     Assert(dim == spacedim, ExcNotImplemented());
 #ifdef DEBUG
@@ -100,6 +496,13 @@ namespace fdl
                ExcMessage("only valid for boundary forces"));
       }
 #endif
+    Assert(std::is_sorted(boundary_faces.begin(),
+                          boundary_faces.end(),
+                          [](const BoundaryFace<dim, spacedim> &a,
+                             const BoundaryFace<dim, spacedim> &b) {
+                            return a.boundary_id < b.boundary_id;
+                          }),
+           ExcMessage("The boundary faces should be sorted by boundary id."));
 
     // Batch forces by the quadrature rules they use
     std::vector<ForceContribution<dim, spacedim> *> remaining_forces =
@@ -133,70 +536,103 @@ namespace fdl
         // Add the stuff we need here too:
         update_flags |= update_values | update_JxW_values;
         const FiniteElement<dim, spacedim> &fe = dof_handler.get_fe();
+        const unsigned int n_quadrature_points = exemplar_quadrature.size();
 
-        FEFaceValues<dim, spacedim> fe_values(mapping,
-                                              fe,
-                                              exemplar_quadrature,
-                                              update_flags);
-        MechanicsValues<dim,
-                        spacedim,
-                        LinearAlgebra::distributed::Vector<double>>
-          me_values(fe_values, current_position, current_velocity, me_flags);
+        using face_iterator =
+          typename std::vector<BoundaryFace<dim, spacedim>>::const_iterator;
+        using ScratchData =
+          internal::LoadVectorScratchData<dim,
+                                          spacedim,
+                                          FEFaceValues<dim, spacedim>,
+                                          dim - 1>;
+        const ScratchData sample_scratch(mapping,
+                                         fe,
+                                         exemplar_quadrature,
+                                         update_flags,
+                                         current_position,
+                                         current_velocity,
+                                         me_flags);
+        const auto copier = [&](const internal::LoadVectorCopyData &copy_data) {
+          force_rhs.add(copy_data.cell_dofs, copy_data.cell_rhs);
+        };
 
-        const unsigned int n_quadrature_points = exemplar_quadrature.size();
-        std::vector<types::global_dof_index>     cell_dofs(fe.dofs_per_cell);
-        std::vector<double>                      cell_rhs(fe.dofs_per_cell);
-        std::vector<Tensor<1, spacedim, double>> one_force(n_quadrature_points);
-        std::vector<Tensor<1, spacedim, double>> accumulated_forces(
-          n_quadrature_points);
-        for (const auto &cell : dof_handler.active_cell_iterators())
-          if (cell->is_locally_owned() && cell->at_boundary())
-            for (const auto &face_n : cell->face_indices())
-              // only apply forces on physical boundaries
-              if (!cell->has_periodic_neighbor(face_n) &&
-                  cell->face(face_n)->at_boundary())
+        // The faces are sorted by boundary id so we can process each boundary
+        // id separately with only the forces which apply to it
+        face_iterator range_begin = boundary_faces.begin();
+        while (range_begin != boundary_faces.end())
+          {
+            const types::boundary_id boundary_id = range_begin->boundary_id;
+            const face_iterator      range_end =
+              std::find_if(range_begin,
+                           boundary_faces.end(),
+                           [&](const BoundaryFace<dim, spacedim> &face) {
+                             return face.boundary_id != boundary_id;
+                           });
+
+            std::vector<ForceContribution<dim, spacedim> *> id_forces;
+            for (auto *fc : current_forces)
+              {
+                const std::vector<types::boundary_id> ids =
+                  fc->get_boundary_ids();
+                if (ids.size() == 0 ||
+                    std::find(ids.begin(), ids.end(), boundary_id) != ids.end())
+                  id_forces.push_back(fc);
+              }
+
+            const auto worker = [&](const face_iterator          &face,
+                                    ScratchData                  &scratch,
+                                    internal::LoadVectorCopyData &copy_data) {
+              auto &fe_values = scratch.fe_values;
+              auto &me_values = scratch.me_values;
+              copy_data.cell_dofs.resize(fe.dofs_per_cell);
+              face->cell->get_dof_indices(copy_data.cell_dofs);
+              copy_data.cell_rhs.assign(fe.dofs_per_cell, 0.0);
+
+              fe_values.reinit(face->cell, face->face_n);
+              me_values.reinit(face->cell);
+              std::fill(scratch.accumulated_forces.begin(),
+                        scratch.accumulated_forces.end(),
+                        Tensor<1, spacedim, double>());
+              auto &extractor = fe_values[FEValuesExtractors::Vector(0)];
+
+              // Compute forces at quadrature points
+              for (const ForceContribution<dim, spacedim> *fc : id_forces)
                 {
-                  cell->get_dof_indices(cell_dofs);
-                  fe_values.reinit(cell, face_n);
-                  me_values.reinit(cell);
-                  std::fill(accumulated_forces.begin(),
-                            accumulated_forces.end(),
+                  std::fill(scratch.one_force.begin(),
+                            scratch.one_force.end(),
                             Tensor<1, spacedim, double>());
-                  std::fill(cell_rhs.begin(), cell_rhs.end(), 0.0);
-                  auto &extractor = fe_values[FEValuesExtractors::Vector(0)];
-
-                  // Compute forces at quadrature points
-                  for (const ForceContribution<dim, spacedim> *fc :
-                       current_forces)
-                    {
-                      std::fill(one_force.begin(),
-                                one_force.end(),
-                                Tensor<1, spacedim, double>());
-                      auto view =
-                        make_array_view(one_force.begin(), one_force.end());
-                      fc->compute_boundary_force(time,
-                                                 me_values,
-                                                 cell->face(face_n),
-                                                 view);
-                      for (unsigned int qp_n = 0; qp_n < n_quadrature_points;
-                           ++qp_n)
-                        accumulated_forces[qp_n] += one_force[qp_n];
-                    }
-
-                  // Assemble the RHS vector
-                  //
-                  // TODO - we could make this a lot faster by exploiting the
-                  // fact that we have primitive FEs most of the time
+                  auto view = make_array_view(scratch.one_force);
+                  fc->compute_boundary_force(time,
+                                             me_values,
+                                             face->cell->face(face->face_n),
+                                             view);
                   for (unsigned int qp_n = 0; qp_n < n_quadrature_points;
                        ++qp_n)
-                    for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
-                      // F . phi dx
-                      cell_rhs[i] += scalar_product(accumulated_forces[qp_n],
-                                                    extractor.value(i, qp_n)) *
-                                     fe_values.JxW(qp_n);
-
-                  force_rhs.add(cell_dofs, cell_rhs);
+                    scratch.accumulated_forces[qp_n] += scratch.one_force[qp_n];
                 }
+
+              // Assemble the RHS vector
+              //
+              // TODO - we could make this a lot faster by exploiting the fact
+              // that we have primitive FEs most of the time
+              for (unsigned int qp_n = 0; qp_n < n_quadrature_points; ++qp_n)
+                for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+                  // F . phi dx
+                  copy_data.cell_rhs[i] +=
+                    scalar_product(scratch.accumulated_forces[qp_n],
+                                   extractor.value(i, qp_n)) *
+                    fe_values.JxW(qp_n);
+            };
+
+            if (id_forces.size() > 0)
+              WorkStream::run(range_begin,
+                              range_end,
+                              worker,
+                              copier,
+                              sample_scratch,
+                              internal::LoadVectorCopyData());
+            range_begin = range_end;
+          }
       }
   }
 
@@ -293,106 +729,221 @@ namespace fdl
           update_flags |= update_gradients;
 
         const FiniteElement<dim, spacedim> &fe = dof_handler.get_fe();
+        const unsigned int n_quadrature_points = exemplar_quadrature.size();
 
-        FEValues<dim, spacedim> fe_values(mapping,
-                                          fe,
-                                          exemplar_quadrature,
-                                          update_flags);
-        MechanicsValues<dim,
-                        spacedim,
-                        LinearAlgebra::distributed::Vector<double>>
-          me_values(fe_values, current_position, current_velocity, me_flags);
+        using cell_iterator =
+          typename DoFHandler<dim, spacedim>::active_cell_iterator;
+        using ScratchData =
+          internal::LoadVectorScratchData<dim,
+                                          spacedim,
+                                          FEValues<dim, spacedim>,
+                                          dim>;
+        const auto worker = [&](const cell_iterator          &cell,
+                                ScratchData                  &scratch,
+                                internal::LoadVectorCopyData &copy_data) {
+          auto &fe_values = scratch.fe_values;
+          auto &me_values = scratch.me_values;
+          copy_data.cell_dofs.resize(fe.dofs_per_cell);
+          cell->get_dof_indices(copy_data.cell_dofs);
+          copy_data.cell_rhs.assign(fe.dofs_per_cell, 0.0);
+          fe_values.reinit(cell);
+          me_values.reinit(cell);
+          std::fill(scratch.accumulated_stresses.begin(),
+                    scratch.accumulated_stresses.end(),
+                    Tensor<2, spacedim, double>());
+          std::fill(scratch.accumulated_forces.begin(),
+                    scratch.accumulated_forces.end(),
+                    Tensor<1, spacedim, double>());
+          auto &extractor = fe_values[FEValuesExtractors::Vector(0)];
 
-        const unsigned int n_quadrature_points = exemplar_quadrature.size();
-        std::vector<types::global_dof_index>     cell_dofs(fe.dofs_per_cell);
-        std::vector<Tensor<2, spacedim, double>> one_stress(
-          n_quadrature_points);
-        std::vector<Tensor<2, spacedim, double>> accumulated_stresses(
-          n_quadrature_points);
-        std::vector<Tensor<1, spacedim, double>> one_force(n_quadrature_points);
-        std::vector<Tensor<1, spacedim, double>> accumulated_forces(
-          n_quadrature_points);
-        std::vector<double> cell_rhs(fe.dofs_per_cell);
-        for (const auto &cell : dof_handler.active_cell_iterators())
-          {
-            if (cell->is_locally_owned())
+          bool touched_stress = false;
+          bool touched_force  = false;
+          for (const ForceContribution<dim, spacedim> *fc : current_forces)
+            {
+              if (fc->is_stress())
+                {
+                  touched_stress = true;
+                  std::fill(scratch.one_stress.begin(),
+                            scratch.one_stress.end(),
+                            Tensor<2, spacedim, double>());
+                  auto view = make_array_view(scratch.one_stress);
+                  fc->compute_stress(
+                    time, me_values, cell, view, scratch.batch_scratch);
+                  for (unsigned int qp_n = 0; qp_n < n_quadrature_points;
+                       ++qp_n)
+                    scratch.accumulated_stresses[qp_n] +=
+                      scratch.one_stress[qp_n];
+                }
+              else if (fc->is_volume_force())
+                {
+                  touched_force = true;
+                  std::fill(scratch.one_force.begin(),
+                            scratch.one_force.end(),
+                            Tensor<1, spacedim, double>());
+                  auto view = make_array_view(scratch.one_force);
+                  fc->compute_volume_force(
+                    time, me_values, cell, view, scratch.batch_scratch);
+                  for (unsigned int qp_n = 0; qp_n < n_quadrature_points;
+                       ++qp_n)
+                    scratch.accumulated_forces[qp_n] +=
+                      scratch.one_force[qp_n];
+                }
+            }
+
+          // Assemble the RHS vector
+          //
+          // TODO - we could make this a lot faster by exploiting the fact
+          // that we have primitive FEs most of the time
+          for (unsigned int qp_n = 0; qp_n < n_quadrature_points; ++qp_n)
+            {
+              if (touched_stress)
+                for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+                  // -PP : grad phi dx
+                  copy_data.cell_rhs[i] +=
+                    -1. *
+                    scalar_product(scratch.accumulated_stresses[qp_n],
+                                   extractor.gradient(i, qp_n)) *
+                    fe_values.JxW(qp_n);
+              if (touched_force)
+                for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+                  // F . phi dx
+                  copy_data.cell_rhs[i] +=
+                    scalar_product(scratch.accumulated_forces[qp_n],
+                                   extractor.value(i, qp_n)) *
+                    fe_values.JxW(qp_n);
+            }
+        };
+        const auto copier = [&](const internal::LoadVectorCopyData &copy_data) {
+          force_rhs.add(copy_data.cell_dofs, copy_data.cell_rhs);
+        };
+
+        using CellFilter = FilteredIterator<cell_iterator>;
+        WorkStream::run(CellFilter(IteratorFilters::LocallyOwnedCell(),
+                                   dof_handler.begin_active()),
+                        CellFilter(IteratorFilters::LocallyOwnedCell(),
+                                   dof_handler.end()),
+                        worker,
+                        copier,
+                        ScratchData(mapping,
+                                    fe,
+                                    exemplar_quadrature,
+                                    update_flags,
+                                    current_position,
+                                    current_velocity,
+                                    me_flags),
+                        internal::LoadVectorCopyData());
+      }
+
+    // the boundary stuff is totally different anyway
+    compute_boundary_force_load_vector(dof_handler,
+                                       mapping,
+                                       boundary_force_contributions,
+                                       time,
+                                       current_position,
+                                       current_velocity,
+                                       force_rhs);
+  }
+
+  template <int dim, int spacedim>
+  void
+  compute_load_vector(
+    const DoFHandler<dim, spacedim>                       &dof_handler,
+    const Mapping<dim, spacedim>                          &mapping,
+    const MatrixFree<dim, double>                         &matrix_free,
+    const std::vector<ForceContribution<dim, spacedim> *> &force_contributions,
+    const double                                           time,
+    const LinearAlgebra::distributed::Vector<double>      &current_position,
+    const LinearAlgebra::distributed::Vector<double>      &current_velocity,
+    LinearAlgebra::distributed::Vector<double>            &force_rhs)
+  {
+    // Only loop over the cells to find the boundary faces if we need them
+    const bool have_boundary_forces =
+      std::any_of(force_contributions.begin(),
+                  force_contributions.end(),
+                  [](const ForceContribution<dim, spacedim> *fc) {
+                    return fc->is_boundary_force();
+                  });
+    compute_load_vector(dof_handler,
+                        mapping,
+                        matrix_free,
+                        have_boundary_forces ?
+                          make_boundary_faces(dof_handler) :
+                          std::vector<BoundaryFace<dim, spacedim>>(),
+                        force_contributions,
+                        time,
+                        current_position,
+                        current_velocity,
+                        force_rhs);
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  compute_load_vector(
+    const DoFHandler<dim, spacedim>                       &dof_handler,
+    const Mapping<dim, spacedim>                          &mapping,
+    const MatrixFree<dim, double>                         &matrix_free,
+    const std::vector<BoundaryFace<dim, spacedim>>        &boundary_faces,
+    const std::vector<ForceContribution<dim, spacedim> *> &force_contributions,
+    const double                                           time,
+    const LinearAlgebra::distributed::Vector<double>      &current_position,
+    const LinearAlgebra::distributed::Vector<double>      &current_velocity,
+    LinearAlgebra::distributed::Vector<double>            &force_rhs)
+  {
+    // Batched forces, grouped by the index of their quadrature in
+    // matrix_free
+    std::map<unsigned int, std::vector<ForceContribution<dim, spacedim> *>>
+      batched_contributions;
+    std::vector<ForceContribution<dim, spacedim> *>
+      boundary_force_contributions;
+    std::vector<ForceContribution<dim, spacedim> *> other_contributions;
+    // FEEvaluation with a run-time degree requires tensor-product elements
+    const bool can_use_matrix_free =
+      dim == spacedim && dof_handler.get_fe().reference_cell() ==
+                           ReferenceCells::get_hypercube<dim>();
+    const unsigned int n_quadratures =
+      can_use_matrix_free ? matrix_free.get_mapping_info().cell_data.size() :
+                            0;
+    for (auto *fc : force_contributions)
+      {
+        Assert(fc, ExcMessage("force contributions should not be nullptr"));
+        unsigned int quad_index = n_quadratures;
+        if (fc->supports_batched_evaluation() &&
+            (fc->is_stress() || fc->is_volume_force()))
+          for (unsigned int q = 0; q < n_quadratures; ++q)
+            if (fc->get_cell_quadrature() == matrix_free.get_quadrature(q))
               {
-                cell->get_dof_indices(cell_dofs);
-                fe_values.reinit(cell);
-                me_values.reinit(cell);
-                std::fill(accumulated_stresses.begin(),
-                          accumulated_stresses.end(),
-                          Tensor<2, spacedim, double>());
-                std::fill(accumulated_forces.begin(),
-                          accumulated_forces.end(),
-                          Tensor<1, spacedim, double>());
-                std::fill(cell_rhs.begin(), cell_rhs.end(), 0.0);
-                auto &extractor = fe_values[FEValuesExtractors::Vector(0)];
-
-                bool touched_stress = false;
-                bool touched_force  = false;
-                for (const ForceContribution<dim, spacedim> *fc :
-                     current_forces)
-                  {
-                    if (fc->is_stress())
-                      {
-                        touched_stress = true;
-                        std::fill(one_stress.begin(),
-                                  one_stress.end(),
-                                  Tensor<2, spacedim, double>());
-                        auto view =
-                          make_array_view(one_stress.begin(), one_stress.end());
-                        fc->compute_stress(time, me_values, cell, view);
-                        for (unsigned int qp_n = 0; qp_n < n_quadrature_points;
-                             ++qp_n)
-                          accumulated_stresses[qp_n] += one_stress[qp_n];
-                      }
-                    else if (fc->is_volume_force())
-                      {
-                        touched_force = true;
-                        std::fill(one_force.begin(),
-                                  one_force.end(),
-                                  Tensor<1, spacedim, double>());
-                        auto view =
-                          make_array_view(one_force.begin(), one_force.end());
-                        fc->compute_volume_force(time, me_values, cell, view);
-                        for (unsigned int qp_n = 0; qp_n < n_quadrature_points;
-                             ++qp_n)
-                          accumulated_forces[qp_n] += one_force[qp_n];
-                      }
-                  }
-
-                // Assemble the RHS vector
-                //
-                // TODO - we could make this a lot faster by exploiting the fact
-                // that we have primitive FEs most of the time
-                for (unsigned int qp_n = 0; qp_n < n_quadrature_points; ++qp_n)
-                  {
-                    if (touched_stress)
-                      for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
-                        // -PP : grad phi dx
-                        cell_rhs[i] +=
-                          -1. *
-                          scalar_product(accumulated_stresses[qp_n],
-                                         extractor.gradient(i, qp_n)) *
-                          fe_values.JxW(qp_n);
-                    if (touched_force)
-                      for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
-                        // F . phi dx
-                        cell_rhs[i] +=
-                          scalar_product(accumulated_forces[qp_n],
-                                         extractor.value(i, qp_n)) *
-                          fe_values.JxW(qp_n);
-                  }
-
-                force_rhs.add(cell_dofs, cell_rhs);
+                quad_index = q;
+                break;
               }
-          }
+
+        if (quad_index < n_quadratures)
+          batched_contributions[quad_index].push_back(fc);
+        else if (fc->is_boundary_force())
+          boundary_force_contributions.push_back(fc);
+        else
+          other_contributions.push_back(fc);
       }
 
-    // the boundary stuff is totally different anyway
+    for (const auto &pair : batched_contributions)
+      internal::compute_batched_load_vector(matrix_free,
+                                            pair.first,
+                                            pair.second,
+                                            time,
+                                            current_position,
+                                            current_velocity,
+                                            force_rhs);
+    compute_load_vector(dof_handler,
+                        mapping,
+                        other_contributions,
+                        time,
+                        current_position,
+                        current_velocity,
+                        force_rhs);
     compute_boundary_force_load_vector(dof_handler,
                                        mapping,
+                                       boundary_faces,
                                        boundary_force_contributions,
                                        time,
                                        current_position,
@@ -479,4 +1030,78 @@ namespace fdl
     const LinearAlgebra::distributed::Vector<double> &,
     const LinearAlgebra::distributed::Vector<double> &,
     LinearAlgebra::distributed::Vector<double> &);
+
+  template void
+  compute_load_vector<NDIM - 1, NDIM>(
+    const DoFHandler<NDIM - 1, NDIM> &,
+    const Mapping<NDIM - 1, NDIM> &,
+    const MatrixFree<NDIM - 1, double> &,
+    const std::vector<ForceContribution<NDIM - 1, NDIM> *> &,
+    const double,
+    const LinearAlgebra::distributed::Vector<double> &,
+    const LinearAlgebra::distributed::Vector<double> &,
+    LinearAlgebra::distributed::Vector<double> &);
+
+  template void
+  compute_load_vector<NDIM, NDIM>(
+    const DoFHandler<NDIM, NDIM> &,
+    const Mapping<NDIM, NDIM> &,
+    const MatrixFree<NDIM, double> &,
+    const std::vector<ForceContribution<NDIM, NDIM> *> &,
+    const double,
+    const LinearAlgebra::distributed::Vector<double> &,
+    const LinearAlgebra::distributed::Vector<double> &,
+    LinearAlgebra::distributed::Vector<double> &);
+
+  template std::vector<BoundaryFace<NDIM - 1, NDIM>>
+  make_boundary_faces(const DoFHandler<NDIM - 1, NDIM> &);
+
+  template std::vector<BoundaryFace<NDIM, NDIM>>
+  make_boundary_faces(const DoFHandler<NDIM, NDIM> &);
+
+  template void
+  compute_boundary_force_load_vector<NDIM, NDIM>(
+    const DoFHandler<NDIM, NDIM> &,
+    const Mapping<NDIM, NDIM> &,
+    const std::vector<BoundaryFace<NDIM, NDIM>> &,
+    const std::vector<ForceContribution<NDIM, NDIM> *> &,
+    const double,
+    const LinearAlgebra::distributed::Vector<double> &,
+    const LinearAlgebra::distributed::Vector<double> &,
+    LinearAlgebra::distributed::Vector<double> &);
+
+  template void
+  compute_boundary_force_load_vector<NDIM - 1, NDIM>(
+    const DoFHandler<NDIM - 1, NDIM> &,
+    const Mapping<NDIM - 1, NDIM> &,
+    const std::vector<BoundaryFace<NDIM - 1, NDIM>> &,
+    const std::vector<ForceContribution<NDIM - 1, NDIM> *> &,
+    const double,
+    const LinearAlgebra::distributed::Vector<double> &,
+    const LinearAlgebra::distributed::Vector<double> &,
+    LinearAlgebra::distributed::Vector<double> &);
+
+  template void
+  compute_load_vector<NDIM - 1, NDIM>(
+    const DoFHandler<NDIM - 1, NDIM> &,
+    const Mapping<NDIM - 1, NDIM> &,
+    const MatrixFree<NDIM - 1, double> &,
+    const std::vector<BoundaryFace<NDIM - 1, NDIM>> &,
+    const std::vector<ForceContribution<NDIM - 1, NDIM> *> &,
+    const double,
+    const LinearAlgebra::distributed::Vector<double> &,
+    const LinearAlgebra::distributed::Vector<double> &,
+    LinearAlgebra::distributed::Vector<double> &);
+
+  template void
+  compute_load_vector<NDIM, NDIM>(
+    const DoFHandler<NDIM, NDIM> &,
+    const Mapping<NDIM, NDIM> &,
+    const MatrixFree<NDIM, double> &,
+    const std::vector<BoundaryFace<NDIM, NDIM>> &,
+    const std::vector<ForceContribution<NDIM, NDIM> *> &,
+    const double,
+    const LinearAlgebra::distributed::Vector<double> &,
+    const LinearAlgebra::distributed::Vector<double> &,
+    LinearAlgebra::distributed::Vector<double> &);
 } // namespace fdl
@@ -9,6 +9,7 @@
 #include <deal.II/lac/la_parallel_vector.h>
 #include <deal.II/lac/vector.h>
 
+#include <algorithm>
 #include <cmath>
 
 namespace fdl
@@ -275,6 +276,155 @@ namespace fdl
         scratch_velocity_values, velocity_values);
   }
 
+  template <int dim, int spacedim, typename Number>
+  BatchedMechanicsValues<dim, spacedim, Number>::BatchedMechanicsValues(
+    const MechanicsUpdateFlags flags)
+    : update_flags(resolve_flag_dependencies(flags))
+    , n_entries_(0)
+    , n_filled_lanes_(0)
+  {
+    AssertThrow(!(update_flags & update_deformed_normal_vectors),
+                ExcMessage("Normal vectors are not available in batches."));
+  }
+
+  template <int dim, int spacedim, typename Number>
+  void
+  BatchedMechanicsValues<dim, spacedim, Number>::resize(
+    const unsigned int n_entries)
+  {
+    n_entries_ = n_entries;
+    if (update_flags & MechanicsUpdateFlags::update_FF)
+      FF.resize(n_entries);
+    if (update_flags & MechanicsUpdateFlags::update_FF_inv_T)
+      FF_inv_T.resize(n_entries);
+    if (update_flags & MechanicsUpdateFlags::update_det_FF)
+      det_FF.resize(n_entries);
+    if (update_flags & MechanicsUpdateFlags::update_n23_det_FF)
+      n23_det_FF.resize(n_entries);
+    if (update_flags & MechanicsUpdateFlags::update_position_values)
+      position_values.resize(n_entries);
+    if (update_flags & MechanicsUpdateFlags::update_velocity_values)
+      velocity_values.resize(n_entries);
+    if (update_flags & MechanicsUpdateFlags::update_right_cauchy_green)
+      right_cauchy_green.resize(n_entries);
+    if (update_flags & MechanicsUpdateFlags::update_first_invariant)
+      first_invariant.resize(n_entries);
+    if (update_flags & MechanicsUpdateFlags::update_second_invariant)
+      second_invariant.resize(n_entries);
+    if (update_flags & MechanicsUpdateFlags::update_third_invariant)
+      third_invariant.resize(n_entries);
+  }
+
+  template <int dim, int spacedim, typename Number>
+  void
+  BatchedMechanicsValues<dim, spacedim, Number>::reinit(
+    const ArrayView<const cell_iterator> &new_cells,
+    const ArrayView<const Tensor<2, spacedim, VectorizedArrayType>> &new_FF,
+    const ArrayView<const Tensor<1, spacedim, VectorizedArrayType>>
+      &new_position_values,
+    const ArrayView<const Tensor<1, spacedim, VectorizedArrayType>>
+      &new_velocity_values)
+  {
+    Assert(dim == spacedim, ExcFDLNotImplemented());
+    Assert(new_cells.size() > 0 &&
+             new_cells.size() <= VectorizedArrayType::size(),
+           ExcMessage("There should be one cell per filled lane."));
+    const unsigned int n_entries = std::max({new_FF.size(),
+                                             new_position_values.size(),
+                                             new_velocity_values.size()});
+    Assert(!(update_flags & update_FF) || new_FF.size() == n_entries,
+           ExcMessage("Needs FF"));
+    Assert(!(update_flags & update_position_values) ||
+             new_position_values.size() == n_entries,
+           ExcMessage("Needs position values"));
+    Assert(!(update_flags & update_velocity_values) ||
+             new_velocity_values.size() == n_entries,
+           ExcMessage("Needs velocity values"));
+
+    resize(n_entries);
+    n_filled_lanes_ = new_cells.size();
+    std::copy(new_cells.begin(), new_cells.end(), cells.begin());
+    std::fill(cells.begin() + n_filled_lanes_, cells.end(), cell_iterator());
+
+    // Copy the inputs and overwrite the unfilled lanes with the first lane
+    const auto pad = [&](auto &value) {
+      for (unsigned int lane = n_filled_lanes_;
+           lane < VectorizedArrayType::size();
+           ++lane)
+        for (unsigned int i = 0; i < value.n_independent_components; ++i)
+          {
+            const auto index = value.unrolled_to_component_indices(i);
+            value[index][lane] = value[index][0];
+          }
+    };
+    for (unsigned int q = 0; q < n_entries; ++q)
+      {
+        if (update_flags & update_FF)
+          {
+            FF[q] = new_FF[q];
+            pad(FF[q]);
+          }
+        if (update_flags & update_position_values)
+          {
+            position_values[q] = new_position_values[q];
+            pad(position_values[q]);
+          }
+        if (update_flags & update_velocity_values)
+          {
+            velocity_values[q] = new_velocity_values[q];
+            pad(velocity_values[q]);
+          }
+      }
+
+    // Same as MechanicsValues::reinit() but with VectorizedArray values
+    for (unsigned int q = 0; q < n_entries; ++q)
+      {
+        if (update_flags & update_FF_inv_T)
+          FF_inv_T[q] = transpose(invert(FF[q]));
+        if (update_flags & update_det_FF)
+          det_FF[q] = determinant(FF[q]);
+        if (update_flags & update_n23_det_FF)
+          {
+            // There is no vectorized cbrt() so do this one lane at a time
+            // (std::pow() is not equivalent for negative determinants)
+            VectorizedArrayType temp;
+            for (unsigned int lane = 0; lane < VectorizedArrayType::size();
+                 ++lane)
+              temp[lane] = std::cbrt(Number(1.0) / det_FF[q][lane]);
+            n23_det_FF[q] = temp * temp;
+          }
+        if (update_flags & update_right_cauchy_green)
+          right_cauchy_green[q] =
+            symmetrize(transpose(FF[q]) * FF[q]);
+        if (update_flags & update_first_invariant)
+          {
+            Assert(dim == 2 || dim == 3, ExcFDLInternalError());
+            if (dim == 2)
+              first_invariant[q] =
+                dealii::first_invariant(right_cauchy_green[q]) + Number(1.0);
+            else
+              first_invariant[q] =
+                dealii::first_invariant(right_cauchy_green[q]);
+          }
+        if (update_flags & update_second_invariant)
+          {
+            Assert(dim == 2 || dim == 3, ExcFDLInternalError());
+            if (dim == 2)
+              second_invariant[q] =
+                dealii::second_invariant(right_cauchy_green[q]) +
+                trace(right_cauchy_green[q]);
+            else
+              second_invariant[q] =
+                dealii::second_invariant(right_cauchy_green[q]);
+          }
+        if (update_flags & update_third_invariant)
+          third_invariant[q] = det_FF[q] * det_FF[q];
+      }
+  }
+
+
+  template class BatchedMechanicsValues<NDIM - 1, NDIM, double>;
+  template class BatchedMechanicsValues<NDIM, NDIM, double>;
 
   template class MechanicsValues<NDIM - 1, NDIM, Vector<double>>;
   template class MechanicsValues<NDIM, NDIM, Vector<double>>;
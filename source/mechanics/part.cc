@@ -8,6 +8,8 @@
 
 #include <boost/serialization/array_wrapper.hpp>
 
+#include <algorithm>
+
 namespace fdl
 {
   namespace internal
@@ -15,13 +17,18 @@ namespace fdl
     // matrix_free doesn't work with codim != 0 so we need a helper function
     template <int dim>
     void
-    reinit_matrix_free(const Mapping<dim>              &mapping,
-                       const DoFHandler<dim>           &dof_handler,
-                       const AffineConstraints<double> &constraints,
-                       const Quadrature<dim>           &quadrature,
-                       MatrixFree<dim, double>         &matrix_free)
+    reinit_matrix_free(const Mapping<dim>                 &mapping,
+                       const DoFHandler<dim>              &dof_handler,
+                       const AffineConstraints<double>    &constraints,
+                       const std::vector<Quadrature<dim>> &quadratures,
+                       MatrixFree<dim, double>            &matrix_free)
     {
-      matrix_free.reinit(mapping, dof_handler, constraints, quadrature);
+      matrix_free.reinit(
+        mapping,
+        std::vector<const DoFHandler<dim> *>{&dof_handler},
+        std::vector<const AffineConstraints<double> *>{&constraints},
+        quadratures,
+        typename MatrixFree<dim, double>::AdditionalData());
     }
 
     template <int dim>
@@ -29,7 +36,7 @@ namespace fdl
     reinit_matrix_free(const Mapping<dim - 1, dim> &,
                        const DoFHandler<dim - 1, dim> &,
                        const AffineConstraints<double> &,
-                       const Quadrature<dim - 1> &,
+                       const std::vector<Quadrature<dim - 1>> &,
                        MatrixFree<dim - 1, double> &)
     {
       // We shouldn't get here
@@ -68,13 +75,15 @@ namespace fdl
     dof_handler->distribute_dofs(*this->fe);
     constraints.close();
 
+    // The mesh never changes so we only need to find the boundary faces once
+    boundary_faces = make_boundary_faces(*dof_handler);
+
     // A MatrixFree object sets up the partitioning on its own - use that to
     // avoid issues with p::s::T where there may not be artificial cells/
     //
     // TODO - understand this issue well enough to file a bug report
     matrix_free = std::make_shared<MatrixFree<dim, double>>();
-    internal::reinit_matrix_free(
-      *mapping, *dof_handler, constraints, quadrature, *matrix_free);
+    reinit_matrix_free();
     if (dim == spacedim)
       {
         // no matrixfree outside codim 0
@@ -235,6 +244,48 @@ namespace fdl
     std::unique_ptr<ForceContribution<dim, spacedim>> force)
   {
     force_contributions.push_back(std::move(force));
+
+    const ForceContribution<dim, spacedim> &new_force =
+      *force_contributions.back();
+    if (dim == spacedim &&
+        (new_force.is_stress() || new_force.is_volume_force()) &&
+        new_force.get_cell_quadrature().is_tensor_product())
+      if (std::find(matrix_free_quadratures.begin(),
+                    matrix_free_quadratures.end(),
+                    new_force.get_cell_quadrature()) ==
+          matrix_free_quadratures.end())
+        reinit_matrix_free();
+  }
+
+  template <int dim, int spacedim>
+  void
+  Part<dim, spacedim>::reinit_matrix_free()
+  {
+    matrix_free_quadratures = {quadrature};
+    // FEEvaluation only supports tensor-product quadratures on hypercubes
+    const bool is_hypercube = tria->get_reference_cells().front() ==
+                              ReferenceCells::get_hypercube<dim>();
+    if (dim == spacedim && is_hypercube)
+      for (const auto &fc : force_contributions)
+        if ((fc->is_stress() || fc->is_volume_force()) &&
+            fc->get_cell_quadrature().is_tensor_product() &&
+            std::find(matrix_free_quadratures.begin(),
+                      matrix_free_quadratures.end(),
+                      fc->get_cell_quadrature()) ==
+              matrix_free_quadratures.end())
+          matrix_free_quadratures.push_back(fc->get_cell_quadrature());
+
+    internal::reinit_matrix_free(*mapping,
+                                 *dof_handler,
+                                 constraints,
+                                 matrix_free_quadratures,
+                                 *matrix_free);
+    if (mass_operator)
+      {
+        mass_operator->initialize(matrix_free);
+        mass_operator->compute_diagonal();
+        mass_preconditioner.initialize(*mass_operator, 1.0);
+      }
   }
 
   template class Part<NDIM - 1, NDIM>;
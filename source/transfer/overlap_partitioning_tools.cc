@@ -25,7 +25,40 @@ namespace fdl
            ExcMessage("The overlap DoFHandler should use the overlap tria"));
     Assert(&native_dof_handler.get_triangulation() == &native_tria,
            ExcMessage("The native DoFHandler should use the native tria"));
-    // Outline of the algorithm:
+
+    const auto &fe = native_dof_handler.get_fe();
+    Assert(fe.get_name() == overlap_dof_handler.get_fe().get_name(),
+           ExcMessage("dof handlers should use the same FiniteElement"));
+    std::vector<types::global_dof_index> overlap_cell_dofs(fe.dofs_per_cell);
+    std::vector<types::global_dof_index> native_indices(
+      overlap_dof_handler.n_dofs());
+
+    // If the native Triangulation has no artificial cells then every processor
+    // knows the DoFs on every cell, so we can copy them without communicating.
+    if (!overlap_tria.get_native_triangulation().with_artificial_cells())
+      {
+        std::vector<types::global_dof_index> native_cell_dofs(
+          fe.dofs_per_cell);
+        for (const auto &cell : overlap_dof_handler.active_cell_iterators())
+          if (cell->is_locally_owned())
+            {
+              const auto native_cell = overlap_tria.get_native_cell(cell);
+              const auto native_dh_cell =
+                typename DoFHandler<dim, spacedim>::active_cell_iterator(
+                  &native_tria,
+                  native_cell->level(),
+                  native_cell->index(),
+                  &native_dof_handler);
+              native_dh_cell->get_dof_indices(native_cell_dofs);
+              cell->get_dof_indices(overlap_cell_dofs);
+              for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+                native_indices[overlap_cell_dofs[i]] = native_cell_dofs[i];
+            }
+
+        return native_indices;
+      }
+
+    // Otherwise, outline of the algorithm:
     //
     // 1. Determine which active cell indices the overlap tria needs.
     //
@@ -62,10 +95,7 @@ namespace fdl
 
     // 3: pack dofs:
     std::map<types::subdomain_id, std::vector<types::global_dof_index>>
-                dofs_on_native;
-    const auto &fe = native_dof_handler.get_fe();
-    Assert(fe.get_name() == overlap_dof_handler.get_fe().get_name(),
-           ExcMessage("dof handlers should use the same FiniteElement"));
+      dofs_on_native;
     for (const auto &pair : requested_native_cell_ids)
       {
         const types::subdomain_id             requested_rank = pair.first;
@@ -112,9 +142,6 @@ namespace fdl
       packed_ptrs[pair.first] = pair.second.cbegin();
 
     // 4:
-    std::vector<types::global_dof_index> overlap_cell_dofs(fe.dofs_per_cell);
-    std::vector<types::global_dof_index> native_indices(
-      overlap_dof_handler.n_dofs());
     for (const auto &cell : overlap_dof_handler.active_cell_iterators())
       {
         if (cell->is_locally_owned())
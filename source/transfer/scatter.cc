@@ -3,11 +3,17 @@
 #include <fiddle/transfer/scatter.h>
 
 #include <deal.II/base/index_set.h>
+#include <deal.II/base/mpi_tags.h>
+#include <deal.II/base/partitioner.h>
 
 #include <deal.II/lac/la_parallel_vector.h>
 
 #include <mpi.h>
 
+#include <algorithm>
+#include <limits>
+#include <memory>
+
 namespace fdl
 {
   using namespace dealii;
@@ -28,14 +34,77 @@ namespace fdl
 
 
 
+  namespace
+  {
+    template <typename T>
+    MPI_Datatype
+    get_mpi_type();
+
+    template <>
+    MPI_Datatype
+    get_mpi_type<float>()
+    {
+      return MPI_FLOAT;
+    }
+
+    template <>
+    MPI_Datatype
+    get_mpi_type<double>()
+    {
+      return MPI_DOUBLE;
+    }
+
+    // Set up persistent requests for either sending or receiving packed
+    // values with each target. Returns the number of set up requests.
+    template <typename Number>
+    std::size_t
+    init_requests(
+      const bool                                                receive,
+      const std::vector<std::pair<unsigned int, unsigned int>> &targets,
+      const std::size_t                                         n_vectors,
+      const int                                                 tag,
+      const MPI_Comm                                            communicator,
+      Number                                                   *buffer,
+      MPI_Request                                              *requests)
+    {
+      unsigned int offset = 0;
+      for (std::size_t i = 0; i < targets.size(); ++i)
+        {
+          const auto &target = targets[i];
+          const int   ierr =
+            receive ? MPI_Recv_init(buffer + n_vectors * offset,
+                                    n_vectors * target.second,
+                                    get_mpi_type<Number>(),
+                                    target.first,
+                                    tag,
+                                    communicator,
+                                    &requests[i]) :
+                      MPI_Send_init(buffer + n_vectors * offset,
+                                    n_vectors * target.second,
+                                    get_mpi_type<Number>(),
+                                    target.first,
+                                    tag,
+                                    communicator,
+                                    &requests[i]);
+          AssertThrowMPI(ierr);
+          offset += target.second;
+        }
+
+      return targets.size();
+    }
+  } // namespace
+
+
+
   template <typename T>
   Scatter<T>::Scatter(const std::vector<types::global_dof_index> &overlap,
                       const IndexSet                             &local_dofs,
                       const MPI_Comm                             &communicator)
     : overlap_dofs(overlap)
-    , scatterer(local_dofs,
-                setup_ghost_dofs(overlap_dofs, local_dofs),
-                communicator)
+    , partitioner(std::make_shared<const Utilities::MPI::Partitioner>(
+        local_dofs,
+        setup_ghost_dofs(overlap_dofs, local_dofs),
+        communicator))
   {
     Assert(local_dofs.is_contiguous() == true,
            ExcMessage("The index set specified in local_dofs is not "
@@ -48,6 +117,133 @@ namespace fdl
                           "specified by local_dofs"));
       }
 #endif
+
+    // Do the global to local index translation once:
+    const unsigned int n_owned = partitioner->locally_owned_size();
+    for (std::size_t i = 0; i < overlap_dofs.size(); ++i)
+      {
+        const unsigned int local_index =
+          partitioner->global_to_local(overlap_dofs[i]);
+        if (local_index < n_owned)
+          {
+            owned_overlap_indices.push_back(i);
+            owned_local_indices.push_back(local_index);
+          }
+        else
+          {
+            ghost_overlap_indices.push_back(i);
+            ghost_indices.push_back(local_index - n_owned);
+          }
+      }
+  }
+
+
+
+  template <typename T>
+  Scatter<T>::PersistentTransfer::~PersistentTransfer()
+  {
+    // Don't try to free anything if the object outlives MPI:
+    int finalized = 0;
+    int ierr      = MPI_Finalized(&finalized);
+    AssertNothrow(ierr == MPI_SUCCESS, ExcMessage("MPI_Finalized failed"));
+    if (finalized)
+      return;
+    for (MPI_Request &request : requests)
+      if (request != MPI_REQUEST_NULL)
+        {
+          ierr = MPI_Request_free(&request);
+          AssertNothrow(ierr == MPI_SUCCESS,
+                        ExcMessage("MPI_Request_free failed"));
+        }
+  }
+
+
+
+  template <typename T>
+  typename Scatter<T>::PersistentTransfer &
+  Scatter<T>::get_transfer(const bool         to_overlap,
+                           const unsigned int channel,
+                           const std::size_t  n_vectors,
+                           const bool         reduced_precision)
+  {
+    Assert(to_overlap || !reduced_precision,
+           ExcMessage("Reduced precision is only supported when scattering "
+                      "from native to overlap vectors."));
+    for (const auto &transfer : transfers)
+      if (transfer->to_overlap == to_overlap && transfer->channel == channel &&
+          transfer->n_vectors == n_vectors &&
+          transfer->reduced_precision == reduced_precision)
+        return *transfer;
+
+    // Use the same tags deal.II does so that channels have the same meaning
+    // here as they do in LA::d::V:
+    const int tag =
+      (to_overlap ? Utilities::MPI::internal::Tags::partitioner_export_start :
+                    Utilities::MPI::internal::Tags::partitioner_import_start) +
+      channel;
+    Assert(channel < Utilities::MPI::internal::Tags::partitioner_export_end -
+                       Utilities::MPI::internal::Tags::partitioner_export_start,
+           ExcMessage("The channel number is too large."));
+
+    auto transfer               = std::make_unique<PersistentTransfer>();
+    transfer->to_overlap        = to_overlap;
+    transfer->channel           = channel;
+    transfer->n_vectors         = n_vectors;
+    transfer->reduced_precision = reduced_precision;
+    const std::size_t n_ghosts  = n_vectors * partitioner->n_ghost_indices();
+    const std::size_t n_imports = n_vectors * partitioner->n_import_indices();
+
+    // Native to overlap transfers receive ghost values and send owned values -
+    // overlap to native transfers do the opposite.
+    const MPI_Comm communicator   = partitioner->get_mpi_communicator();
+    const auto    &ghost_targets  = partitioner->ghost_targets();
+    const auto    &import_targets = partitioner->import_targets();
+    transfer->requests.resize(ghost_targets.size() + import_targets.size(),
+                              MPI_REQUEST_NULL);
+    MPI_Request *requests = transfer->requests.data();
+    if (reduced_precision)
+      {
+        transfer->reduced_ghost_values.resize(n_ghosts);
+        transfer->reduced_import_values.resize(n_imports);
+        requests += init_requests(true,
+                                  ghost_targets,
+                                  n_vectors,
+                                  tag,
+                                  communicator,
+                                  transfer->reduced_ghost_values.data(),
+                                  requests);
+        init_requests(false,
+                      import_targets,
+                      n_vectors,
+                      tag,
+                      communicator,
+                      transfer->reduced_import_values.data(),
+                      requests);
+      }
+    else
+      {
+        transfer->ghost_values.resize(n_ghosts);
+        transfer->import_values.resize(n_imports);
+        requests += init_requests(true,
+                                  to_overlap ? ghost_targets : import_targets,
+                                  n_vectors,
+                                  tag,
+                                  communicator,
+                                  to_overlap ? transfer->ghost_values.data() :
+                                               transfer->import_values.data(),
+                                  requests);
+        init_requests(false,
+                      to_overlap ? import_targets : ghost_targets,
+                      n_vectors,
+                      tag,
+                      communicator,
+                      to_overlap ? transfer->import_values.data() :
+                                   transfer->ghost_values.data(),
+                      requests);
+      }
+
+    transfers.emplace_back(std::move(transfer));
+    return *transfers.back();
   }
 
 
@@ -60,13 +256,14 @@ namespace fdl
     const unsigned int                     channel,
     LinearAlgebra::distributed::Vector<T> &output)
   {
-    (void)output;
     Assert(input.size() == overlap_dofs.size(),
            ExcMessage("Input vector should be indexed by overlap dofs"));
     Assert(output.locally_owned_elements() ==
-             scatterer.locally_owned_elements(),
+             partitioner->locally_owned_range(),
            ExcMessage("The output vector should have the same number of dofs "
                       "as were provided to the constructor in local"));
+    Assert(active_transfer == nullptr,
+           ExcMessage("Only one scatter may be active at a time."));
 
     // This requires some care - when we scatter with insert we assume that the
     // dof is set to the correct value on its owning processor. This is not the
@@ -75,32 +272,54 @@ namespace fdl
     // communicate so we can't really check for consistent settings (i.e., there
     // is no correct value set on the owning processor). Hence we do a max
     // operation instead and hope the caller isn't doing anything too weird.
+    T initial_value = 0.0;
     if (operation == VectorOperation::add)
-      scatterer = 0.0;
+      initial_value = 0.0;
     else if (operation == VectorOperation::insert ||
              operation == VectorOperation::max)
+      initial_value = std::numeric_limits<T>::lowest();
+    else
+      {
+        Assert(false, ExcFDLNotImplemented());
+      }
+
+    active_transfer = &get_transfer(false, channel, 1);
+    std::vector<T> &ghost_values = active_transfer->ghost_values;
+    const unsigned int n_owned = partitioner->locally_owned_size();
+    for (unsigned int i = 0; i < n_owned; ++i)
+      output.local_element(i) = initial_value;
+    std::fill(ghost_values.begin(), ghost_values.end(), initial_value);
+
+    // Owned values go straight into the output vector and ghost values go into
+    // the communication buffer:
+    if (operation == VectorOperation::add)
       {
-        const auto size = scatterer.locally_owned_size() +
-                          scatterer.get_partitioner()->n_ghost_indices();
-        for (std::size_t i = 0; i < size; ++i)
-          scatterer.local_element(i) = std::numeric_limits<T>::lowest();
+        for (std::size_t i = 0; i < owned_overlap_indices.size(); ++i)
+          output.local_element(owned_local_indices[i]) +=
+            input[owned_overlap_indices[i]];
+        for (std::size_t i = 0; i < ghost_overlap_indices.size(); ++i)
+          ghost_values[ghost_indices[i]] += input[ghost_overlap_indices[i]];
       }
     else
       {
-        Assert(false, ExcFDLNotImplemented());
+        for (std::size_t i = 0; i < owned_overlap_indices.size(); ++i)
+          {
+            T &value = output.local_element(owned_local_indices[i]);
+            value    = std::max(value, input[owned_overlap_indices[i]]);
+          }
+        for (std::size_t i = 0; i < ghost_overlap_indices.size(); ++i)
+          {
+            T &value = ghost_values[ghost_indices[i]];
+            value    = std::max(value, input[ghost_overlap_indices[i]]);
+          }
+      }
+
+    std::vector<MPI_Request> &requests = active_transfer->requests;
+    if (requests.size() > 0)
+      {
+        const int ierr = MPI_Startall(requests.size(), requests.data());
+        AssertThrowMPI(ierr);
       }
-    // TODO: we can probably do the index translation just once and store it
-    // so we could instead use scatterer::local_element(). It might be faster
-    // but it will take up more memory.
-    for (std::size_t i = 0; i < overlap_dofs.size(); ++i)
-      scatterer[overlap_dofs[i]] = input[i];
-    // The ghost array is out of sync with the actual values the vector should
-    // have - explicitly set it as such so we can compress
-    scatterer.set_ghost_state(false);
-
-    const VectorOperation::values actual_op =
-      operation == VectorOperation::insert ? VectorOperation::max : operation;
-    scatterer.compress_start(channel, actual_op);
   }
 
 
@@ -116,16 +335,39 @@ namespace fdl
     Assert(input.size() == overlap_dofs.size(),
            ExcMessage("Input vector should be indexed by overlap dofs"));
     Assert(output.locally_owned_elements() ==
-             scatterer.locally_owned_elements(),
+             partitioner->locally_owned_range(),
            ExcMessage("The output vector should have the same number of dofs "
                       "as were provided to the constructor in local"));
+    Assert(active_transfer && !active_transfer->to_overlap,
+           ExcMessage("overlap_to_global_start() should be called first."));
 
-    const VectorOperation::values actual_op =
-      operation == VectorOperation::insert ? VectorOperation::max : operation;
-    scatterer.compress_finish(actual_op);
+    std::vector<MPI_Request> &requests = active_transfer->requests;
+    if (requests.size() > 0)
+      {
+        const int ierr =
+          MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+        AssertThrowMPI(ierr);
+      }
 
-    for (std::size_t i = 0; i < scatterer.locally_owned_size(); ++i)
-      output.local_element(i) = scatterer.local_element(i);
+    // Combine remote contributions with the owned values already in output:
+    const T *import_value = active_transfer->import_values.data();
+    if (operation == VectorOperation::add)
+      {
+        for (const auto &range : partitioner->import_indices())
+          for (unsigned int i = range.first; i < range.second; ++i)
+            output.local_element(i) += *import_value++;
+      }
+    else
+      {
+        for (const auto &range : partitioner->import_indices())
+          for (unsigned int i = range.first; i < range.second; ++i)
+            {
+              T &value = output.local_element(i);
+              value    = std::max(value, *import_value++);
+            }
+      }
+
+    active_transfer = nullptr;
   }
 
 
@@ -135,20 +377,85 @@ namespace fdl
   Scatter<T>::global_to_overlap_start(
     const LinearAlgebra::distributed::Vector<T> &input,
     const unsigned int                           channel,
+    Vector<T>                                   &output,
+    const bool                                   reduced_precision)
+  {
+    const std::vector<const LinearAlgebra::distributed::Vector<T> *> inputs{
+      &input};
+    const std::vector<Vector<T> *> outputs{&output};
+    global_to_overlap_start(inputs, channel, outputs, reduced_precision);
+  }
+
+
+
+  template <typename T>
+  void
+  Scatter<T>::global_to_overlap_finish(
+    const LinearAlgebra::distributed::Vector<T> &input,
     Vector<T>                                   &output)
   {
-    (void)output;
-    Assert(output.size() == overlap_dofs.size(),
-           ExcMessage("output vector should be indexed by overlap dofs"));
-    Assert(input.locally_owned_elements() == scatterer.locally_owned_elements(),
-           ExcMessage("The output vector should have the same number of dofs "
-                      "as were provided to the constructor in local"));
+    const std::vector<const LinearAlgebra::distributed::Vector<T> *> inputs{
+      &input};
+    const std::vector<Vector<T> *> outputs{&output};
+    global_to_overlap_finish(inputs, outputs);
+  }
+
+
+
+  template <typename T>
+  void
+  Scatter<T>::global_to_overlap_start(
+    const std::vector<const LinearAlgebra::distributed::Vector<T> *> &inputs,
+    const unsigned int                                                channel,
+    const std::vector<Vector<T> *>                                   &outputs,
+    const bool reduced_precision)
+  {
+    const std::size_t n_vectors = inputs.size();
+    (void)outputs;
+    Assert(outputs.size() == n_vectors,
+           ExcMessage("The number of input and output vectors should match"));
+#ifdef DEBUG
+    for (std::size_t v = 0; v < n_vectors; ++v)
+      {
+        Assert(outputs[v]->size() == overlap_dofs.size(),
+               ExcMessage("output vectors should be indexed by overlap dofs"));
+        Assert(inputs[v]->locally_owned_elements() ==
+                 partitioner->locally_owned_range(),
+               ExcMessage("The input vectors should have the same number of "
+                          "dofs as were provided to the constructor in "
+                          "local"));
+      }
+#endif
+    Assert(active_transfer == nullptr,
+           ExcMessage("Only one scatter may be active at a time."));
 
-    scatterer.zero_out_ghost_values();
-    for (std::size_t i = 0; i < scatterer.locally_owned_size(); ++i)
-      scatterer.local_element(i) = input.local_element(i);
+    active_transfer =
+      &get_transfer(true, channel, n_vectors, reduced_precision);
 
-    scatterer.update_ghost_values_start(channel);
+    // Pack owned values with the vector index varying fastest:
+    if (reduced_precision)
+      {
+        float *import_value = active_transfer->reduced_import_values.data();
+        for (const auto &range : partitioner->import_indices())
+          for (unsigned int i = range.first; i < range.second; ++i)
+            for (std::size_t v = 0; v < n_vectors; ++v)
+              *import_value++ = static_cast<float>(inputs[v]->local_element(i));
+      }
+    else
+      {
+        T *import_value = active_transfer->import_values.data();
+        for (const auto &range : partitioner->import_indices())
+          for (unsigned int i = range.first; i < range.second; ++i)
+            for (std::size_t v = 0; v < n_vectors; ++v)
+              *import_value++ = inputs[v]->local_element(i);
+      }
+
+    std::vector<MPI_Request> &requests = active_transfer->requests;
+    if (requests.size() > 0)
+      {
+        const int ierr = MPI_Startall(requests.size(), requests.data());
+        AssertThrowMPI(ierr);
+      }
   }
 
 
@@ -156,20 +463,67 @@ namespace fdl
   template <typename T>
   void
   Scatter<T>::global_to_overlap_finish(
-    const LinearAlgebra::distributed::Vector<T> &input,
-    Vector<T>                                   &output)
+    const std::vector<const LinearAlgebra::distributed::Vector<T> *> &inputs,
+    const std::vector<Vector<T> *>                                   &outputs)
   {
-    (void)input;
-    Assert(output.size() == overlap_dofs.size(),
-           ExcMessage("output vector should be indexed by overlap dofs"));
-    Assert(input.locally_owned_elements() == scatterer.locally_owned_elements(),
-           ExcMessage("The output vector should have the same number of dofs "
-                      "as were provided to the constructor in local"));
+    const std::size_t n_vectors = inputs.size();
+    Assert(outputs.size() == n_vectors,
+           ExcMessage("The number of input and output vectors should match"));
+    Assert(active_transfer && active_transfer->to_overlap &&
+             active_transfer->n_vectors == n_vectors,
+           ExcMessage("global_to_overlap_start() should be called first with "
+                      "the same number of vectors."));
 
-    scatterer.update_ghost_values_finish();
+    std::vector<MPI_Request> &requests = active_transfer->requests;
+    if (requests.size() > 0)
+      {
+        const int ierr =
+          MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+        AssertThrowMPI(ierr);
+      }
+
+    const bool reduced_precision = active_transfer->reduced_precision;
+    const std::vector<T>     &ghost_values = active_transfer->ghost_values;
+    const std::vector<float> &reduced_ghost_values =
+      active_transfer->reduced_ghost_values;
+    for (std::size_t v = 0; v < n_vectors; ++v)
+      {
+        const LinearAlgebra::distributed::Vector<T> &input  = *inputs[v];
+        Vector<T>                                   &output = *outputs[v];
+        Assert(output.size() == overlap_dofs.size(),
+               ExcMessage("output vectors should be indexed by overlap dofs"));
+        for (std::size_t i = 0; i < owned_overlap_indices.size(); ++i)
+          output[owned_overlap_indices[i]] =
+            input.local_element(owned_local_indices[i]);
+        if (reduced_precision)
+          for (std::size_t i = 0; i < ghost_overlap_indices.size(); ++i)
+            output[ghost_overlap_indices[i]] =
+              reduced_ghost_values[ghost_indices[i] * n_vectors + v];
+        else
+          for (std::size_t i = 0; i < ghost_overlap_indices.size(); ++i)
+            output[ghost_overlap_indices[i]] =
+              ghost_values[ghost_indices[i] * n_vectors + v];
+      }
+
+    active_transfer = nullptr;
+  }
+
+
+
+  template <typename T>
+  bool
+  Scatter<T>::test()
+  {
+    if (active_transfer == nullptr || active_transfer->requests.size() == 0)
+      return true;
 
-    for (std::size_t i = 0; i < output.size(); ++i)
-      output[i] = scatterer[overlap_dofs[i]];
+    int       flag = 0;
+    const int ierr = MPI_Testall(active_transfer->requests.size(),
+                                 active_transfer->requests.data(),
+                                 &flag,
+                                 MPI_STATUSES_IGNORE);
+    AssertThrowMPI(ierr);
+    return flag != 0;
   }
 
   template class Scatter<float>;
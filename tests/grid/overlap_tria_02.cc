@@ -0,0 +1,60 @@
+#include <fiddle/grid/intersection_predicate.h>
+#include <fiddle/grid/overlap_tria.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <fstream>
+
+// verify that reinit() only rebuilds the overlap tria when the selected cells
+// or the native tria change.
+
+class LeftOf : public fdl::IntersectionPredicate<2>
+{
+public:
+  LeftOf(const double cutoff)
+    : cutoff(cutoff)
+  {}
+
+  virtual bool
+  operator()(const dealii::Triangulation<2>::cell_iterator &cell) const override
+  {
+    return cell->bounding_box().get_boundary_points().first[0] < cutoff;
+  }
+
+  double cutoff;
+};
+
+int
+main(int argc, char **argv)
+{
+  using namespace dealii;
+
+  Utilities::MPI::MPI_InitFinalize   mpi_initialization(argc, argv, 1);
+  parallel::shared::Triangulation<2> shared_tria(MPI_COMM_WORLD);
+
+  GridGenerator::hyper_cube(shared_tria);
+  shared_tria.refine_global(2);
+
+  std::ofstream out("output");
+
+  fdl::OverlapTriangulation<2> overlap_tria;
+  auto                         test = [&](const double cutoff) {
+    const bool changed = overlap_tria.reinit(shared_tria, LeftOf(cutoff));
+    out << "cutoff = " << cutoff << " changed = " << changed
+        << " number of active cells = " << overlap_tria.n_active_cells()
+        << '\n';
+  };
+
+  test(0.3);
+  test(0.3);
+  test(0.26);
+  test(0.6);
+
+  shared_tria.refine_global(1);
+  test(0.6);
+  test(0.6);
+}
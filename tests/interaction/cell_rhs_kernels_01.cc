@@ -0,0 +1,170 @@
+#include <fiddle/interaction/cell_rhs_kernels.h>
+#include <fiddle/interaction/interaction_utilities.h>
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_simplex_p.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_fe.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Verify that the cell right-hand side kernels, together with the
+// permutation ShapeValueCache::base_rhs_dofs, compute the same cell
+// right-hand sides as FEValues.
+
+using namespace dealii;
+
+template <int dim>
+void
+test(const Triangulation<dim>           &tria,
+     const Mapping<dim>                 &mapping,
+     const FiniteElement<dim>           &base_fe,
+     const std::vector<Quadrature<dim>> &quadratures,
+     const std::string                  &name,
+     std::ofstream                      &out)
+{
+  std::vector<unsigned char> quadrature_indices(tria.n_active_cells());
+  for (const auto &cell : tria.active_cell_iterators())
+    quadrature_indices[cell->active_cell_index()] =
+      cell->active_cell_index() % quadratures.size();
+
+  for (unsigned int n_components = 1; n_components < 4; ++n_components)
+    {
+      FESystem<dim>   fe(base_fe, n_components);
+      DoFHandler<dim> dof_handler(tria);
+      dof_handler.distribute_dofs(fe);
+      const unsigned int dofs_per_cell = fe.dofs_per_cell;
+
+      fdl::ShapeValueCache<dim> shape_value_cache;
+      fdl::compute_shape_value_cache(dof_handler,
+                                     mapping,
+                                     quadrature_indices,
+                                     quadratures,
+                                     shape_value_cache);
+      AssertThrow(shape_value_cache.n_base_dofs == base_fe.dofs_per_cell,
+                  ExcMessage("The base element should be detected"));
+      const unsigned int n_base_dofs = shape_value_cache.n_base_dofs;
+
+      const fdl::CellRHSKernel kernel =
+        fdl::get_cell_rhs_kernel(n_base_dofs, n_components);
+      double max_compiled_error = 0.0;
+      double max_generic_error  = 0.0;
+      for (const auto &cell : dof_handler.active_cell_iterators())
+        {
+          const unsigned char quad_index =
+            quadrature_indices[cell->active_cell_index()];
+          const Quadrature<dim> &quadrature = quadratures[quad_index];
+          FEValues<dim>          fe_values(mapping,
+                                  fe,
+                                  quadrature,
+                                  update_values | update_JxW_values);
+          fe_values.reinit(cell);
+
+          std::vector<double> values(quadrature.size() * n_components);
+          for (unsigned int i = 0; i < values.size(); ++i)
+            values[i] = std::sin(1.0 + i + 3.0 * cell->active_cell_index());
+
+          std::vector<double> expected(dofs_per_cell);
+          double              norm = 0.0;
+          for (unsigned int i = 0; i < dofs_per_cell; ++i)
+            {
+              const unsigned int c = fe.system_to_component_index(i).first;
+              for (unsigned int q = 0; q < quadrature.size(); ++q)
+                expected[i] += fe_values.shape_value_component(i, q, c) *
+                               values[q * n_components + c] *
+                               fe_values.JxW(q);
+              norm = std::max(norm, std::abs(expected[i]));
+            }
+
+          // compute with both kernels and undo the permutation:
+          std::vector<double> base_rhs(dofs_per_cell);
+          std::vector<double> cell_rhs(dofs_per_cell);
+          for (const fdl::CellRHSKernel k :
+               {kernel, fdl::CellRHSKernel(&fdl::compute_cell_rhs_generic)})
+            {
+              k(n_base_dofs,
+                n_components,
+                quadrature.size(),
+                shape_value_cache.base_shape_values[quad_index].data(),
+                values.data(),
+                shape_value_cache.get_JxW_values(cell->active_cell_index()),
+                base_rhs.data());
+              for (unsigned int j = 0; j < dofs_per_cell; ++j)
+                cell_rhs[shape_value_cache.base_rhs_dofs[j]] = base_rhs[j];
+
+              double &max_error = k == kernel ? max_compiled_error :
+                                                max_generic_error;
+              for (unsigned int i = 0; i < dofs_per_cell; ++i)
+                max_error = std::max(max_error,
+                                     std::abs(cell_rhs[i] - expected[i]) /
+                                       norm);
+            }
+        }
+
+      out << name << " x " << n_components << ": "
+          << (fdl::has_compiled_cell_rhs_kernel(n_base_dofs, n_components) ?
+                "compiled" :
+                "generic")
+          << " kernel " << (max_compiled_error < 1e-12 ? "OK" : "FAILED")
+          << ", generic kernel "
+          << (max_generic_error < 1e-12 ? "OK" : "FAILED") << '\n';
+    }
+}
+
+template <int dim>
+void
+test()
+{
+  std::ofstream out("output");
+
+  {
+    Triangulation<dim> tria;
+    GridGenerator::hyper_cube(tria);
+    tria.refine_global(1);
+    GridTools::distort_random(0.2, tria, false, 42);
+    MappingQ<dim> mapping(1);
+    for (unsigned int degree = 1; degree < 4; ++degree)
+      test(tria,
+           mapping,
+           FE_Q<dim>(degree),
+           {QGauss<dim>(degree + 1), QGauss<dim>(degree + 2)},
+           "FE_Q<" + std::to_string(dim) + ">(" + std::to_string(degree) +
+             ")",
+           out);
+  }
+
+  {
+    Triangulation<dim> tria;
+    GridGenerator::subdivided_hyper_cube_with_simplices(tria, 2);
+    GridTools::distort_random(0.2, tria, false, 42);
+    MappingFE<dim> mapping(FE_SimplexP<dim>(1));
+    for (unsigned int degree = 1; degree < 3; ++degree)
+      test(tria,
+           mapping,
+           FE_SimplexP<dim>(degree),
+           {QGaussSimplex<dim>(degree + 1), QGaussSimplex<dim>(degree + 2)},
+           "FE_SimplexP<" + std::to_string(dim) + ">(" +
+             std::to_string(degree) + ")",
+           out);
+  }
+}
+
+int
+main()
+{
+  test<NDIM>();
+}
@@ -0,0 +1,96 @@
+#include <fiddle/interaction/cell_rhs_kernels.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <random>
+#include <vector>
+
+// Test the cell right-hand side kernels against a direct loop on random data
+// for the sizes of the elements most commonly used with fiddle (i.e., FE_Q
+// degrees 1-3 and FE_SimplexP degrees 1-2 in 2D and 3D with one to three
+// components).
+
+void
+test(const unsigned int n_base_dofs,
+     const unsigned int n_q_points,
+     std::ofstream     &out)
+{
+  std::mt19937                           generator(42);
+  std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+  for (unsigned int n_components = 1; n_components < 4; ++n_components)
+    {
+      std::vector<double> shape_values(n_q_points * n_base_dofs);
+      std::vector<double> values(n_q_points * n_components);
+      std::vector<double> JxW_values(n_q_points);
+      for (double &v : shape_values)
+        v = distribution(generator);
+      for (double &v : values)
+        v = distribution(generator);
+      for (double &v : JxW_values)
+        v = distribution(generator);
+
+      std::vector<double> expected(n_base_dofs * n_components);
+      for (unsigned int q = 0; q < n_q_points; ++q)
+        for (unsigned int k = 0; k < n_base_dofs; ++k)
+          for (unsigned int c = 0; c < n_components; ++c)
+            expected[k * n_components + c] +=
+              shape_values[q * n_base_dofs + k] *
+              values[q * n_components + c] * JxW_values[q];
+      double norm = 0.0;
+      for (const double v : expected)
+        norm = std::max(norm, std::abs(v));
+
+      double max_compiled_error = 0.0;
+      double max_generic_error  = 0.0;
+      for (const fdl::CellRHSKernel kernel :
+           {fdl::get_cell_rhs_kernel(n_base_dofs, n_components),
+            &fdl::compute_cell_rhs_generic})
+        {
+          std::vector<double> rhs(n_base_dofs * n_components);
+          kernel(n_base_dofs,
+                 n_components,
+                 n_q_points,
+                 shape_values.data(),
+                 values.data(),
+                 JxW_values.data(),
+                 rhs.data());
+          double &max_error = kernel == &fdl::compute_cell_rhs_generic ?
+                                max_generic_error :
+                                max_compiled_error;
+          for (unsigned int i = 0; i < rhs.size(); ++i)
+            max_error =
+              std::max(max_error, std::abs(rhs[i] - expected[i]) / norm);
+        }
+
+      out << "n_base_dofs = " << n_base_dofs
+          << ", n_components = " << n_components << ": "
+          << (fdl::has_compiled_cell_rhs_kernel(n_base_dofs, n_components) ?
+                "compiled" :
+                "generic")
+          << " kernel " << (max_compiled_error < 1e-12 ? "OK" : "FAILED")
+          << ", generic kernel "
+          << (max_generic_error < 1e-12 ? "OK" : "FAILED") << '\n';
+    }
+}
+
+int
+main()
+{
+  std::ofstream out("output");
+
+  // FE_Q in 2D and 3D with QGauss(degree + 1):
+  for (unsigned int degree = 1; degree < 4; ++degree)
+    {
+      const unsigned int n = degree + 1;
+      test(n * n, n * n, out);
+      test(n * n * n, n * n * n, out);
+    }
+  // FE_SimplexP in 2D and 3D with typical QGaussSimplex rules:
+  test(3, 3, out);
+  test(6, 6, out);
+  test(4, 4, out);
+  test(10, 14, out);
+  // A size without a compiled kernel:
+  test(5, 7, out);
+}
@@ -0,0 +1,213 @@
+#include <fiddle/base/samrai_utilities.h>
+
+#include <fiddle/grid/overlap_tria.h>
+#include <fiddle/grid/patch_map.h>
+
+#include <fiddle/interaction/interaction_utilities.h>
+
+#include <deal.II/base/function_parser.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/vector_tools_interpolate.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+#include <ibtk/muParserCartGridFunction.h>
+
+#include <fstream>
+
+#include "../tests.h"
+
+// Test that interacting with several parts at once (i.e., with the
+// PartInteractionData versions of compute_projection_rhs() and
+// compute_spread()) gives exactly the same results as interacting with each
+// part separately. BSPLINE_3 uses our own kernels (and threads) whereas
+// PIECEWISE_CUBIC uses LEInteractor.
+
+using namespace SAMRAI;
+using namespace dealii;
+
+template <int dim, int spacedim = dim>
+void
+test(SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  auto input_db = app_initializer->getInputDatabase();
+
+  const auto mpi_comm = MPI_COMM_WORLD;
+  const auto rank     = Utilities::MPI::this_mpi_process(mpi_comm);
+
+  // setup deal.II stuff:
+  parallel::shared::Triangulation<dim, spacedim> native_tria(MPI_COMM_WORLD);
+  GridGenerator::hyper_cube(native_tria);
+  native_tria.refine_global(std::log2(input_db->getInteger("N")));
+
+  // setup SAMRAI stuff (its always the same):
+  auto tuple           = setup_hierarchy<spacedim>(app_initializer);
+  auto patch_hierarchy = std::get<0>(tuple);
+  auto f_idx           = std::get<5>(tuple);
+
+  SAMRAI::tbox::Pointer<SAMRAI::hier::Variable<spacedim>> f_var;
+  auto *var_db = hier::VariableDatabase<spacedim>::getDatabase();
+  var_db->mapIndexToVariable(f_idx, f_var);
+  const int g_idx = var_db->registerClonedPatchDataIndex(f_var, f_idx);
+  const int e_idx = var_db->registerClonedPatchDataIndex(f_var, f_idx);
+  for (int ln = 0; ln <= patch_hierarchy->getFinestLevelNumber(); ++ln)
+    {
+      tbox::Pointer<hier::PatchLevel<spacedim>> level =
+        patch_hierarchy->getPatchLevel(ln);
+      level->allocatePatchData(g_idx, 0.0);
+      level->allocatePatchData(e_idx, 0.0);
+    }
+  auto ops = fdl::extract_hierarchy_data_ops(f_var, patch_hierarchy);
+
+  // Now set up fiddle things for the test:
+  auto patches = fdl::extract_patches(
+    patch_hierarchy->getPatchLevel(patch_hierarchy->getFinestLevelNumber()));
+  const std::vector<BoundingBox<spacedim>> patch_bboxes =
+    fdl::compute_patch_bboxes(patches, 1.0);
+  fdl::TriaIntersectionPredicate<spacedim> tria_pred(patch_bboxes);
+  fdl::OverlapTriangulation<spacedim>      overlap_tria(native_tria, tria_pred);
+  std::vector<BoundingBox<spacedim, float>> cell_bboxes;
+  for (const auto &cell : overlap_tria.active_cell_iterators())
+    {
+      BoundingBox<spacedim, float> fbbox;
+      fbbox.get_boundary_points() = cell->bounding_box().get_boundary_points();
+      cell_bboxes.push_back(fbbox);
+    }
+  fdl::PatchMap<dim, spacedim> patch_map(patches,
+                                         1.0,
+                                         overlap_tria,
+                                         cell_bboxes);
+
+  // Set up two parts with different elements and quadratures on the same
+  // cells so that they share patches:
+  const MappingQ<dim, spacedim>    position_map(1);
+  const MappingQ<dim, spacedim>    F_map(1);
+  const std::vector<unsigned char> quadrature_indices(
+    overlap_tria.n_active_cells());
+  std::vector<std::vector<Quadrature<dim>>> quadratures;
+  std::vector<std::unique_ptr<DoFHandler<dim, spacedim>>> dof_handlers;
+  std::vector<fdl::InteractionPlan<dim, spacedim>>        plans(2);
+  std::vector<Vector<double>>                             Fs;
+  FunctionParser<spacedim>                                fp(
+    extract_fp_string(input_db->getDatabase("test")->getDatabase("f")),
+    "PI=" + std::to_string(numbers::PI),
+    "X_0,X_1");
+  for (unsigned int part_n = 0; part_n < 2; ++part_n)
+    {
+      quadratures.push_back({QGauss<dim>(part_n + 2)});
+      dof_handlers.emplace_back(
+        std::make_unique<DoFHandler<dim, spacedim>>(overlap_tria));
+      dof_handlers.back()->distribute_dofs(FE_Q<dim, spacedim>(part_n + 1));
+      fdl::compute_interaction_plan(patch_map,
+                                    position_map,
+                                    quadrature_indices,
+                                    quadratures.back(),
+                                    plans[part_n]);
+      Fs.emplace_back(dof_handlers.back()->n_dofs());
+      VectorTools::interpolate(F_map, *dof_handlers.back(), fp, Fs.back());
+    }
+
+  IBTK::muParserCartGridFunction f_fcn(
+    "f",
+    input_db->getDatabase("test")->getDatabase("f"),
+    patch_hierarchy->getGridGeometry());
+
+  std::ofstream output;
+  if (rank == 0)
+    output.open("output");
+  for (const std::string kernel_name : {"BSPLINE_3", "PIECEWISE_CUBIC"})
+    {
+      std::vector<fdl::PartInteractionData<dim, spacedim>> parts(2);
+      for (unsigned int part_n = 0; part_n < 2; ++part_n)
+        {
+          parts[part_n].kernel_name = kernel_name;
+          parts[part_n].native_kernel =
+            fdl::get_native_ib_kernel(kernel_name);
+          parts[part_n].patch_map          = &patch_map;
+          parts[part_n].plan               = &plans[part_n];
+          parts[part_n].quadrature_indices = &quadrature_indices;
+          parts[part_n].quadratures        = &quadratures[part_n];
+          parts[part_n].dof_handler        = dof_handlers[part_n].get();
+          parts[part_n].mapping            = &F_map;
+        }
+
+      // Interpolation:
+      {
+        ops->setToScalar(f_idx, 0.0, false);
+        f_fcn.setDataOnPatchHierarchy(f_idx, f_var, patch_hierarchy, 0.0);
+
+        std::vector<Vector<double>> fused_rhs;
+        std::vector<Vector<double> *> fused_rhs_ptrs;
+        for (unsigned int part_n = 0; part_n < 2; ++part_n)
+          fused_rhs.emplace_back(dof_handlers[part_n]->n_dofs());
+        for (Vector<double> &rhs : fused_rhs)
+          fused_rhs_ptrs.push_back(&rhs);
+        fdl::compute_projection_rhs(f_idx, parts, fused_rhs_ptrs);
+
+        bool same = true;
+        for (unsigned int part_n = 0; part_n < 2; ++part_n)
+          {
+            Vector<double> rhs(dof_handlers[part_n]->n_dofs());
+            fdl::compute_projection_rhs(kernel_name,
+                                        f_idx,
+                                        patch_map,
+                                        plans[part_n],
+                                        quadrature_indices,
+                                        quadratures[part_n],
+                                        *dof_handlers[part_n],
+                                        F_map,
+                                        rhs);
+            rhs -= fused_rhs[part_n];
+            same = same && rhs.linfty_norm() == 0.0;
+          }
+        same = Utilities::MPI::min(int(same), mpi_comm) == 1;
+        if (rank == 0)
+          output << kernel_name << " fused projection rhs: "
+                 << (same ? "OK" : "FAILED") << std::endl;
+      }
+
+      // Spreading:
+      {
+        ops->setToScalar(f_idx, 0.0, false);
+        ops->setToScalar(g_idx, 0.0, false);
+        fdl::compute_spread(f_idx, parts, {&Fs[0], &Fs[1]});
+        for (unsigned int part_n = 0; part_n < 2; ++part_n)
+          fdl::compute_spread(kernel_name,
+                              g_idx,
+                              patch_map,
+                              plans[part_n],
+                              quadrature_indices,
+                              quadratures[part_n],
+                              *dof_handlers[part_n],
+                              F_map,
+                              Fs[part_n]);
+        ops->subtract(e_idx, f_idx, g_idx);
+        const bool same = ops->maxNorm(e_idx) == 0.0;
+        if (rank == 0)
+          output << kernel_name << " fused spread: "
+                 << (same ? "OK" : "FAILED") << std::endl;
+      }
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "multilevel_fe_01.log");
+
+  test<2>(app_initializer);
+}
@@ -0,0 +1,39 @@
+#include <fiddle/interaction/ib_kernels.h>
+
+#include <fstream>
+#include <string>
+
+// Test the native IB kernels: print some values and verify that the kernels
+// are partitions of unity.
+
+template <typename Kernel>
+void
+test(const std::string &name, std::ofstream &out)
+{
+  out << name << " width = " << Kernel::width << '\n';
+  for (int i = -8; i <= 8; ++i)
+    out << "  phi(" << i / 4.0 << ") = " << Kernel::value(i / 4.0) << '\n';
+
+  // The sum over integer shifts should be one:
+  for (const double r : {0.0, 0.1, 0.25, 0.5, 0.8})
+    {
+      double sum = 0.0;
+      for (int j = -Kernel::width; j <= Kernel::width; ++j)
+        sum += Kernel::value(r - j);
+      out << "  sum at r = " << r << ": " << sum << '\n';
+    }
+}
+
+int
+main()
+{
+  std::ofstream out("output");
+  test<fdl::IB3Kernel>("IB_3", out);
+  test<fdl::IB4Kernel>("IB_4", out);
+  test<fdl::IB6Kernel>("IB_6", out);
+  test<fdl::BSplineKernel<2>>("PIECEWISE_LINEAR", out);
+  test<fdl::BSplineKernel<3>>("BSPLINE_3", out);
+  test<fdl::BSplineKernel<4>>("BSPLINE_4", out);
+  test<fdl::BSplineKernel<5>>("BSPLINE_5", out);
+  test<fdl::BSplineKernel<6>>("BSPLINE_6", out);
+}
@@ -0,0 +1,261 @@
+#include <fiddle/base/samrai_utilities.h>
+
+#include <fiddle/interaction/ib_kernels.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+#include <ibtk/LEInteractor.h>
+
+#include <CartesianPatchGeometry.h>
+#include <CellData.h>
+#include <CellVariable.h>
+#include <NodeData.h>
+#include <NodeVariable.h>
+#include <SideData.h>
+#include <SideVariable.h>
+#include <VariableDatabase.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "../tests.h"
+
+// Compare interpolate_from_patch() and spread_to_patch() to LEInteractor for
+// cell-, node-, and side-centered data with every native kernel. Ghost width 1
+// is narrower than every kernel's stencil so that case also checks that
+// stencils are clipped to the ghost region in the same way.
+
+using namespace SAMRAI;
+
+template <int spacedim>
+std::vector<pdat::ArrayData<spacedim, double> *>
+get_arrays(pdat::CellData<spacedim, double> &data)
+{
+  return {&data.getArrayData()};
+}
+
+template <int spacedim>
+std::vector<pdat::ArrayData<spacedim, double> *>
+get_arrays(pdat::NodeData<spacedim, double> &data)
+{
+  return {&data.getArrayData()};
+}
+
+template <int spacedim>
+std::vector<pdat::ArrayData<spacedim, double> *>
+get_arrays(pdat::SideData<spacedim, double> &data)
+{
+  std::vector<pdat::ArrayData<spacedim, double> *> result;
+  for (int axis = 0; axis < spacedim; ++axis)
+    result.push_back(&data.getArrayData(axis));
+  return result;
+}
+
+// Points spread over the patch and the first few ghost cells around it.
+template <int spacedim>
+std::vector<double>
+make_positions(const hier::Patch<spacedim> &patch)
+{
+  const tbox::Pointer<geom::CartesianPatchGeometry<spacedim>> geometry =
+    patch.getPatchGeometry();
+  const double *const dx      = geometry->getDx();
+  const double *const x_lower = geometry->getXLower();
+  const double *const x_upper = geometry->getXUpper();
+
+  const int           n_points = 200;
+  std::vector<double> positions(n_points * spacedim);
+  for (int point_n = 0; point_n < n_points; ++point_n)
+    for (int d = 0; d < spacedim; ++d)
+      {
+        // quasi-random numbers in [0, 1)
+        const double t = std::fmod(0.5 + (point_n + 1) * std::sqrt(2.0 + d),
+                                   1.0);
+        positions[point_n * spacedim + d] =
+          x_lower[d] - 1.5 * dx[d] + t * (x_upper[d] - x_lower[d] + 3 * dx[d]);
+      }
+  return positions;
+}
+
+template <int spacedim, typename patch_type>
+void
+test_data(tbox::Pointer<hier::PatchLevel<spacedim>> level,
+          const int                                 data_idx,
+          const int                                 depth,
+          const std::string                        &label,
+          std::ostream                             &out)
+{
+  for (const std::string kernel_name : {"IB_3",
+                                        "IB_4",
+                                        "IB_6",
+                                        "PIECEWISE_LINEAR",
+                                        "BSPLINE_3",
+                                        "BSPLINE_4",
+                                        "BSPLINE_5",
+                                        "BSPLINE_6"})
+    {
+      AssertThrow((fdl::has_native_ib_kernel<spacedim, patch_type>(
+                    kernel_name)),
+                  fdl::ExcFDLInternalError());
+      double max_interpolate_error = 0.0;
+      double max_spread_error      = 0.0;
+      for (tbox::Pointer<hier::Patch<spacedim>> patch :
+           fdl::extract_patches(level))
+        {
+          tbox::Pointer<patch_type> data = patch->getPatchData(data_idx);
+          const auto arrays              = get_arrays(*data);
+          const std::vector<double> positions = make_positions(*patch);
+          const int                 n_points  = positions.size() / spacedim;
+
+          // interpolation:
+          for (unsigned int array_n = 0; array_n < arrays.size(); ++array_n)
+            for (int d = 0; d < arrays[array_n]->getDepth(); ++d)
+              {
+                double *const ptr = arrays[array_n]->getPointer(d);
+                for (int i = 0; i < arrays[array_n]->getOffset(); ++i)
+                  ptr[i] = std::sin(0.1 * i + d + 0.3 * array_n);
+              }
+          std::vector<double> native_values(n_points * depth);
+          std::vector<double> le_values(n_points * depth);
+          fdl::interpolate_from_patch(native_values.data(),
+                                      native_values.size(),
+                                      depth,
+                                      positions.data(),
+                                      positions.size(),
+                                      data,
+                                      patch,
+                                      patch->getBox(),
+                                      kernel_name);
+          IBTK::LEInteractor::interpolate(le_values.data(),
+                                          le_values.size(),
+                                          depth,
+                                          positions.data(),
+                                          positions.size(),
+                                          spacedim,
+                                          data,
+                                          patch,
+                                          patch->getBox(),
+                                          kernel_name);
+          for (unsigned int i = 0; i < native_values.size(); ++i)
+            max_interpolate_error =
+              std::max(max_interpolate_error,
+                       std::abs(native_values[i] - le_values[i]));
+
+          // spreading:
+          std::vector<double> values(n_points * depth);
+          for (unsigned int i = 0; i < values.size(); ++i)
+            values[i] = std::cos(0.7 * i);
+          std::vector<std::vector<double>> native_arrays;
+          for (const std::string method : {"NATIVE", "LEINTERACTOR"})
+            {
+              fdl::fill_all(patch->getPatchData(data_idx), 0.0);
+              if (method == "NATIVE")
+                fdl::spread_to_patch(data,
+                                     values.data(),
+                                     values.size(),
+                                     depth,
+                                     positions.data(),
+                                     positions.size(),
+                                     patch,
+                                     patch->getBox(),
+                                     kernel_name);
+              else
+                IBTK::LEInteractor::spread(data,
+                                           values.data(),
+                                           values.size(),
+                                           depth,
+                                           positions.data(),
+                                           positions.size(),
+                                           spacedim,
+                                           patch,
+                                           patch->getBox(),
+                                           kernel_name);
+
+              for (unsigned int array_n = 0; array_n < arrays.size();
+                   ++array_n)
+                {
+                  const auto  *array = arrays[array_n];
+                  const double *ptr  = array->getPointer(0);
+                  const int     size = array->getDepth() * array->getOffset();
+                  if (method == "NATIVE")
+                    native_arrays.emplace_back(ptr, ptr + size);
+                  else
+                    for (int i = 0; i < size; ++i)
+                      max_spread_error =
+                        std::max(max_spread_error,
+                                 std::abs(native_arrays[array_n][i] - ptr[i]));
+                }
+            }
+        }
+
+      max_interpolate_error =
+        dealii::Utilities::MPI::max(max_interpolate_error, MPI_COMM_WORLD);
+      max_spread_error =
+        dealii::Utilities::MPI::max(max_spread_error, MPI_COMM_WORLD);
+      out << label << ' ' << kernel_name << ": interpolate "
+          << (max_interpolate_error < 1e-12 ? "OK" : "FAILED") << ", spread "
+          << (max_spread_error < 1e-12 ? "OK" : "FAILED") << '\n';
+    }
+}
+
+template <int spacedim>
+void
+test(SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  auto tuple           = setup_hierarchy<spacedim>(app_initializer);
+  auto patch_hierarchy = std::get<0>(tuple);
+  auto level =
+    patch_hierarchy->getPatchLevel(patch_hierarchy->getFinestLevelNumber());
+
+  std::ofstream output;
+  if (dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    output.open("output");
+
+  auto     *var_db       = hier::VariableDatabase<spacedim>::getDatabase();
+  const int n_components = 2;
+  tbox::Pointer<pdat::CellVariable<spacedim, double>> cell_var =
+    new pdat::CellVariable<spacedim, double>("cell", n_components);
+  tbox::Pointer<pdat::NodeVariable<spacedim, double>> node_var =
+    new pdat::NodeVariable<spacedim, double>("node", n_components);
+  tbox::Pointer<pdat::SideVariable<spacedim, double>> side_var =
+    new pdat::SideVariable<spacedim, double>("side", 1);
+  for (const int ghost_width : {1, 4})
+    {
+      tbox::Pointer<hier::VariableContext> ctx =
+        var_db->getContext("ghost_width_" + std::to_string(ghost_width));
+      const hier::IntVector<spacedim> gcw(ghost_width);
+      const int                       cell_idx =
+        var_db->registerVariableAndContext(cell_var, ctx, gcw);
+      const int node_idx =
+        var_db->registerVariableAndContext(node_var, ctx, gcw);
+      const int side_idx =
+        var_db->registerVariableAndContext(side_var, ctx, gcw);
+      level->allocatePatchData(cell_idx, 0.0);
+      level->allocatePatchData(node_idx, 0.0);
+      level->allocatePatchData(side_idx, 0.0);
+
+      const std::string suffix = " ghost width " + std::to_string(ghost_width);
+      test_data<spacedim, pdat::CellData<spacedim, double>>(
+        level, cell_idx, n_components, "CELL" + suffix, output);
+      test_data<spacedim, pdat::NodeData<spacedim, double>>(
+        level, node_idx, n_components, "NODE" + suffix, output);
+      // LEInteractor's depth for side-centered data includes the spacedim
+      // factor
+      test_data<spacedim, pdat::SideData<spacedim, double>>(
+        level, side_idx, spacedim, "SIDE" + suffix, output);
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "ib_kernels_02.log");
+
+  test<NDIM>(app_initializer);
+}
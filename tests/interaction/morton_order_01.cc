@@ -0,0 +1,229 @@
+#include <fiddle/base/samrai_utilities.h>
+
+#include <fiddle/grid/overlap_tria.h>
+#include <fiddle/grid/patch_map.h>
+
+#include <fiddle/interaction/interaction_utilities.h>
+
+#include <deal.II/base/function_parser.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/vector_tools_interpolate.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+#include <ibtk/muParserCartGridFunction.h>
+
+#include <algorithm>
+#include <fstream>
+
+#include "../tests.h"
+
+// Test morton_order_interaction_plan(): the cells on each patch should be
+// permuted (and, for a mesh not made by refining a single coarse cell,
+// actually reordered) and interaction should only change by roundoff.
+
+using namespace SAMRAI;
+using namespace dealii;
+
+template <int dim, int spacedim = dim>
+void
+test(SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  auto input_db = app_initializer->getInputDatabase();
+
+  const auto mpi_comm = MPI_COMM_WORLD;
+  const auto rank     = Utilities::MPI::this_mpi_process(mpi_comm);
+
+  // setup deal.II stuff:
+  parallel::shared::Triangulation<dim, spacedim> native_tria(MPI_COMM_WORLD);
+  GridGenerator::concentric_hyper_shells(
+    native_tria, Point<spacedim>(), 0.125, 0.25, 2, 0.0);
+  native_tria.refine_global(4);
+
+  // setup SAMRAI stuff (its always the same):
+  auto tuple           = setup_hierarchy<spacedim>(app_initializer);
+  auto patch_hierarchy = std::get<0>(tuple);
+  auto f_idx           = std::get<5>(tuple);
+
+  SAMRAI::tbox::Pointer<SAMRAI::hier::Variable<spacedim>> f_var;
+  auto *var_db = hier::VariableDatabase<spacedim>::getDatabase();
+  var_db->mapIndexToVariable(f_idx, f_var);
+  const int g_idx = var_db->registerClonedPatchDataIndex(f_var, f_idx);
+  const int e_idx = var_db->registerClonedPatchDataIndex(f_var, f_idx);
+  for (int ln = 0; ln <= patch_hierarchy->getFinestLevelNumber(); ++ln)
+    {
+      tbox::Pointer<hier::PatchLevel<spacedim>> level =
+        patch_hierarchy->getPatchLevel(ln);
+      level->allocatePatchData(g_idx, 0.0);
+      level->allocatePatchData(e_idx, 0.0);
+    }
+  auto ops = fdl::extract_hierarchy_data_ops(f_var, patch_hierarchy);
+
+  // Now set up fiddle things for the test:
+  auto patches = fdl::extract_patches(
+    patch_hierarchy->getPatchLevel(patch_hierarchy->getFinestLevelNumber()));
+  const std::vector<BoundingBox<spacedim>> patch_bboxes =
+    fdl::compute_patch_bboxes(patches, 1.0);
+  fdl::TriaIntersectionPredicate<spacedim> tria_pred(patch_bboxes);
+  fdl::OverlapTriangulation<spacedim>      overlap_tria(native_tria, tria_pred);
+  std::vector<BoundingBox<spacedim, float>> cell_bboxes;
+  for (const auto &cell : overlap_tria.active_cell_iterators())
+    {
+      BoundingBox<spacedim, float> fbbox;
+      fbbox.get_boundary_points() = cell->bounding_box().get_boundary_points();
+      cell_bboxes.push_back(fbbox);
+    }
+  fdl::PatchMap<dim, spacedim> patch_map(patches,
+                                         1.0,
+                                         overlap_tria,
+                                         cell_bboxes);
+
+  const MappingQ<dim, spacedim>      position_map(1);
+  const MappingQ<dim, spacedim>      F_map(1);
+  const std::vector<Quadrature<dim>> quadratures({QGauss<dim>(2)});
+  const std::vector<unsigned char>   quadrature_indices(
+    overlap_tria.n_active_cells());
+  DoFHandler<dim, spacedim> F_dof_handler(overlap_tria);
+  F_dof_handler.distribute_dofs(FE_Q<dim, spacedim>(1));
+
+  fdl::InteractionPlan<dim, spacedim> plan;
+  fdl::compute_interaction_plan(
+    patch_map, position_map, quadrature_indices, quadratures, plan);
+  fdl::InteractionPlan<dim, spacedim> morton_plan = plan;
+  fdl::morton_order_interaction_plan(patch_map, morton_plan);
+
+  std::ofstream output;
+  if (rank == 0)
+    output.open("output");
+
+  // Check that the cells on each patch are a permutation of the original
+  // ones:
+  {
+    bool permuted  = plan.n_cells() == morton_plan.n_cells() &&
+                    plan.patch_cell_offsets == morton_plan.patch_cell_offsets;
+    bool reordered = false;
+    for (std::size_t patch_n = 0;
+         permuted && patch_n + 1 < plan.patch_cell_offsets.size();
+         ++patch_n)
+      {
+        std::vector<unsigned int> cells;
+        std::vector<unsigned int> morton_cells;
+        for (std::size_t cell_n = plan.patch_cell_offsets[patch_n];
+             cell_n < plan.patch_cell_offsets[patch_n + 1];
+             ++cell_n)
+          {
+            cells.push_back(plan.cells[cell_n]->active_cell_index());
+            morton_cells.push_back(
+              morton_plan.cells[cell_n]->active_cell_index());
+          }
+        reordered = reordered || cells != morton_cells;
+        std::sort(cells.begin(), cells.end());
+        std::sort(morton_cells.begin(), morton_cells.end());
+        permuted = permuted && cells == morton_cells;
+      }
+    permuted  = Utilities::MPI::min(int(permuted), mpi_comm) == 1;
+    reordered = Utilities::MPI::max(int(reordered), mpi_comm) == 1;
+    if (rank == 0)
+      {
+        output << "cells permuted: " << (permuted ? "OK" : "FAILED")
+               << std::endl;
+        output << "cells reordered: " << (reordered ? "OK" : "FAILED")
+               << std::endl;
+      }
+  }
+
+  // Interpolation:
+  {
+    IBTK::muParserCartGridFunction f_fcn(
+      "f",
+      input_db->getDatabase("test")->getDatabase("f"),
+      patch_hierarchy->getGridGeometry());
+    ops->setToScalar(f_idx, 0.0, false);
+    f_fcn.setDataOnPatchHierarchy(f_idx, f_var, patch_hierarchy, 0.0);
+
+    Vector<double> rhs(F_dof_handler.n_dofs());
+    Vector<double> morton_rhs(F_dof_handler.n_dofs());
+    fdl::compute_projection_rhs("BSPLINE_3",
+                                f_idx,
+                                patch_map,
+                                plan,
+                                quadrature_indices,
+                                quadratures,
+                                F_dof_handler,
+                                F_map,
+                                rhs);
+    fdl::compute_projection_rhs("BSPLINE_3",
+                                f_idx,
+                                patch_map,
+                                morton_plan,
+                                quadrature_indices,
+                                quadratures,
+                                F_dof_handler,
+                                F_map,
+                                morton_rhs);
+    morton_rhs -= rhs;
+    const bool same =
+      Utilities::MPI::min(int(morton_rhs.linfty_norm() <=
+                              1e-12 * rhs.linfty_norm()),
+                          mpi_comm) == 1;
+    if (rank == 0)
+      output << "projection rhs: " << (same ? "OK" : "FAILED") << std::endl;
+  }
+
+  // Spreading:
+  {
+    FunctionParser<spacedim> fp(
+      extract_fp_string(input_db->getDatabase("test")->getDatabase("f")),
+      "PI=" + std::to_string(numbers::PI),
+      "X_0,X_1");
+    Vector<double> F(F_dof_handler.n_dofs());
+    VectorTools::interpolate(F_map, F_dof_handler, fp, F);
+
+    ops->setToScalar(f_idx, 0.0, false);
+    ops->setToScalar(g_idx, 0.0, false);
+    fdl::compute_spread("BSPLINE_3",
+                        f_idx,
+                        patch_map,
+                        plan,
+                        quadrature_indices,
+                        quadratures,
+                        F_dof_handler,
+                        F_map,
+                        F);
+    fdl::compute_spread("BSPLINE_3",
+                        g_idx,
+                        patch_map,
+                        morton_plan,
+                        quadrature_indices,
+                        quadratures,
+                        F_dof_handler,
+                        F_map,
+                        F);
+    ops->subtract(e_idx, f_idx, g_idx);
+    const bool same = ops->maxNorm(e_idx) <= 1e-12 * ops->maxNorm(f_idx);
+    if (rank == 0)
+      output << "spread: " << (same ? "OK" : "FAILED") << std::endl;
+  }
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "multilevel_fe_01.log");
+
+  test<2>(app_initializer);
+}
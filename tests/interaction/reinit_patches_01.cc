@@ -0,0 +1,276 @@
+#include <fiddle/base/samrai_utilities.h>
+
+#include <fiddle/grid/grid_utilities.h>
+
+#include <fiddle/interaction/elemental_interaction.h>
+
+#include <deal.II/base/function.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/numerics/vector_tools_interpolate.h>
+
+#include <CartesianPatchGeometry.h>
+
+#include <ibtk/AppInitializer.h>
+#include <ibtk/IBTKInit.h>
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+
+#include "../tests.h"
+
+// Test that InteractionBase::reinit_patches() keeps the current patches when
+// the structure moves less than the extra ghost region allows and refuses to
+// otherwise. In both cases the projection right-hand side should match the
+// one computed by an object set up from scratch at the new position.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int dim>
+class ShiftedIdentity : public Function<dim>
+{
+public:
+  ShiftedIdentity(const double shift)
+    : Function<dim>(dim)
+    , shift(shift)
+  {}
+
+  virtual double
+  value(const Point<dim> &p, const unsigned int component) const override
+  {
+    return p[component] + (component == 0 ? shift : 0.0);
+  }
+
+  const double shift;
+};
+
+template <int dim, int spacedim = dim>
+void
+test(SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer)
+{
+  constexpr int fe_degree = 1;
+
+  const auto mpi_comm = MPI_COMM_WORLD;
+  const auto rank     = Utilities::MPI::this_mpi_process(mpi_comm);
+
+  // setup deal.II stuff:
+  parallel::shared::Triangulation<dim, spacedim> native_tria(mpi_comm);
+  GridGenerator::concentric_hyper_shells(
+    native_tria, Point<spacedim>(), 0.125, 0.25, 2, 0.0);
+  native_tria.refine_global(4);
+
+  FE_Q<dim>     F_fe(fe_degree);
+  FESystem<dim> position_fe(FE_Q<dim>(fe_degree), dim);
+
+  DoFHandler<dim> position_dof_handler(native_tria);
+  position_dof_handler.distribute_dofs(position_fe);
+  DoFHandler<dim> F_dof_handler(native_tria);
+  F_dof_handler.distribute_dofs(F_fe);
+  IndexSet locally_relevant_position_dofs;
+  DoFTools::extract_locally_relevant_dofs(position_dof_handler,
+                                          locally_relevant_position_dofs);
+  IndexSet locally_relevant_F_dofs;
+  DoFTools::extract_locally_relevant_dofs(F_dof_handler,
+                                          locally_relevant_F_dofs);
+
+  auto position_partitioner = std::make_shared<Utilities::MPI::Partitioner>(
+    position_dof_handler.locally_owned_dofs(),
+    locally_relevant_position_dofs,
+    native_tria.get_communicator());
+  auto F_partitioner = std::make_shared<Utilities::MPI::Partitioner>(
+    F_dof_handler.locally_owned_dofs(),
+    locally_relevant_F_dofs,
+    native_tria.get_communicator());
+
+  MappingQ1<dim> F_mapping;
+
+  // setup SAMRAI stuff (its always the same):
+  auto       tuple           = setup_hierarchy<spacedim>(app_initializer);
+  auto       patch_hierarchy = std::get<0>(tuple);
+  auto       f_idx           = std::get<5>(tuple);
+  const auto level_number    = patch_hierarchy->getFinestLevelNumber();
+
+  double dx_min = std::numeric_limits<double>::max();
+  for (const auto &patch :
+       fdl::extract_patches(patch_hierarchy->getPatchLevel(level_number)))
+    {
+      const tbox::Pointer<geom::CartesianPatchGeometry<spacedim>> geometry =
+        patch->getPatchGeometry();
+      const double *const dx = geometry->getDx();
+      dx_min = std::min(dx_min, *std::min_element(dx, dx + spacedim));
+    }
+  dx_min = Utilities::MPI::min(dx_min, mpi_comm);
+
+  // Set up fiddle things for the structure shifted by @p shift:
+  const auto local_edge_lengths =
+    fdl::compute_longest_edge_lengths(native_tria, F_mapping, QGauss<1>(2));
+  const auto all_edge_lengths =
+    fdl::collect_longest_edge_lengths(native_tria, local_edge_lengths);
+  auto get_bboxes = [&](const double shift) {
+    std::vector<BoundingBox<spacedim, float>> bboxes;
+    for (const auto &cell : native_tria.active_cell_iterators())
+      if (cell->is_locally_owned())
+        {
+          auto points = cell->bounding_box().get_boundary_points();
+          points.first[0] += shift;
+          points.second[0] += shift;
+          Point<spacedim, float> p0;
+          Point<spacedim, float> p1;
+          for (unsigned int d = 0; d < spacedim; ++d)
+            {
+              p0[d] = points.first[d];
+              p1[d] = points.second[d];
+            }
+          bboxes.emplace_back(std::make_pair(p0, p1));
+        }
+    return fdl::collect_all_active_cell_bboxes(native_tria, bboxes);
+  };
+  auto get_position = [&](const double shift) {
+    LinearAlgebra::distributed::Vector<double> position(position_partitioner);
+    VectorTools::interpolate(position_dof_handler,
+                             ShiftedIdentity<spacedim>(shift),
+                             position);
+    position.update_ghost_values();
+    return position;
+  };
+  auto compute_rhs = [&](fdl::ElementalInteraction<dim, spacedim> &interaction,
+                         const double                               shift) {
+    const auto position = get_position(shift);
+    LinearAlgebra::distributed::Vector<double> F_rhs(F_partitioner);
+    auto transaction =
+      interaction.compute_projection_rhs_start("BSPLINE_3",
+                                               f_idx,
+                                               position_dof_handler,
+                                               position,
+                                               F_dof_handler,
+                                               F_mapping,
+                                               F_rhs);
+    transaction =
+      interaction.compute_projection_rhs_intermediate(std::move(transaction));
+    interaction.compute_projection_rhs_finish(std::move(transaction));
+    return F_rhs;
+  };
+  auto compute_new_rhs = [&](const double shift) {
+    fdl::ElementalInteraction<dim, spacedim> interaction(
+      native_tria,
+      get_bboxes(shift),
+      all_edge_lengths,
+      patch_hierarchy,
+      level_number,
+      fe_degree + 1,
+      1.0,
+      fdl::DensityKind::Minimum);
+    interaction.add_dof_handler(position_dof_handler);
+    interaction.add_dof_handler(F_dof_handler);
+    return compute_rhs(interaction, shift);
+  };
+  auto matches = [&](const LinearAlgebra::distributed::Vector<double> &rhs,
+                     const double                                      shift) {
+    auto difference = compute_new_rhs(shift);
+    difference -= rhs;
+    return difference.linfty_norm() < 1e-12 * rhs.linfty_norm();
+  };
+
+  std::ofstream output;
+  if (rank == 0)
+    output.open("output");
+  auto print_reinit_patches = [&](const double fraction,
+                                  const double displacement,
+                                  const bool   reused) {
+    if (rank == 0)
+      output << "extra ghost cell fraction = " << fraction
+             << ", displacement = " << displacement
+             << " dx: " << (reused ? "patches reused" : "patches rebuilt")
+             << std::endl;
+  };
+
+  // The default extra ghost region leaves no room for displacement:
+  {
+    fdl::ElementalInteraction<dim, spacedim> interaction(
+      native_tria,
+      get_bboxes(0.0),
+      all_edge_lengths,
+      patch_hierarchy,
+      level_number,
+      fe_degree + 1,
+      1.0,
+      fdl::DensityKind::Minimum);
+    print_reinit_patches(1.0,
+                         0.0,
+                         interaction.reinit_patches(patch_hierarchy,
+                                                    level_number,
+                                                    0.0));
+  }
+
+  const double                             fraction = 3.0;
+  fdl::ElementalInteraction<dim, spacedim> interaction(
+    fe_degree + 1, 1.0, fdl::DensityKind::Minimum);
+  interaction.set_extra_ghost_cell_fraction(fraction);
+  interaction.reinit(native_tria,
+                     get_bboxes(0.0),
+                     all_edge_lengths,
+                     patch_hierarchy,
+                     level_number);
+  interaction.add_dof_handler(position_dof_handler);
+  interaction.add_dof_handler(F_dof_handler);
+
+  // Within the bound the old association of elements and patches still
+  // covers the displaced structure:
+  {
+    const double shift  = 0.5 * dx_min;
+    const bool   reused = interaction.reinit_patches(patch_hierarchy,
+                                                   level_number,
+                                                   shift);
+    print_reinit_patches(fraction, 0.5, reused);
+    const bool ok = matches(compute_rhs(interaction, shift), shift);
+    if (rank == 0)
+      output << "reused rhs: " << (ok ? "OK" : "FAILED") << std::endl;
+  }
+
+  // Past the bound the object must be reinitialized:
+  {
+    const double shift  = 2.5 * dx_min;
+    const bool   reused = interaction.reinit_patches(patch_hierarchy,
+                                                   level_number,
+                                                   shift);
+    print_reinit_patches(fraction, 2.5, reused);
+    if (!reused)
+      {
+        interaction.reinit(native_tria,
+                           get_bboxes(shift),
+                           all_edge_lengths,
+                           patch_hierarchy,
+                           level_number);
+        interaction.add_dof_handler(position_dof_handler);
+        interaction.add_dof_handler(F_dof_handler);
+      }
+    const bool ok = matches(compute_rhs(interaction, shift), shift);
+    if (rank == 0)
+      output << "reinitialized rhs: " << (ok ? "OK" : "FAILED") << std::endl;
+  }
+}
+
+int
+main(int argc, char **argv)
+{
+  IBTK::IBTKInit ibtk_init(argc, argv, MPI_COMM_WORLD);
+  SAMRAI::tbox::Pointer<IBTK::AppInitializer> app_initializer =
+    new IBTK::AppInitializer(argc, argv, "multilevel_fe_01.log");
+
+  test<NDIM>(app_initializer);
+}
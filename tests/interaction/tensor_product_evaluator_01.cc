@@ -0,0 +1,106 @@
+#include <fiddle/interaction/tensor_product_evaluator.h>
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+
+#include <cmath>
+#include <fstream>
+#include <string>
+
+// Verify that sum factorization gives the same values as FEValues.
+
+using namespace dealii;
+
+template <int dim, int spacedim>
+void
+test(const FiniteElement<dim, spacedim> &fe,
+     const Quadrature<dim>              &quadrature,
+     const std::string                  &name,
+     std::ofstream                      &out)
+{
+  out << name << " n_q_points = " << quadrature.size() << ": ";
+  if (!fdl::TensorProductEvaluator<dim, spacedim>::is_supported(fe,
+                                                                 quadrature))
+    {
+      out << "not supported\n";
+      return;
+    }
+
+  Triangulation<dim, spacedim> tria;
+  GridGenerator::hyper_cube(tria);
+  GridTools::distort_random(0.2, tria, false, 42);
+  DoFHandler<dim, spacedim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  std::vector<double> dof_values(fe.dofs_per_cell);
+  for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+    dof_values[i] = std::sin(1.0 + i);
+
+  MappingQ<dim, spacedim> mapping(2);
+  FEValues<dim, spacedim> fe_values(mapping, fe, quadrature, update_values);
+  fe_values.reinit(dof_handler.begin_active());
+
+  fdl::TensorProductEvaluator<dim, spacedim> evaluator(fe, quadrature);
+  std::vector<double> values(evaluator.n_q_points() * evaluator.n_components());
+  std::vector<double> scratch;
+  evaluator.evaluate(dof_values.data(), values.data(), scratch);
+
+  double max_error = 0.0;
+  for (unsigned int q = 0; q < quadrature.size(); ++q)
+    for (unsigned int c = 0; c < fe.n_components(); ++c)
+      {
+        double expected = 0.0;
+        for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+          expected +=
+            dof_values[i] * fe_values.shape_value_component(i, q, c);
+        max_error = std::max(max_error,
+                             std::abs(expected -
+                                      values[q * fe.n_components() + c]));
+      }
+  out << (max_error < 1e-12 ? "OK" : "FAILED") << '\n';
+}
+
+int
+main()
+{
+  std::ofstream out("output");
+
+  for (unsigned int degree = 1; degree < 5; ++degree)
+    for (unsigned int n_points = 1; n_points < 6; ++n_points)
+      {
+        test(FESystem<2>(FE_Q<2>(degree), 2),
+             QGauss<2>(n_points),
+             "FESystem<2>(FE_Q<2>(" + std::to_string(degree) + "), 2)",
+             out);
+        test(FE_Q<1, 2>(degree),
+             QGauss<1>(n_points),
+             "FE_Q<1, 2>(" + std::to_string(degree) + ")",
+             out);
+      }
+
+  // Equidistant support points:
+  test(FE_Q<2>(QIterated<1>(QTrapezoid<1>(), 3)),
+       QGauss<2>(4),
+       "FE_Q<2>(equidistant 3)",
+       out);
+
+  // Unsupported cases:
+  test(FESystem<2>(FE_Q<2>(1), 1, FE_Q<2>(2), 1),
+       QGauss<2>(3),
+       "FESystem<2>(FE_Q<2>(1), 1, FE_Q<2>(2), 1)",
+       out);
+  test(FE_Q<2>(2),
+       Quadrature<2>(QGauss<2>(3).get_points()),
+       "FE_Q<2>(2) with a non-tensor rule",
+       out);
+}
@@ -0,0 +1,358 @@
+#include <fiddle/base/exceptions.h>
+
+#include <fiddle/mechanics/force_contribution.h>
+#include <fiddle/mechanics/mechanics_utilities.h>
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include <deal.II/numerics/vector_tools_interpolate.h>
+
+#include <fstream>
+
+#include "../tests.h"
+
+// Verify that the matrix-free version of compute_load_vector() computes the
+// same load vector as the FEValues version and that the per-cell adapter for
+// batched forces works. Also check that forces with other quadratures use a
+// MatrixFree object set up with several quadratures.
+
+using namespace dealii;
+using namespace SAMRAI;
+
+template <int dim>
+class Position : public Function<dim>
+{
+public:
+  Position()
+    : Function<dim>(dim)
+  {}
+
+  virtual double
+  value(const Point<dim> &p, const unsigned int component = 0) const override
+  {
+    AssertIndexRange(component, dim);
+    if (component == 0)
+      return std::sin(p[0]) * std::cos(p[1]);
+    return std::cos(p[0]) * std::sin(p[1]);
+  }
+};
+
+template <int spacedim, typename Number>
+Tensor<2, spacedim, Number>
+stvk_stress(const Tensor<2, spacedim, Number> &FF)
+{
+  // PP = FF * SS, SS = 2 E + tr(E) I
+  Tensor<2, spacedim, Number> II;
+  for (unsigned int d = 0; d < spacedim; ++d)
+    II[d][d] = 1.0;
+  const Tensor<2, spacedim, Number> EE = 0.5 * (transpose(FF) * FF - II);
+  return FF * (2.0 * EE + trace(EE) * II);
+}
+
+template <int dim, int spacedim = dim>
+class Stress : public fdl::ForceContribution<dim, spacedim>
+{
+public:
+  Stress(const Quadrature<dim> &quad, const bool batched)
+    : fdl::ForceContribution<dim, spacedim>(quad)
+    , batched(batched)
+  {}
+
+  virtual fdl::MechanicsUpdateFlags
+  get_mechanics_update_flags() const override
+  {
+    return fdl::MechanicsUpdateFlags::update_FF;
+  }
+
+  virtual bool
+  is_stress() const override
+  {
+    return true;
+  }
+
+  virtual bool
+  supports_batched_evaluation() const override
+  {
+    return batched;
+  }
+
+  virtual void
+  compute_stress(
+    const double /*time*/,
+    const fdl::MechanicsValues<dim, spacedim> &me_values,
+    const typename Triangulation<dim, spacedim>::active_cell_iterator
+      & /*cell*/,
+    ArrayView<Tensor<2, spacedim, double>> &stresses) const override
+  {
+    const auto &FF = me_values.get_FF();
+    for (unsigned int qp_n = 0; qp_n < FF.size(); ++qp_n)
+      stresses[qp_n] = stvk_stress(FF[qp_n]);
+  }
+
+  virtual void
+  compute_stress_batch(
+    const double /*time*/,
+    const fdl::BatchedMechanicsValues<dim, spacedim>        &me_values,
+    ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &stresses)
+    const override
+  {
+    const auto &FF = me_values.get_FF();
+    for (unsigned int qp_n = 0; qp_n < FF.size(); ++qp_n)
+      stresses[qp_n] += stvk_stress(FF[qp_n]);
+  }
+
+  bool batched;
+};
+
+// Modified neo-Hookean stress with a material-dependent shear modulus. This
+// uses several derived values and the cell, and only implements the per-cell
+// function if @p batched is false.
+template <int dim, int spacedim = dim>
+class NeoHookeanStress : public fdl::ForceContribution<dim, spacedim>
+{
+public:
+  NeoHookeanStress(const Quadrature<dim> &quad, const bool batched)
+    : fdl::ForceContribution<dim, spacedim>(quad)
+    , batched(batched)
+  {}
+
+  virtual fdl::MechanicsUpdateFlags
+  get_mechanics_update_flags() const override
+  {
+    return fdl::update_n23_det_FF | fdl::update_FF | fdl::update_FF_inv_T |
+           fdl::update_first_invariant;
+  }
+
+  virtual bool
+  is_stress() const override
+  {
+    return true;
+  }
+
+  virtual bool
+  supports_batched_evaluation() const override
+  {
+    return batched;
+  }
+
+  virtual void
+  compute_stress(
+    const double                               time,
+    const fdl::MechanicsValues<dim, spacedim> &me_values,
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &cell,
+    ArrayView<Tensor<2, spacedim, double>> &stresses) const override
+  {
+    if (batched)
+      {
+        fdl::ForceContribution<dim, spacedim>::compute_stress(time,
+                                                              me_values,
+                                                              cell,
+                                                              stresses);
+        return;
+      }
+
+    const double mu = 1.0 + cell->material_id();
+    for (unsigned int qp_n = 0; qp_n < stresses.size(); ++qp_n)
+      {
+        const auto &n23_J    = me_values.get_n23_det_FF()[qp_n];
+        const auto &FF       = me_values.get_FF()[qp_n];
+        const auto &I1       = me_values.get_first_invariant()[qp_n];
+        const auto &FF_inv_T = me_values.get_FF_inv_T()[qp_n];
+        stresses[qp_n]       = mu * n23_J * (FF - (I1 / 3.0) * FF_inv_T);
+      }
+  }
+
+  virtual void
+  compute_stress_batch(
+    const double /*time*/,
+    const fdl::BatchedMechanicsValues<dim, spacedim>        &me_values,
+    ArrayView<Tensor<2, spacedim, VectorizedArray<double>>> &stresses)
+    const override
+  {
+    VectorizedArray<double> mu = 1.0;
+    for (unsigned int lane = 0; lane < me_values.n_filled_lanes(); ++lane)
+      mu[lane] += me_values.get_cell(lane)->material_id();
+    for (unsigned int qp_n = 0; qp_n < stresses.size(); ++qp_n)
+      {
+        const auto &n23_J    = me_values.get_n23_det_FF()[qp_n];
+        const auto &FF       = me_values.get_FF()[qp_n];
+        const auto &I1       = me_values.get_first_invariant()[qp_n];
+        const auto &FF_inv_T = me_values.get_FF_inv_T()[qp_n];
+        stresses[qp_n] += mu * n23_J * (FF - (I1 / 3.0) * FF_inv_T);
+      }
+  }
+
+  bool batched;
+};
+
+template <int dim, int spacedim = dim>
+class Force : public fdl::ForceContribution<dim, spacedim>
+{
+public:
+  Force(const Quadrature<dim> &quad, const bool batched)
+    : fdl::ForceContribution<dim, spacedim>(quad)
+    , batched(batched)
+  {}
+
+  virtual fdl::MechanicsUpdateFlags
+  get_mechanics_update_flags() const override
+  {
+    return fdl::MechanicsUpdateFlags::update_position_values |
+           fdl::MechanicsUpdateFlags::update_velocity_values;
+  }
+
+  virtual bool
+  is_volume_force() const override
+  {
+    return true;
+  }
+
+  virtual bool
+  supports_batched_evaluation() const override
+  {
+    return batched;
+  }
+
+  virtual void
+  compute_force(const double /*time*/,
+                const fdl::MechanicsValues<dim, spacedim> &me_values,
+                ArrayView<Tensor<1, spacedim, double>> &forces) const override
+  {
+    const auto &positions  = me_values.get_position_values();
+    const auto &velocities = me_values.get_velocity_values();
+    for (unsigned int qp_n = 0; qp_n < forces.size(); ++qp_n)
+      forces[qp_n] = -positions[qp_n] + 0.5 * velocities[qp_n];
+  }
+
+  virtual void
+  compute_volume_force_batch(
+    const double /*time*/,
+    const fdl::BatchedMechanicsValues<dim, spacedim>        &me_values,
+    ArrayView<Tensor<1, spacedim, VectorizedArray<double>>> &forces)
+    const override
+  {
+    const auto &positions  = me_values.get_position_values();
+    const auto &velocities = me_values.get_velocity_values();
+    for (unsigned int qp_n = 0; qp_n < forces.size(); ++qp_n)
+      forces[qp_n] += -positions[qp_n] + 0.5 * velocities[qp_n];
+  }
+
+  bool batched;
+};
+
+template <int dim, int spacedim = dim>
+void
+test()
+{
+  const MPI_Comm comm = MPI_COMM_WORLD;
+  std::ofstream  output;
+  if (Utilities::MPI::this_mpi_process(comm) == 0)
+    output.open("output");
+
+  parallel::shared::Triangulation<dim, spacedim> tria(comm);
+  GridGenerator::hyper_shell(tria, Point<dim>(), 1.0, 2.0, 0, true);
+  tria.refine_global(1);
+  for (const auto &cell : tria.active_cell_iterators())
+    cell->set_material_id(cell->active_cell_index() % 3);
+  for (unsigned int degree = 1; degree < 4; ++degree)
+    {
+      FESystem<dim, spacedim>   fe(FE_Q<dim, spacedim>(degree), spacedim);
+      DoFHandler<dim, spacedim> dof_handler(tria);
+      dof_handler.distribute_dofs(fe);
+      MappingQ<dim, spacedim>   mapping(1);
+      QGauss<dim>               quadrature(degree + 1);
+      AffineConstraints<double> constraints;
+      constraints.close();
+      MatrixFree<dim, double> matrix_free;
+      matrix_free.reinit(mapping, dof_handler, constraints, quadrature);
+
+      LinearAlgebra::distributed::Vector<double> position, velocity, rhs1,
+        rhs2, rhs3;
+      matrix_free.initialize_dof_vector(position);
+      matrix_free.initialize_dof_vector(velocity);
+      matrix_free.initialize_dof_vector(rhs1);
+      matrix_free.initialize_dof_vector(rhs2);
+      matrix_free.initialize_dof_vector(rhs3);
+      VectorTools::interpolate(dof_handler, Position<spacedim>(), position);
+      for (unsigned int i = 0; i < velocity.locally_owned_size(); ++i)
+        velocity.local_element(i) = std::sin(double(i));
+      position.update_ghost_values();
+      velocity.update_ghost_values();
+
+      // Use two quadratures so that we test the fallback too: it evaluates
+      // the batched forces s3 and n4 on one cell at a time
+      QGauss<dim>           quadrature2(degree + 2);
+      Stress<dim, spacedim> s1(quadrature, false), s2(quadrature, true),
+        s3(quadrature2, true);
+      NeoHookeanStress<dim, spacedim> n1(quadrature, false),
+        n2(quadrature, true), n3(quadrature2, false), n4(quadrature2, true);
+      Force<dim, spacedim> f1(quadrature, false), f2(quadrature, true);
+      std::vector<fdl::ForceContribution<dim, spacedim> *> forces1{
+        &s1, &s3, &n1, &n3, &f1};
+      std::vector<fdl::ForceContribution<dim, spacedim> *> forces2{
+        &s2, &s3, &n2, &n4, &f2};
+
+      fdl::compute_load_vector(
+        dof_handler, mapping, forces1, 0.0, position, velocity, rhs1);
+      rhs1.compress(VectorOperation::add);
+      fdl::compute_load_vector(dof_handler,
+                               mapping,
+                               matrix_free,
+                               forces2,
+                               0.0,
+                               position,
+                               velocity,
+                               rhs2);
+      rhs2.compress(VectorOperation::add);
+
+      // Like Part, set up a second MatrixFree object with both quadratures
+      // so that no force needs the fallback
+      MatrixFree<dim, double> matrix_free2;
+      matrix_free2.reinit(
+        mapping,
+        std::vector<const DoFHandler<dim> *>{&dof_handler},
+        std::vector<const AffineConstraints<double> *>{&constraints},
+        std::vector<Quadrature<dim>>{quadrature, quadrature2},
+        typename MatrixFree<dim, double>::AdditionalData());
+      fdl::compute_load_vector(dof_handler,
+                               mapping,
+                               matrix_free2,
+                               forces2,
+                               0.0,
+                               position,
+                               velocity,
+                               rhs3);
+      rhs3.compress(VectorOperation::add);
+
+      rhs2 -= rhs1;
+      rhs3 -= rhs1;
+      const double relative_difference   = rhs2.l2_norm() / rhs1.l2_norm();
+      const double relative_difference_2 = rhs3.l2_norm() / rhs1.l2_norm();
+      if (Utilities::MPI::this_mpi_process(comm) == 0)
+        {
+          output << "degree = " << degree << ": "
+                 << (relative_difference < 1e-12 ? "OK" : "FAILED") << '\n';
+          output << "degree = " << degree << ", two quadratures: "
+                 << (relative_difference_2 < 1e-12 ? "OK" : "FAILED") << '\n';
+        }
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_init_finalize(argc, argv);
+  test<2>();
+}
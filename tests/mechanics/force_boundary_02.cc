@@ -0,0 +1,145 @@
+#include <fiddle/mechanics/force_contribution_lib.h>
+#include <fiddle/mechanics/mechanics_utilities.h>
+
+#include <deal.II/base/function.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/numerics/vector_tools_interpolate.h>
+
+#include <fstream>
+#include <map>
+
+#include "../tests.h"
+
+// Test make_boundary_faces() and verify that restricting boundary forces to
+// the faces with their boundary ids doesn't change the load vector.
+
+using namespace dealii;
+
+template <int dim>
+class Position : public Function<dim>
+{
+public:
+  Position()
+    : Function<dim>(dim)
+  {}
+
+  virtual double
+  value(const Point<dim> &p, const unsigned int component = 0) const override
+  {
+    return 1.1 * p[component] + 0.05 * p[(component + 1) % dim];
+  }
+};
+
+// Same as BoundarySpringForce, but evaluated on every boundary face. Like the
+// original version of compute_boundary_force_load_vector(), this relies on the
+// force setting itself to zero on faces with other boundary ids.
+template <int dim, int spacedim = dim>
+class AllFacesSpringForce : public fdl::BoundarySpringForce<dim, spacedim>
+{
+public:
+  using fdl::BoundarySpringForce<dim, spacedim>::BoundarySpringForce;
+
+  virtual std::vector<types::boundary_id>
+  get_boundary_ids() const override
+  {
+    return {};
+  }
+};
+
+template <int dim, int spacedim = dim>
+void
+test()
+{
+  std::ofstream output("output");
+
+  Triangulation<dim, spacedim> tria;
+  GridGenerator::hyper_cube(tria, 0.0, 1.0, true);
+  tria.refine_global(3);
+  FESystem<dim, spacedim>   fe(FE_Q<dim, spacedim>(1), spacedim);
+  DoFHandler<dim, spacedim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+  MappingQ<dim, spacedim> mapping(1);
+
+  const auto boundary_faces = fdl::make_boundary_faces(dof_handler);
+  std::map<types::boundary_id, unsigned int> n_faces;
+  bool                                       sorted = true;
+  for (unsigned int i = 0; i < boundary_faces.size(); ++i)
+    {
+      ++n_faces[boundary_faces[i].boundary_id];
+      if (i > 0)
+        sorted = sorted && boundary_faces[i - 1].boundary_id <=
+                             boundary_faces[i].boundary_id;
+      AssertThrow(boundary_faces[i].cell->face(boundary_faces[i].face_n)
+                      ->boundary_id() == boundary_faces[i].boundary_id,
+                  ExcMessage("boundary ids should match"));
+    }
+  for (const auto &pair : n_faces)
+    output << "boundary id " << int(pair.first) << ": " << pair.second
+           << " faces\n";
+  output << "sorted: " << (sorted ? "OK" : "FAILED") << '\n';
+
+  LinearAlgebra::distributed::Vector<double> position(dof_handler.n_dofs()),
+    velocity(dof_handler.n_dofs()), rhs_1(dof_handler.n_dofs()),
+    rhs_2(dof_handler.n_dofs());
+  VectorTools::interpolate(mapping,
+                           dof_handler,
+                           Position<spacedim>(),
+                           position);
+
+  const std::vector<types::boundary_id> boundary_ids{1, 3};
+  QGauss<dim - 1>                       face_quadrature(3);
+  fdl::BoundarySpringForce<dim, spacedim> restricted_force(
+    face_quadrature,
+    2.0,
+    dof_handler,
+    mapping,
+    boundary_ids,
+    Functions::IdentityFunction<spacedim>());
+  AllFacesSpringForce<dim, spacedim> all_faces_force(
+    face_quadrature,
+    2.0,
+    dof_handler,
+    mapping,
+    boundary_ids,
+    Functions::IdentityFunction<spacedim>());
+  restricted_force.setup_force(0.0, position, velocity);
+  all_faces_force.setup_force(0.0, position, velocity);
+
+  fdl::compute_boundary_force_load_vector<dim, spacedim>(dof_handler,
+                                                         mapping,
+                                                         boundary_faces,
+                                                         {&restricted_force},
+                                                         0.0,
+                                                         position,
+                                                         velocity,
+                                                         rhs_1);
+  fdl::compute_boundary_force_load_vector<dim, spacedim>(dof_handler,
+                                                         mapping,
+                                                         {&all_faces_force},
+                                                         0.0,
+                                                         position,
+                                                         velocity,
+                                                         rhs_2);
+  const double norm = rhs_2.l2_norm();
+  rhs_1 -= rhs_2;
+  output << "nonzero load vector: " << (norm > 0.0 ? "OK" : "FAILED") << '\n';
+  output << "difference: " << (rhs_1.l2_norm() < 1e-14 * norm ? "OK" : "FAILED")
+         << '\n';
+}
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_init_finalize(argc, argv);
+  test<2>();
+}
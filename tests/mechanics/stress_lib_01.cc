@@ -0,0 +1,308 @@
+#include <fiddle/mechanics/mechanics_values.h>
+#include <fiddle/mechanics/stress_lib.h>
+
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/tensor.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <string>
+
+// Verify that each stress law computes the derivative of its strain energy
+// (by comparing to a finite difference approximation) and that
+// HyperelasticStress adds the laws together.
+
+using namespace dealii;
+
+using EnergyFunction = std::function<double(const Tensor<2, 3> &)>;
+
+// Embed a 2D deformation gradient in 3D with a unit out-of-plane stretch.
+template <int dim>
+Tensor<2, 3>
+embed(const Tensor<2, dim> &FF)
+{
+  Tensor<2, 3> result;
+  result[2][2] = 1.0;
+  for (unsigned int i = 0; i < dim; ++i)
+    for (unsigned int j = 0; j < dim; ++j)
+      result[i][j] = FF[i][j];
+  return result;
+}
+
+template <int dim>
+Tensor<1, 3>
+embed(const Tensor<1, dim> &v)
+{
+  Tensor<1, 3> result;
+  for (unsigned int i = 0; i < dim; ++i)
+    result[i] = v[i];
+  return result;
+}
+
+double
+modified_I1(const Tensor<2, 3> &FF)
+{
+  return std::pow(determinant(FF), -2.0 / 3.0) * trace(transpose(FF) * FF);
+}
+
+double
+modified_I2(const Tensor<2, 3> &FF)
+{
+  const Tensor<2, 3> CC = transpose(FF) * FF;
+  return std::pow(determinant(FF), -4.0 / 3.0) * 0.5 *
+         (trace(CC) * trace(CC) - trace(CC * CC));
+}
+
+template <int dim, typename Law>
+void
+test(const std::string    &name,
+     const Law            &law,
+     const EnergyFunction &energy,
+     std::ofstream        &out)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  const typename Triangulation<dim>::active_cell_iterator cell =
+    tria.begin_active();
+
+  Tensor<2, dim> FF;
+  const double   entries[3][3] = {{1.2, 0.1, 0.05},
+                                  {-0.05, 0.9, 0.1},
+                                  {0.02, 0.03, 1.1}};
+  for (unsigned int i = 0; i < dim; ++i)
+    for (unsigned int j = 0; j < dim; ++j)
+      FF[i][j] = entries[i][j];
+
+  std::vector<Tensor<2, dim, VectorizedArray<double>>> batch_FF(1);
+  batch_FF[0] = FF;
+  fdl::BatchedMechanicsValues<dim> me_values(Law::get_mechanics_update_flags());
+  me_values.reinit(make_array_view(&cell, &cell + 1),
+                   make_array_view(batch_FF),
+                   {},
+                   {});
+  Tensor<2, dim, VectorizedArray<double>> stress;
+  law.add_stress(me_values, 0, stress);
+
+  // central differences
+  const double h          = 1e-6;
+  double       max_error  = 0.0;
+  double       max_stress = 0.0;
+  for (unsigned int i = 0; i < dim; ++i)
+    for (unsigned int j = 0; j < dim; ++j)
+      {
+        Tensor<2, dim> FF_plus = FF, FF_minus = FF;
+        FF_plus[i][j] += h;
+        FF_minus[i][j] -= h;
+        const double expected =
+          (energy(embed(FF_plus)) - energy(embed(FF_minus))) / (2.0 * h);
+        max_error  = std::max(max_error, std::abs(expected - stress[i][j][0]));
+        max_stress = std::max(max_stress, std::abs(expected));
+      }
+  out << dim << "D " << name << ": "
+      << (max_error < 1e-6 * max_stress ? "OK" : "FAILED") << '\n';
+}
+
+template <int dim>
+void
+test_all(std::ofstream &out)
+{
+  using namespace fdl::StressLaws;
+
+  const double mu = 2.0, c1 = 1.5, c2 = 0.5, kappa = 10.0;
+  test<dim>(
+    "NeoHookean",
+    NeoHookean<dim>(mu),
+    [&](const Tensor<2, 3> &FF) { return mu / 2.0 * (modified_I1(FF) - 3.0); },
+    out);
+  test<dim>(
+    "MooneyRivlin",
+    MooneyRivlin<dim>(c1, c2),
+    [&](const Tensor<2, 3> &FF) {
+      return c1 * (modified_I1(FF) - 3.0) + c2 * (modified_I2(FF) - 3.0);
+    },
+    out);
+
+  // Fiber and sheet directions
+  Tensor<1, dim> f0, s0;
+  f0[0] = 1.0;
+  f0[1] = 0.2;
+  f0 /= f0.norm();
+  s0[0] = -f0[1];
+  s0[1] = f0[0];
+  const Tensor<1, 3> f = embed(f0), s = embed(s0);
+
+  const std::array<double, 8> ho = {{0.5, 2.0, 1.5, 3.0, 0.5, 4.0, 0.25, 2.5}};
+  test<dim>(
+    "HolzapfelOgden",
+    HolzapfelOgden<dim>(ho, f0, s0),
+    [&](const Tensor<2, 3> &FF) {
+      const Tensor<2, 3> CC  = transpose(FF) * FF;
+      const double       E4f = std::max(f * (CC * f) - 1.0, 0.0);
+      const double       E4s = std::max(s * (CC * s) - 1.0, 0.0);
+      const double       I8  = f * (CC * s);
+      return ho[0] / (2.0 * ho[1]) *
+               (std::exp(ho[1] * (modified_I1(FF) - 3.0)) - 1.0) +
+             ho[2] / (2.0 * ho[3]) * (std::exp(ho[3] * E4f * E4f) - 1.0) +
+             ho[4] / (2.0 * ho[5]) * (std::exp(ho[5] * E4s * E4s) - 1.0) +
+             ho[6] / (2.0 * ho[7]) * (std::exp(ho[7] * I8 * I8) - 1.0);
+    },
+    out);
+
+  const double C = 0.9, b_f = 8.0, b_t = 2.0, b_fs = 4.0;
+  test<dim>(
+    "Guccione",
+    Guccione<dim>(C, b_f, b_t, b_fs, f0, s0),
+    [&](const Tensor<2, 3> &FF) {
+      Tensor<2, 3> EE = 0.5 * (transpose(FF) * FF);
+      for (unsigned int i = 0; i < 3; ++i)
+        EE[i][i] -= 0.5;
+      const Tensor<1, 3> n   = cross_product_3d(f, s);
+      const double       Eff = f * (EE * f), Ess = s * (EE * s),
+                   Enn = n * (EE * n), Efs = f * (EE * s), Efn = f * (EE * n),
+                   Esn = s * (EE * n);
+      const double Q = b_f * Eff * Eff +
+                       b_t * (Ess * Ess + Enn * Enn + 2.0 * Esn * Esn) +
+                       2.0 * b_fs * (Efs * Efs + Efn * Efn);
+      return C / 2.0 * (std::exp(Q) - 1.0);
+    },
+    out);
+
+  test<dim>(
+    "QuadraticVolumetricPenalty",
+    QuadraticVolumetricPenalty<dim>(kappa),
+    [&](const Tensor<2, 3> &FF) {
+      const double J = determinant(FF);
+      return kappa / 2.0 * (J - 1.0) * (J - 1.0);
+    },
+    out);
+  test<dim>(
+    "LogSquaredVolumetricPenalty",
+    LogSquaredVolumetricPenalty<dim>(kappa),
+    [&](const Tensor<2, 3> &FF) {
+      const double J = determinant(FF);
+      return kappa / 2.0 * std::log(J) * std::log(J);
+    },
+    out);
+  test<dim>(
+    "SimoTaylorVolumetricPenalty",
+    SimoTaylorVolumetricPenalty<dim>(kappa),
+    [&](const Tensor<2, 3> &FF) {
+      const double J = determinant(FF);
+      return kappa / 4.0 * (J * J - 1.0 - 2.0 * std::log(J));
+    },
+    out);
+  test<dim>(
+    "JLogJVolumetricPenalty",
+    JLogJVolumetricPenalty<dim>(kappa),
+    [&](const Tensor<2, 3> &FF) {
+      const double J = determinant(FF);
+      return kappa * (J * std::log(J) - J + 1.0);
+    },
+    out);
+
+  // Check that the combined stress is the sum of its parts
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  const typename Triangulation<dim>::active_cell_iterator cell =
+    tria.begin_active();
+  const auto stress =
+    fdl::make_hyperelastic_stress<dim>(QGauss<dim>(2),
+                                       {},
+                                       NeoHookean<dim>(mu),
+                                       LogSquaredVolumetricPenalty<dim>(kappa));
+  const auto flags = stress->get_mechanics_update_flags();
+  out << dim << "D HyperelasticStress flags: "
+      << ((flags == (NeoHookean<dim>::get_mechanics_update_flags() |
+                     LogSquaredVolumetricPenalty<
+                       dim>::get_mechanics_update_flags())) ?
+            "OK" :
+            "FAILED")
+      << '\n';
+
+  std::vector<Tensor<2, dim, VectorizedArray<double>>> batch_FF(2);
+  for (unsigned int d = 0; d < dim; ++d)
+    {
+      batch_FF[0][d][d] = 1.1;
+      batch_FF[1][d][d] = 0.8;
+    }
+  batch_FF[0][0][1] = 0.1;
+  fdl::BatchedMechanicsValues<dim> me_values(flags);
+  me_values.reinit(make_array_view(&cell, &cell + 1),
+                   make_array_view(batch_FF),
+                   {},
+                   {});
+  std::vector<Tensor<2, dim, VectorizedArray<double>>> stresses(2), expected(2);
+  auto view = make_array_view(stresses);
+  stress->compute_stress_batch(0.0, me_values, view);
+  double max_error = 0.0;
+  for (unsigned int qp_n = 0; qp_n < 2; ++qp_n)
+    {
+      NeoHookean<dim>(mu).add_stress(me_values, qp_n, expected[qp_n]);
+      LogSquaredVolumetricPenalty<dim>(kappa).add_stress(me_values,
+                                                         qp_n,
+                                                         expected[qp_n]);
+      for (unsigned int i = 0; i < dim; ++i)
+        for (unsigned int j = 0; j < dim; ++j)
+          max_error = std::max(max_error,
+                               std::abs(stresses[qp_n][i][j][0] -
+                                        expected[qp_n][i][j][0]));
+    }
+  out << dim << "D HyperelasticStress: "
+      << (max_error < 1e-14 ? "OK" : "FAILED") << '\n';
+
+  // Lanes of cells with other material ids must not contribute, even if the
+  // laws evaluate to inf or NaN on them (here J = 0)
+  Triangulation<dim> tria_2;
+  GridGenerator::subdivided_hyper_cube(tria_2, 2);
+  std::vector<typename Triangulation<dim>::active_cell_iterator> cells;
+  for (const auto &c : tria_2.active_cell_iterators())
+    {
+      c->set_material_id(cells.size() % 2);
+      cells.push_back(c);
+    }
+  cells.resize(
+    std::min<std::size_t>(cells.size(), VectorizedArray<double>::size()));
+  const auto restricted_stress =
+    fdl::make_hyperelastic_stress<dim>(QGauss<dim>(2),
+                                       {1},
+                                       NeoHookean<dim>(mu),
+                                       LogSquaredVolumetricPenalty<dim>(kappa));
+  std::vector<Tensor<2, dim, VectorizedArray<double>>> mixed_FF(1);
+  for (unsigned int lane = 0; lane < cells.size(); ++lane)
+    for (unsigned int d = 0; d < dim; ++d)
+      mixed_FF[0][d][d][lane] = cells[lane]->material_id() == 1 ? 1.1 : 0.0;
+  fdl::BatchedMechanicsValues<dim> mixed_values(flags);
+  mixed_values.reinit(make_array_view(cells),
+                      make_array_view(mixed_FF),
+                      {},
+                      {});
+  std::vector<Tensor<2, dim, VectorizedArray<double>>> mixed_stresses(1);
+  auto mixed_view = make_array_view(mixed_stresses);
+  restricted_stress->compute_stress_batch(0.0, mixed_values, mixed_view);
+  bool masked_ok = true;
+  for (unsigned int lane = 0; lane < cells.size(); ++lane)
+    for (unsigned int i = 0; i < dim; ++i)
+      for (unsigned int j = 0; j < dim; ++j)
+        {
+          const double value = mixed_stresses[0][i][j][lane];
+          if (cells[lane]->material_id() == 1 ? !std::isfinite(value) :
+                                                value != 0.0)
+            masked_ok = false;
+        }
+  out << dim << "D HyperelasticStress material ids: "
+      << (masked_ok ? "OK" : "FAILED") << '\n';
+}
+
+int
+main()
+{
+  std::ofstream out("output");
+  test_all<NDIM>(out);
+}
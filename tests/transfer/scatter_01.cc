@@ -0,0 +1,100 @@
+#include <fiddle/transfer/scatter.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/vector.h>
+
+#include <limits>
+#include <sstream>
+
+#include "../tests.h"
+
+// Test Scatter with overlap DoFs which are a mix of owned and ghost DoFs
+// (including repeated DoFs).
+
+using namespace dealii;
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  const MPI_Comm     comm    = MPI_COMM_WORLD;
+  const unsigned int rank    = Utilities::MPI::this_mpi_process(comm);
+  const unsigned int n_procs = Utilities::MPI::n_mpi_processes(comm);
+
+  const unsigned int n_local_dofs = 20;
+  const unsigned int n_dofs       = n_local_dofs * n_procs;
+  IndexSet           local_dofs(n_dofs);
+  local_dofs.add_range(rank * n_local_dofs, (rank + 1) * n_local_dofs);
+
+  std::vector<types::global_dof_index> overlap_dofs;
+  for (unsigned int k = 0; k < 30; ++k)
+    overlap_dofs.push_back((7 * k + 3 * rank) % n_dofs);
+
+  fdl::Scatter<double> scatter(overlap_dofs, local_dofs, comm);
+
+  std::ostringstream out;
+  out << "rank = " << rank << '\n';
+
+  LinearAlgebra::distributed::Vector<double> native(local_dofs,
+                                                    IndexSet(n_dofs),
+                                                    comm);
+  Vector<double> overlap(overlap_dofs.size());
+
+  // Use each operation twice to verify that the object can be reused.
+  for (unsigned int iteration = 0; iteration < 2; ++iteration)
+    {
+      // native to overlap:
+      for (const auto dof : local_dofs)
+        native[dof] = 2.0 * dof + 1.0 + iteration;
+      scatter.global_to_overlap_start(native, 0, overlap);
+      scatter.global_to_overlap_finish(native, overlap);
+      bool ok = true;
+      for (unsigned int i = 0; i < overlap_dofs.size(); ++i)
+        ok = ok && overlap[i] == 2.0 * overlap_dofs[i] + 1.0 + iteration;
+      out << "global_to_overlap: " << (ok ? "OK" : "FAILED") << '\n';
+
+      // overlap to native with addition:
+      std::vector<double> expected(n_dofs);
+      for (const auto dof : overlap_dofs)
+        expected[dof] += 1.0;
+      Utilities::MPI::sum(expected, comm, expected);
+      overlap = 1.0;
+      native  = 42.0;
+      scatter.overlap_to_global_start(overlap,
+                                      VectorOperation::add,
+                                      0,
+                                      native);
+      scatter.overlap_to_global_finish(overlap, VectorOperation::add, native);
+      ok = true;
+      for (const auto dof : local_dofs)
+        ok = ok && native[dof] == expected[dof];
+      out << "overlap_to_global (add): " << (ok ? "OK" : "FAILED") << '\n';
+
+      // overlap to native with insertion (which actually uses max):
+      std::fill(expected.begin(), expected.end(), 0.0);
+      for (const auto dof : overlap_dofs)
+        expected[dof] = rank + 1.0;
+      Utilities::MPI::max(expected, comm, expected);
+      overlap = rank + 1.0;
+      scatter.overlap_to_global_start(overlap,
+                                      VectorOperation::insert,
+                                      0,
+                                      native);
+      scatter.overlap_to_global_finish(overlap,
+                                       VectorOperation::insert,
+                                       native);
+      ok = true;
+      for (const auto dof : local_dofs)
+        ok = ok && native[dof] == (expected[dof] == 0.0 ?
+                                     std::numeric_limits<double>::lowest() :
+                                     expected[dof]);
+      out << "overlap_to_global (insert): " << (ok ? "OK" : "FAILED") << '\n';
+    }
+
+  std::ofstream output;
+  if (rank == 0)
+    output.open("output");
+  print_strings_on_0(out.str(), comm, output);
+}
@@ -0,0 +1,81 @@
+#include <fiddle/transfer/scatter.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/vector.h>
+
+#include <sstream>
+
+#include "../tests.h"
+
+// Test Scatter with several vectors packed into one message.
+
+using namespace dealii;
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  const MPI_Comm     comm    = MPI_COMM_WORLD;
+  const unsigned int rank    = Utilities::MPI::this_mpi_process(comm);
+  const unsigned int n_procs = Utilities::MPI::n_mpi_processes(comm);
+
+  const unsigned int n_local_dofs = 20;
+  const unsigned int n_dofs       = n_local_dofs * n_procs;
+  IndexSet           local_dofs(n_dofs);
+  local_dofs.add_range(rank * n_local_dofs, (rank + 1) * n_local_dofs);
+
+  std::vector<types::global_dof_index> overlap_dofs;
+  for (unsigned int k = 0; k < 30; ++k)
+    overlap_dofs.push_back((7 * k + 3 * rank) % n_dofs);
+
+  fdl::Scatter<double> scatter(overlap_dofs, local_dofs, comm);
+
+  std::ostringstream out;
+  out << "rank = " << rank << '\n';
+
+  for (unsigned int n_vectors = 1; n_vectors < 4; ++n_vectors)
+    {
+      std::vector<LinearAlgebra::distributed::Vector<double>> natives(
+        n_vectors,
+        LinearAlgebra::distributed::Vector<double>(local_dofs,
+                                                   IndexSet(n_dofs),
+                                                   comm));
+      std::vector<Vector<double>> overlaps(n_vectors,
+                                           Vector<double>(overlap_dofs.size()));
+      std::vector<const LinearAlgebra::distributed::Vector<double> *> inputs;
+      std::vector<Vector<double> *>                                   outputs;
+      for (unsigned int v = 0; v < n_vectors; ++v)
+        {
+          for (const auto dof : local_dofs)
+            natives[v][dof] = 100.0 * v + dof;
+          inputs.push_back(&natives[v]);
+          outputs.push_back(&overlaps[v]);
+        }
+
+      scatter.global_to_overlap_start(inputs, 0, outputs);
+      scatter.global_to_overlap_finish(inputs, outputs);
+      bool ok = true;
+      for (unsigned int v = 0; v < n_vectors; ++v)
+        for (unsigned int i = 0; i < overlap_dofs.size(); ++i)
+          ok = ok && overlaps[v][i] == 100.0 * v + overlap_dofs[i];
+      out << "n_vectors = " << n_vectors << ": " << (ok ? "OK" : "FAILED")
+          << '\n';
+
+      // Make sure the single-vector scatter still works after a multi-vector
+      // scatter:
+      overlaps[0] = 0.0;
+      scatter.global_to_overlap_start(natives[0], 1, overlaps[0]);
+      scatter.global_to_overlap_finish(natives[0], overlaps[0]);
+      ok = true;
+      for (unsigned int i = 0; i < overlap_dofs.size(); ++i)
+        ok = ok && overlaps[0][i] == overlap_dofs[i];
+      out << "single vector: " << (ok ? "OK" : "FAILED") << '\n';
+    }
+
+  std::ofstream output;
+  if (rank == 0)
+    output.open("output");
+  print_strings_on_0(out.str(), comm, output);
+}
@@ -0,0 +1,104 @@
+#include <fiddle/transfer/scatter.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/vector.h>
+
+#include <cmath>
+#include <sstream>
+
+#include "../tests.h"
+
+// Test Scatter with values communicated in single precision.
+
+using namespace dealii;
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  const MPI_Comm     comm    = MPI_COMM_WORLD;
+  const unsigned int rank    = Utilities::MPI::this_mpi_process(comm);
+  const unsigned int n_procs = Utilities::MPI::n_mpi_processes(comm);
+
+  const unsigned int n_local_dofs = 20;
+  const unsigned int n_dofs       = n_local_dofs * n_procs;
+  IndexSet           local_dofs(n_dofs);
+  local_dofs.add_range(rank * n_local_dofs, (rank + 1) * n_local_dofs);
+
+  std::vector<types::global_dof_index> overlap_dofs;
+  for (unsigned int k = 0; k < 30; ++k)
+    overlap_dofs.push_back((7 * k + 3 * rank) % n_dofs);
+
+  fdl::Scatter<double> scatter(overlap_dofs, local_dofs, comm);
+
+  std::ostringstream out;
+  out << "rank = " << rank << '\n';
+
+  // Use values which cannot be exactly represented as floats:
+  auto position_value = [](const types::global_dof_index dof) {
+    return std::sqrt(2.0 + dof);
+  };
+  auto force_value = [](const types::global_dof_index dof) {
+    return -1.0 / (3.0 + dof);
+  };
+
+  LinearAlgebra::distributed::Vector<double> position(local_dofs,
+                                                      IndexSet(n_dofs),
+                                                      comm);
+  LinearAlgebra::distributed::Vector<double> force(position);
+  for (const auto dof : local_dofs)
+    {
+      position[dof] = position_value(dof);
+      force[dof]    = force_value(dof);
+    }
+  Vector<double> overlap_position(overlap_dofs.size());
+  Vector<double> overlap_force(overlap_dofs.size());
+
+  // Owned values should be copied exactly and ghost values should be rounded
+  // to the nearest float.
+  auto check = [&](const Vector<double> &overlap,
+                   const auto           &value,
+                   const bool            reduced_precision) {
+    bool ok = true;
+    for (unsigned int i = 0; i < overlap_dofs.size(); ++i)
+      {
+        const types::global_dof_index dof = overlap_dofs[i];
+        const bool   rounded = reduced_precision && !local_dofs.is_element(dof);
+        const double expected =
+          rounded ? static_cast<double>(static_cast<float>(value(dof))) :
+                    value(dof);
+        ok = ok && overlap[i] == expected;
+      }
+    return ok;
+  };
+
+  for (const bool reduced_precision : {false, true})
+    {
+      scatter.global_to_overlap_start(position,
+                                      0,
+                                      overlap_position,
+                                      reduced_precision);
+      scatter.global_to_overlap_finish(position, overlap_position);
+      bool ok = check(overlap_position, position_value, reduced_precision);
+      out << "reduced_precision = " << reduced_precision
+          << ", one vector: " << (ok ? "OK" : "FAILED") << '\n';
+
+      scatter.global_to_overlap_start({&position, &force},
+                                      0,
+                                      {&overlap_position, &overlap_force},
+                                      reduced_precision);
+      scatter.global_to_overlap_finish({&position, &force},
+                                       {&overlap_position, &overlap_force});
+      ok = check(overlap_position, position_value, reduced_precision) &&
+           check(overlap_force, force_value, reduced_precision);
+      out << "reduced_precision = " << reduced_precision
+          << ", two vectors: " << (ok ? "OK" : "FAILED") << '\n';
+    }
+
+  std::ofstream output;
+  if (rank == 0)
+    output.open("output");
+  print_strings_on_0(out.str(), comm, output);
+}